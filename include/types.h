@@ -13,6 +13,7 @@
 #define GCC_PACKED
 #define GCC_UNUSED
 #define PACK
+#define THREAD_LOCAL
 
 #define BIT_S8  int8
 #define BIT_S16 int16
@@ -28,6 +29,11 @@
 	#define GCC_PACKED __attribute__((packed))
 	#undef GCC_UNUSED
 	#define GCC_UNUSED __attribute__((unused))
+	#if defined(_WIN32) || defined(PTHREAD)
+		/* Only when there are threads; some targets have no TLS support */
+		#undef THREAD_LOCAL
+		#define THREAD_LOCAL __thread
+	#endif /* _WIN32 || PTHREAD */
 
 	#undef BIT_S8
 	#undef BIT_S16
@@ -47,6 +53,8 @@
 	#undef MSVC_PACKED_END
 	#define MSVC_PACKED_BEGIN __pragma(pack(push, 1))
 	#define MSVC_PACKED_END __pragma(pack(pop))
+	#undef THREAD_LOCAL
+	#define THREAD_LOCAL __declspec(thread)
 	#pragma warning(disable:4102) /* unreferenced label */
 	#pragma warning(disable:4996) /* deprecated functions */
 #elif defined(__TINYC__)
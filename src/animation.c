@@ -10,27 +10,17 @@
 #include "audio/sound.h"
 #include "map.h"
 #include "sprites.h"
+#include "state.h"
 #include "structure.h"
 #include "tile.h"
 #include "timer.h"
+#include "timerwheel.h"
 #include "tools.h"
 
-enum {
-	ANIMATION_MAX = 112
-};
+#define g_animations     (g_gameState->animations)
+#define g_animationWheel (g_gameState->animationWheel)
 
-typedef struct Animation {
-	uint32 tickNext;                        /*!< Which tick this Animation should be called again. */
-	uint16 tileLayout;                      /*!< Tile layout of the Animation. */
-	uint8 houseID;                          /*!< House of the item being animated. */
-	uint8 current;                          /*!< At which command we currently are in the Animation. */
-	uint8 iconGroup;                        /*!< Which iconGroup the sprites of the Animation belongs. */
-	const AnimationCommandStruct *commands; /*!< List of commands for this Animation. */
-	tile32 tile;                            /*!< Top-left tile of Animation. */
-} Animation;
-
-static Animation g_animations[ANIMATION_MAX];
-static uint32 s_animationTimer; /*!< Timer for animations. */
+assert_compile((int)ANIMATION_MAX <= (int)TIMERWHEEL_ENTRIES_MAX);
 
 /**
  * Stop with this Animation.
@@ -47,6 +37,7 @@ static void Animation_Func_Stop(Animation *animation, int16 parameter)
 
 	g_map[packed].hasAnimation = false;
 	animation->commands = NULL;
+	TimerWheel_Cancel(&g_animationWheel, (uint16)(animation - g_animations));
 
 	for (i = 0; i < layoutTileCount; i++) {
 		uint16 position = packed + (*layout++);
@@ -77,6 +68,7 @@ static void Animation_Func_Abort(Animation *animation, int16 parameter)
 
 	g_map[packed].hasAnimation = false;
 	animation->commands = NULL;
+	TimerWheel_Cancel(&g_animationWheel, (uint16)(animation - g_animations));
 
 	Map_Update(packed, 0, false);
 }
@@ -206,6 +198,7 @@ static void Animation_Func_PlayVoice(Animation *animation, int16 parameter)
 void Animation_Init(void)
 {
 	memset(g_animations, 0, ANIMATION_MAX * sizeof(Animation));
+	TimerWheel_Init(&g_animationWheel, g_timerGUI);
 }
 
 /**
@@ -237,7 +230,7 @@ void Animation_Start(const AnimationCommandStruct *commands, tile32 tile, uint16
 		animation->commands   = commands;
 		animation->tile       = tile;
 
-		s_animationTimer = 0;
+		TimerWheel_Schedule(&g_animationWheel, (uint16)i, animation->tickNext);
 
 		t->houseID = houseID;
 		t->hasAnimation = true;
@@ -267,43 +260,39 @@ void Animation_Stop_ByTile(uint16 packed)
 }
 
 /**
- * Check all Animations if they need changing.
+ * Handle the Animations that need changing.
  */
 void Animation_Tick(void)
 {
-	Animation *animation = g_animations;
-	int i;
-
-	if (s_animationTimer > g_timerGUI) return;
-	s_animationTimer += 10000;
+	uint16 i;
+
+	TimerWheel_Advance(&g_animationWheel, g_timerGUI);
+
+	/* Only the due Animations are visited, in the order of the array */
+	for (i = TimerWheel_PopDue(&g_animationWheel, 0); i != TIMERWHEEL_INVALID; i = TimerWheel_PopDue(&g_animationWheel, i + 1)) {
+		Animation *animation = &g_animations[i];
+		const AnimationCommandStruct *commands = animation->commands + animation->current;
+		int16 parameter = commands->parameter;
+		assert((parameter & 0x0800) == 0 || (parameter & 0xF000) != 0); /* Validate if the compiler sign-extends correctly */
+
+		animation->current++;
+
+		switch (commands->command) {
+			case ANIMATION_STOP:
+			default:                           Animation_Func_Stop(animation, parameter); break;
+
+			case ANIMATION_ABORT:              Animation_Func_Abort(animation, parameter); break;
+			case ANIMATION_SET_OVERLAY_TILE:   Animation_Func_SetOverlayTile(animation, parameter); break;
+			case ANIMATION_PAUSE:              Animation_Func_Pause(animation, parameter); break;
+			case ANIMATION_REWIND:             Animation_Func_Rewind(animation, parameter); break;
+			case ANIMATION_PLAY_VOICE:         Animation_Func_PlayVoice(animation, parameter); break;
+			case ANIMATION_SET_GROUND_TILE:    Animation_Func_SetGroundTile(animation, parameter); break;
+			case ANIMATION_FORWARD:            Animation_Func_Forward(animation, parameter); break;
+			case ANIMATION_SET_ICONGROUP:      Animation_Func_SetIconGroup(animation, parameter); break;
+		}
 
-	for (i = 0; i < ANIMATION_MAX; i++, animation++) {
 		if (animation->commands == NULL) continue;
 
-		if (animation->tickNext <= g_timerGUI) {
-			const AnimationCommandStruct *commands = animation->commands + animation->current;
-			int16 parameter = commands->parameter;
-			assert((parameter & 0x0800) == 0 || (parameter & 0xF000) != 0); /* Validate if the compiler sign-extends correctly */
-
-			animation->current++;
-
-			switch (commands->command) {
-				case ANIMATION_STOP:
-				default:                           Animation_Func_Stop(animation, parameter); break;
-
-				case ANIMATION_ABORT:              Animation_Func_Abort(animation, parameter); break;
-				case ANIMATION_SET_OVERLAY_TILE:   Animation_Func_SetOverlayTile(animation, parameter); break;
-				case ANIMATION_PAUSE:              Animation_Func_Pause(animation, parameter); break;
-				case ANIMATION_REWIND:             Animation_Func_Rewind(animation, parameter); break;
-				case ANIMATION_PLAY_VOICE:         Animation_Func_PlayVoice(animation, parameter); break;
-				case ANIMATION_SET_GROUND_TILE:    Animation_Func_SetGroundTile(animation, parameter); break;
-				case ANIMATION_FORWARD:            Animation_Func_Forward(animation, parameter); break;
-				case ANIMATION_SET_ICONGROUP:      Animation_Func_SetIconGroup(animation, parameter); break;
-			}
-
-			if (animation->commands == NULL) continue;
-		}
-
-		if (animation->tickNext < s_animationTimer) s_animationTimer = animation->tickNext;
+		TimerWheel_Schedule(&g_animationWheel, i, animation->tickNext);
 	}
 }
@@ -3,6 +3,10 @@
 #ifndef ANIMATE_H
 #define ANIMATE_H
 
+enum {
+	ANIMATION_MAX = 112
+};
+
 /**
  * The valid types for command in AnimationCommandStruct.
  */
@@ -26,6 +30,19 @@ typedef struct AnimationCommandStruct {
 	uint16 parameter;                                       /*!< The parameter for this command. */
 } AnimationCommandStruct;
 
+/**
+ * An Animation being played on the map.
+ */
+typedef struct Animation {
+	uint32 tickNext;                        /*!< Which tick this Animation should be called again. */
+	uint16 tileLayout;                      /*!< Tile layout of the Animation. */
+	uint8 houseID;                          /*!< House of the item being animated. */
+	uint8 current;                          /*!< At which command we currently are in the Animation. */
+	uint8 iconGroup;                        /*!< Which iconGroup the sprites of the Animation belongs. */
+	const AnimationCommandStruct *commands; /*!< List of commands for this Animation. */
+	tile32 tile;                            /*!< Top-left tile of Animation. */
+} Animation;
+
 extern const AnimationCommandStruct g_table_animation_unitMove[8][8];
 extern const AnimationCommandStruct g_table_animation_unitScript1[4][8];
 extern const AnimationCommandStruct g_table_animation_unitScript2[4][8];
@@ -15,6 +15,7 @@
 #include "mt32mpu.h"
 
 #include "midi.h"
+#include "../trace.h"
 
 #if defined(_WIN32)
 static Semaphore s_mpu_sem = NULL;
@@ -498,6 +499,8 @@ void MPU_Interrupt(void)
 	if (locked) return;
 	locked = true;
 
+	TRACE_BEGIN("MPU_Interrupt");
+
 	s_mpu_msdataCurrent = -1;
 	count = s_mpu_msdataSize;
 	while (count-- != 0) {
@@ -694,6 +697,8 @@ void MPU_Interrupt(void)
 		}
 	}
 
+	TRACE_END("MPU_Interrupt");
+
 	locked = false;
 
 	return;
@@ -16,6 +16,7 @@
 #include "../gui/gui.h"
 #include "../house.h"
 #include "../opendune.h"
+#include "../state.h"
 #include "../string.h"
 #include "../tile.h"
 #include "../timer.h"
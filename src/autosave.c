@@ -0,0 +1,129 @@
+/** @file src/autosave.c Autosave routines. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "types.h"
+#include "os/thread.h"
+
+#include "autosave.h"
+
+#include "save.h"
+#include "saveload/saveload.h"
+#include "state.h"
+
+#define AUTOSAVE_FILENAME "_autosav.dat"                    /*!< The file the autosave is written to. */
+
+uint32 g_autosaveInterval = 0;                              /*!< Game ticks between two autosaves, or 0 to never autosave. */
+
+static uint32 s_autosaveLast = 0;                           /*!< The game tick of the last autosave. */
+
+#if defined(WITH_THREADS)
+static GameState *s_autosaveState     = NULL;               /*!< The snapshot the worker thread writes. */
+static Thread     s_autosaveThread    = NULL;               /*!< The worker thread, until it is waited for. */
+static Semaphore  s_autosaveSemaphore = NULL;               /*!< Locked while the worker thread writes the snapshot. */
+
+/**
+ * The worker thread. It activates the snapshot for this thread only, and
+ *  writes it to the autosave.
+ *
+ * @param data The snapshot.
+ * @return Always zero.
+ */
+static ThreadStatus WINAPI Autosave_Thread(void *data)
+{
+	g_gameState = (GameState *)data;
+
+	SaveGame_Write(AUTOSAVE_FILENAME, "Autosave", &Info_SaveCaptured);
+
+	Semaphore_Unlock(s_autosaveSemaphore);
+
+	return 0;
+}
+#endif /* WITH_THREADS */
+
+/**
+ * Write the autosave from the active GameState, on this thread.
+ */
+static void Autosave_Write(void)
+{
+	if (!Info_Capture()) return;
+
+	SaveGame_Write(AUTOSAVE_FILENAME, "Autosave", &Info_SaveCaptured);
+}
+
+/**
+ * Start an autosave. Where threads are available, the game thread only takes
+ *  a snapshot of the GameState; a worker thread writes it to disk. If the
+ *  previous autosave is still being written, this one is skipped.
+ */
+static void Autosave_Start(void)
+{
+#if defined(WITH_THREADS)
+	if (s_autosaveSemaphore == NULL) s_autosaveSemaphore = Semaphore_Create(1);
+	if (s_autosaveSemaphore == NULL) {
+		Autosave_Write();
+		return;
+	}
+
+	if (!Semaphore_TryLock(s_autosaveSemaphore)) return;
+
+	if (s_autosaveThread != NULL) {
+		Thread_Wait(s_autosaveThread, NULL);
+		s_autosaveThread = NULL;
+	}
+
+	s_autosaveState = GameState_Snapshot(s_autosaveState);
+	if (s_autosaveState != NULL && Info_Capture()) {
+		s_autosaveThread = Thread_Create(&Autosave_Thread, s_autosaveState);
+		if (s_autosaveThread != NULL) return;
+	}
+
+	Semaphore_Unlock(s_autosaveSemaphore);
+#else
+	Autosave_Write();
+#endif /* WITH_THREADS */
+}
+
+/**
+ * Autosave if the interval has passed since the last autosave. Called once
+ *  per game tick.
+ */
+void Autosave_Tick(void)
+{
+	if (g_autosaveInterval == 0) return;
+
+	if (g_timerGame - s_autosaveLast < g_autosaveInterval) return;
+	s_autosaveLast = g_timerGame;
+
+	Autosave_Start();
+}
+
+/**
+ * Start counting the interval to the next autosave from now. Called when a
+ *  new scenario started or a savegame was loaded.
+ */
+void Autosave_Reset(void)
+{
+	s_autosaveLast = g_timerGame;
+}
+
+/**
+ * Wait for the autosave being written, and free the snapshot.
+ */
+void Autosave_Uninit(void)
+{
+#if defined(WITH_THREADS)
+	if (s_autosaveThread != NULL) {
+		Thread_Wait(s_autosaveThread, NULL);
+		s_autosaveThread = NULL;
+	}
+
+	if (s_autosaveSemaphore != NULL) {
+		Semaphore_Destroy(s_autosaveSemaphore);
+		s_autosaveSemaphore = NULL;
+	}
+
+	free(s_autosaveState);
+	s_autosaveState = NULL;
+#endif /* WITH_THREADS */
+}
@@ -0,0 +1,12 @@
+/** @file src/autosave.h Autosave definitions. */
+
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+extern uint32 g_autosaveInterval;
+
+extern void Autosave_Tick(void);
+extern void Autosave_Reset(void);
+extern void Autosave_Uninit(void);
+
+#endif /* AUTOSAVE_H */
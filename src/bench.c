@@ -0,0 +1,145 @@
+/** @file src/bench.c Benchmark routines. */
+
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+#include "os/error.h"
+
+#include "bench.h"
+
+#include "timer.h"
+
+bool g_bench = false;                                       /*!< When true, the parts of a game tick are timed. */
+
+static FILE  *s_benchFile    = NULL;                        /*!< The file the results are written to. */
+static bool   s_benchJSON    = false;                       /*!< True if the results are written as JSON, false for CSV. */
+static uint16 s_benchRuns    = 0;                           /*!< The amount of runs reported so far. */
+static double s_benchTime[BENCH_ZONE_MAX];                  /*!< Per zone, the time spent in the current run, in microseconds. */
+
+static const char * const s_benchZoneNames[BENCH_ZONE_MAX] = {
+	"team", "unit", "structure", "house", "explosion", "animation"
+};
+
+/**
+ * Start writing benchmark results to a file. If the filename ends in ".json"
+ *  the results are written as a JSON array, otherwise as CSV.
+ *
+ * @param filename The file to write to.
+ * @return True if and only if the file could be created.
+ */
+bool Bench_Open(const char *filename)
+{
+	size_t length = strlen(filename);
+	uint8 i;
+
+	s_benchFile = fopen(filename, "w");
+	if (s_benchFile == NULL) {
+		Error("Failed to open benchmark file '%s' for writing\n", filename);
+		return false;
+	}
+
+	s_benchJSON = (length >= 5 && strcmp(filename + length - 5, ".json") == 0);
+	s_benchRuns = 0;
+
+	if (s_benchJSON) {
+		fprintf(s_benchFile, "[");
+	} else {
+		fprintf(s_benchFile, "scenario,house,seed,ticks,time_us,ticks_per_sec,result");
+		for (i = 0; i < BENCH_ZONE_MAX; i++) fprintf(s_benchFile, ",%s_us", s_benchZoneNames[i]);
+		fprintf(s_benchFile, "\n");
+	}
+
+	g_bench = true;
+
+	return true;
+}
+
+/**
+ * Start timing a run.
+ */
+void Bench_Start(void)
+{
+	memset(s_benchTime, 0, sizeof(s_benchTime));
+}
+
+/**
+ * Get the time to start the first lap of a tick with.
+ *
+ * @return The time now, or 0 if not benchmarking.
+ */
+uint32 Bench_Now(void)
+{
+	if (!g_bench) return 0;
+
+	return Timer_GetTimeMicro();
+}
+
+/**
+ * Add the time since the previous lap to a zone.
+ *
+ * @param zone The zone the time was spent in.
+ * @param start The time the zone was entered, as returned by Bench_Now() or the previous lap.
+ * @return The time now, to pass to the next lap.
+ */
+uint32 Bench_Lap(BenchZone zone, uint32 start)
+{
+	uint32 now;
+
+	if (!g_bench) return 0;
+
+	now = Timer_GetTimeMicro();
+	s_benchTime[zone] += now - start;
+
+	return now;
+}
+
+/**
+ * Write the results of a run. The total time is that of the timed zones,
+ *  so replay hashing, autosaves and checkpoints don't count.
+ *
+ * @param scenarioID The scenario that was run.
+ * @param house The name of the House it was played as.
+ * @param seed The seed for the random generators.
+ * @param ticks The amount of ticks simulated.
+ * @param result How the scenario ended.
+ */
+void Bench_Report(uint16 scenarioID, const char *house, uint32 seed, uint32 ticks, const char *result)
+{
+	double time = 0.0;
+	double ticksPerSec;
+	uint8 i;
+
+	if (s_benchFile == NULL) return;
+
+	for (i = 0; i < BENCH_ZONE_MAX; i++) time += s_benchTime[i];
+	ticksPerSec = (time == 0.0) ? 0.0 : (double)ticks * 1000000.0 / time;
+
+	if (s_benchJSON) {
+		fprintf(s_benchFile, "%s\n  {\"scenario\": %u, \"house\": \"%s\", \"seed\": %lu, \"ticks\": %lu, \"time_us\": %.0f, \"ticks_per_sec\": %.1f, \"result\": \"%s\"",
+			(s_benchRuns == 0) ? "" : ",", scenarioID, house, (unsigned long)seed, (unsigned long)ticks, time, ticksPerSec, result);
+		for (i = 0; i < BENCH_ZONE_MAX; i++) fprintf(s_benchFile, ", \"%s_us\": %.0f", s_benchZoneNames[i], s_benchTime[i]);
+		fprintf(s_benchFile, "}");
+	} else {
+		fprintf(s_benchFile, "%u,%s,%lu,%lu,%.0f,%.1f,%s",
+			scenarioID, house, (unsigned long)seed, (unsigned long)ticks, time, ticksPerSec, result);
+		for (i = 0; i < BENCH_ZONE_MAX; i++) fprintf(s_benchFile, ",%.0f", s_benchTime[i]);
+		fprintf(s_benchFile, "\n");
+	}
+
+	s_benchRuns++;
+}
+
+/**
+ * Stop writing benchmark results.
+ */
+void Bench_Close(void)
+{
+	if (s_benchFile == NULL) return;
+
+	if (s_benchJSON) fprintf(s_benchFile, "\n]\n");
+
+	fclose(s_benchFile);
+	s_benchFile = NULL;
+
+	g_bench = false;
+}
@@ -0,0 +1,29 @@
+/** @file src/bench.h Benchmark definitions. */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/**
+ * The parts of a game tick that are timed separately.
+ */
+typedef enum BenchZone {
+	BENCH_TEAM      = 0,                                    /*!< GameLoop_Team(). */
+	BENCH_UNIT      = 1,                                    /*!< GameLoop_Unit(). */
+	BENCH_STRUCTURE = 2,                                    /*!< GameLoop_Structure(). */
+	BENCH_HOUSE     = 3,                                    /*!< GameLoop_House(). */
+	BENCH_EXPLOSION = 4,                                    /*!< Explosion_Tick(). */
+	BENCH_ANIMATION = 5,                                    /*!< Animation_Tick(). */
+
+	BENCH_ZONE_MAX  = 6                                     /*!< The amount of zones. */
+} BenchZone;
+
+extern bool g_bench;
+
+extern bool Bench_Open(const char *filename);
+extern void Bench_Start(void);
+extern uint32 Bench_Now(void);
+extern uint32 Bench_Lap(BenchZone zone, uint32 start);
+extern void Bench_Report(uint16 scenarioID, const char *house, uint32 seed, uint32 ticks, const char *result);
+extern void Bench_Close(void);
+
+#endif /* BENCH_H */
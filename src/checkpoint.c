@@ -0,0 +1,632 @@
+/** @file src/checkpoint.c Checkpoint routines. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "os/endian.h"
+#include "os/error.h"
+
+#include "checkpoint.h"
+
+#include "file.h"
+#include "opendune.h"
+#include "pool/house.h"
+#include "pool/pool.h"
+#include "pool/structure.h"
+#include "pool/team.h"
+#include "pool/unit.h"
+#include "saveload/saveload.h"
+#include "state.h"
+
+/**
+ * The kinds of records in a checkpoint.
+ */
+typedef enum CheckpointKind {
+	CHECKPOINT_INFO      = 0,                               /*!< The INFO chunk of the savegame. */
+	CHECKPOINT_HOUSE     = 1,                               /*!< A House. */
+	CHECKPOINT_UNIT      = 2,                               /*!< A Unit, followed by its ODUN information. */
+	CHECKPOINT_STRUCTURE = 3,                               /*!< A Structure. */
+	CHECKPOINT_TEAM      = 4,                               /*!< A Team. */
+	CHECKPOINT_TILE      = 5,                               /*!< A Tile of the map. */
+
+	CHECKPOINT_MAX       = 6,                               /*!< The amount of kinds. */
+	CHECKPOINT_FREED     = 0x80                             /*!< Flag on the kind: the entry is no longer used, and no data follows. */
+} CheckpointKind;
+
+/**
+ * All records of one kind, serialised the way they are in a savegame.
+ */
+typedef struct CheckpointRecords {
+	uint16 count;                                           /*!< The amount of records. */
+	uint16 length;                                          /*!< The length of a single record. */
+	uint8 *used;                                            /*!< For each record, non-zero if the entry is in use. */
+	uint8 *data;                                            /*!< The records, count * length bytes. */
+} CheckpointRecords;
+
+/**
+ * The state of the game as a set of records.
+ */
+typedef struct CheckpointImage {
+	CheckpointRecords records[CHECKPOINT_MAX];              /*!< The records, per kind. */
+} CheckpointImage;
+
+uint32 g_checkpointInterval = 0;                            /*!< Game ticks between two checkpoints, or 0 to never checkpoint. */
+uint16 g_checkpointKeyframe = 60;                           /*!< Every this many checkpoints a keyframe is written. */
+
+static FILE           *s_checkpointFile        = NULL;      /*!< The file the checkpoints are written to. */
+static CheckpointImage s_checkpointImage[2];                /*!< The image of this and of the previous checkpoint. */
+static uint8           s_checkpointCurrent     = 0;         /*!< The index of the image of this checkpoint. */
+static uint8          *s_checkpointBuffer      = NULL;      /*!< The frame being written. */
+static uint32          s_checkpointLast        = 0;         /*!< The game tick of the last checkpoint. */
+static uint16          s_checkpointSinceKey    = 0;         /*!< The amount of checkpoints since the last keyframe, or 0 for a keyframe. */
+static bool            s_checkpointNow         = false;     /*!< True if the next tick should be checkpointed, regardless of the interval. */
+
+/**
+ * Get the maximum length of a frame, which is a keyframe with every entry in use.
+ *
+ * @param image The image.
+ * @return The maximum length in bytes, including the frame header.
+ */
+static uint32 Checkpoint_GetFrameLength(const CheckpointImage *image)
+{
+	uint32 length = 12;
+	uint8 i;
+
+	for (i = 0; i < CHECKPOINT_MAX; i++) {
+		length += (uint32)image->records[i].count * (3 + image->records[i].length);
+	}
+
+	return length;
+}
+
+/**
+ * Free the records of an image.
+ *
+ * @param image The image.
+ */
+static void Checkpoint_FreeImage(CheckpointImage *image)
+{
+	uint8 i;
+
+	for (i = 0; i < CHECKPOINT_MAX; i++) {
+		free(image->records[i].used);
+		free(image->records[i].data);
+		image->records[i].used = NULL;
+		image->records[i].data = NULL;
+	}
+}
+
+/**
+ * Allocate the records of an image, with no entry in use.
+ *
+ * @param image The image.
+ * @return True if and only if there was enough memory.
+ */
+static bool Checkpoint_AllocateImage(CheckpointImage *image)
+{
+	uint8 i;
+
+	image->records[CHECKPOINT_INFO].count      = 1;
+	image->records[CHECKPOINT_INFO].length     = (uint16)SaveLoad_GetLength(g_saveInfo);
+	image->records[CHECKPOINT_HOUSE].count     = HOUSE_INDEX_MAX;
+	image->records[CHECKPOINT_HOUSE].length    = (uint16)SaveLoad_GetLength(g_saveHouse);
+	image->records[CHECKPOINT_UNIT].count      = UNIT_INDEX_MAX;
+	image->records[CHECKPOINT_UNIT].length     = (uint16)(SaveLoad_GetLength(g_saveUnit) + SaveLoad_GetLength(g_saveUnitNew));
+	image->records[CHECKPOINT_STRUCTURE].count = STRUCTURE_INDEX_MAX_HARD;
+	image->records[CHECKPOINT_STRUCTURE].length = (uint16)SaveLoad_GetLength(g_saveStructure);
+	image->records[CHECKPOINT_TEAM].count      = TEAM_INDEX_MAX;
+	image->records[CHECKPOINT_TEAM].length     = (uint16)SaveLoad_GetLength(g_saveTeam);
+	image->records[CHECKPOINT_TILE].count      = 0x1000;
+	image->records[CHECKPOINT_TILE].length     = 4;
+
+	for (i = 0; i < CHECKPOINT_MAX; i++) {
+		CheckpointRecords *r = &image->records[i];
+
+		r->used = (uint8 *)calloc(r->count, 1);
+		r->data = (uint8 *)calloc(r->count, r->length);
+		if (r->used == NULL || r->data == NULL) {
+			Checkpoint_FreeImage(image);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Mark an entry of an image as in use.
+ *
+ * @param image The image.
+ * @param kind The kind of the entry.
+ * @param index The index of the entry.
+ * @return The record to serialise the entry to, or NULL if the index is invalid.
+ */
+static uint8 *Checkpoint_Use(CheckpointImage *image, uint8 kind, uint16 index)
+{
+	CheckpointRecords *r = &image->records[kind];
+
+	if (index >= r->count) return NULL;
+
+	r->used[index] = 1;
+	return r->data + (uint32)index * r->length;
+}
+
+/**
+ * Serialise the active GameState to an image, the same way a savegame does.
+ *
+ * @param image The image.
+ */
+static void Checkpoint_Capture(CheckpointImage *image)
+{
+	uint32 unitLength = SaveLoad_GetLength(g_saveUnit);
+	PoolFindStruct find;
+	uint8 *record;
+	uint16 i;
+
+	for (i = 0; i < CHECKPOINT_MAX; i++) memset(image->records[i].used, 0, image->records[i].count);
+
+	record = Checkpoint_Use(image, CHECKPOINT_INFO, 0);
+	SaveLoad_SaveToBuffer(g_saveInfo, record, image->records[CHECKPOINT_INFO].length, g_gameState);
+
+	/* Like the savegame, include the Units and Structures which are not on the map */
+	g_validateStrictIfZero++;
+
+	find.houseID = HOUSE_INVALID;
+	find.type    = 0xFFFF;
+	find.index   = 0xFFFF;
+
+	while (true) {
+		House *h = House_Find(&find);
+		if (h == NULL) break;
+
+		record = Checkpoint_Use(image, CHECKPOINT_HOUSE, h->index);
+		if (record != NULL) SaveLoad_SaveToBuffer(g_saveHouse, record, image->records[CHECKPOINT_HOUSE].length, h);
+	}
+
+	find.houseID = HOUSE_INVALID;
+	find.type    = 0xFFFF;
+	find.index   = 0xFFFF;
+
+	while (true) {
+		Unit *u = Unit_Find(&find);
+		if (u == NULL) break;
+
+		record = Checkpoint_Use(image, CHECKPOINT_UNIT, u->o.index);
+		if (record == NULL) continue;
+
+		SaveLoad_SaveToBuffer(g_saveUnit, record, unitLength, u);
+		SaveLoad_SaveToBuffer(g_saveUnitNew, record + unitLength, image->records[CHECKPOINT_UNIT].length - unitLength, u);
+	}
+
+	find.houseID = HOUSE_INVALID;
+	find.type    = 0xFFFF;
+	find.index   = 0xFFFF;
+
+	while (true) {
+		Structure *s = Structure_Find(&find);
+		if (s == NULL) break;
+
+		record = Checkpoint_Use(image, CHECKPOINT_STRUCTURE, s->o.index);
+		if (record != NULL) SaveLoad_SaveToBuffer(g_saveStructure, record, image->records[CHECKPOINT_STRUCTURE].length, s);
+	}
+
+	find.houseID = HOUSE_INVALID;
+	find.type    = 0xFFFF;
+	find.index   = 0xFFFF;
+
+	while (true) {
+		Team *t = Team_Find(&find);
+		if (t == NULL) break;
+
+		record = Checkpoint_Use(image, CHECKPOINT_TEAM, t->index);
+		if (record != NULL) SaveLoad_SaveToBuffer(g_saveTeam, record, image->records[CHECKPOINT_TEAM].length, t);
+	}
+
+	g_validateStrictIfZero--;
+
+	for (i = 0; i < 0x1000; i++) {
+		Map_SaveTile(&g_map[i], Checkpoint_Use(image, CHECKPOINT_TILE, i));
+	}
+}
+
+/**
+ * Write a frame to the checkpoint file. A keyframe holds every entry in use;
+ *  any other frame only the entries which differ from the previous frame.
+ *
+ * A frame is a 'KEYF' or 'DLTA' header, the length of the rest of the frame
+ *  (big endian, like the chunks of a savegame), the game tick, and then the
+ *  records: the kind, the index and, unless the kind has CHECKPOINT_FREED
+ *  set, the record itself.
+ *
+ * @param keyframe True if a keyframe should be written.
+ * @return True if and only if the frame was written.
+ */
+static bool Checkpoint_WriteFrame(bool keyframe)
+{
+	const CheckpointImage *current  = &s_checkpointImage[s_checkpointCurrent];
+	const CheckpointImage *previous = &s_checkpointImage[s_checkpointCurrent ^ 1];
+	uint8 *b = s_checkpointBuffer + 12;
+	uint32 length;
+	uint8 kind;
+
+	for (kind = 0; kind < CHECKPOINT_MAX; kind++) {
+		const CheckpointRecords *r = &current->records[kind];
+		const CheckpointRecords *p = &previous->records[kind];
+		uint16 i;
+
+		for (i = 0; i < r->count; i++) {
+			const uint8 *data = r->data + (uint32)i * r->length;
+			bool used = (r->used[i] != 0);
+
+			if (keyframe) {
+				if (!used) continue;
+			} else {
+				if (used != (p->used[i] != 0)) {
+					/* Allocated or freed since the previous frame */
+				} else if (!used || memcmp(data, p->data + (uint32)i * r->length, r->length) == 0) {
+					continue;
+				}
+			}
+
+			*b++ = used ? kind : (kind | CHECKPOINT_FREED);
+			WRITE_LE_UINT16(b, i);
+			b += 2;
+
+			if (!used) continue;
+
+			memcpy(b, data, r->length);
+			b += r->length;
+		}
+	}
+
+	length = (uint32)(b - s_checkpointBuffer);
+
+	memcpy(s_checkpointBuffer, keyframe ? "KEYF" : "DLTA", 4);
+	WRITE_BE_UINT32(s_checkpointBuffer + 4, length - 8);
+	WRITE_LE_UINT32(s_checkpointBuffer + 8, g_timerGame);
+
+	if (fwrite(s_checkpointBuffer, length, 1, s_checkpointFile) != 1) return false;
+
+	/* Make sure a checkpoint survives a crash of a long run */
+	fflush(s_checkpointFile);
+
+	return true;
+}
+
+/**
+ * Start writing checkpoints to a file.
+ *
+ * @param filename The file to write to.
+ * @return True if and only if the file could be created.
+ */
+bool Checkpoint_Open(const char *filename)
+{
+	if (!Checkpoint_AllocateImage(&s_checkpointImage[0]) || !Checkpoint_AllocateImage(&s_checkpointImage[1])) {
+		Error("Not enough memory for checkpoints\n");
+		Checkpoint_FreeImage(&s_checkpointImage[0]);
+		return false;
+	}
+
+	s_checkpointBuffer = (uint8 *)malloc(Checkpoint_GetFrameLength(&s_checkpointImage[0]));
+	if (s_checkpointBuffer == NULL) {
+		Error("Not enough memory for checkpoints\n");
+		Checkpoint_Close();
+		return false;
+	}
+
+	s_checkpointFile = fopen(filename, "wb");
+	if (s_checkpointFile == NULL) {
+		Error("Failed to open checkpoint file '%s' for writing\n", filename);
+		Checkpoint_Close();
+		return false;
+	}
+
+	s_checkpointCurrent  = 0;
+	s_checkpointLast     = 0;
+	s_checkpointSinceKey = 0;
+	s_checkpointNow      = true;
+
+	return true;
+}
+
+/**
+ * Write a checkpoint if the interval has passed since the last checkpoint.
+ *  Called once per game tick.
+ */
+void Checkpoint_Tick(void)
+{
+	bool keyframe;
+
+	if (s_checkpointFile == NULL || g_checkpointInterval == 0) return;
+
+	if (!s_checkpointNow && g_timerGame - s_checkpointLast < g_checkpointInterval) return;
+	s_checkpointLast = g_timerGame;
+	s_checkpointNow  = false;
+
+	keyframe = (s_checkpointSinceKey == 0);
+
+	Checkpoint_Capture(&s_checkpointImage[s_checkpointCurrent]);
+
+	if (!Checkpoint_WriteFrame(keyframe)) {
+		Error("Error while writing checkpoint\n");
+		Checkpoint_Close();
+		return;
+	}
+
+	s_checkpointCurrent ^= 1;
+	if (++s_checkpointSinceKey >= g_checkpointKeyframe) s_checkpointSinceKey = 0;
+}
+
+/**
+ * Make the next checkpoint a keyframe, written on the next tick regardless of
+ *  the interval. Called when a new scenario started or a savegame was loaded,
+ *  as the game no longer follows from the previous frame.
+ */
+void Checkpoint_ForceKeyframe(void)
+{
+	s_checkpointSinceKey = 0;
+	s_checkpointNow      = true;
+}
+
+/**
+ * Stop writing checkpoints.
+ */
+void Checkpoint_Close(void)
+{
+	if (s_checkpointFile != NULL) fclose(s_checkpointFile);
+	s_checkpointFile = NULL;
+
+	free(s_checkpointBuffer);
+	s_checkpointBuffer = NULL;
+
+	Checkpoint_FreeImage(&s_checkpointImage[0]);
+	Checkpoint_FreeImage(&s_checkpointImage[1]);
+}
+
+/**
+ * Apply the records of a frame to an image.
+ *
+ * @param image The image.
+ * @param data The records of the frame.
+ * @param length The length of the records.
+ * @return True if and only if the records are valid.
+ */
+static bool Checkpoint_ApplyFrame(CheckpointImage *image, const uint8 *data, uint32 length)
+{
+	const uint8 *end = data + length;
+
+	while (data != end) {
+		CheckpointRecords *r;
+		uint8 kind;
+		uint16 index;
+
+		if (end - data < 3) return false;
+
+		kind  = data[0] & ~CHECKPOINT_FREED;
+		index = READ_LE_UINT16(data + 1);
+		if (kind >= CHECKPOINT_MAX) return false;
+
+		r = &image->records[kind];
+		if (index >= r->count) return false;
+
+		if ((data[0] & CHECKPOINT_FREED) != 0) {
+			r->used[index] = 0;
+			data += 3;
+			continue;
+		}
+
+		if (end - data < 3 + r->length) return false;
+
+		r->used[index] = 1;
+		memcpy(r->data + (uint32)index * r->length, data + 3, r->length);
+		data += 3 + r->length;
+	}
+
+	return true;
+}
+
+/**
+ * Write a chunk of a savegame from memory.
+ *
+ * @param fp The file to write to.
+ * @param header The chunk identification string (4 chars, always).
+ * @param data The content of the chunk.
+ * @param length The length of the content.
+ * @return True if and only if all bytes were written successful.
+ */
+static bool Checkpoint_WriteChunk(FILE *fp, const char *header, const uint8 *data, uint32 length)
+{
+	uint8 buffer[4];
+
+	if (fwrite(header, 4, 1, fp) != 1) return false;
+
+	WRITE_BE_UINT32(buffer, length);
+	if (fwrite(buffer, 4, 1, fp) != 1) return false;
+
+	if (length != 0 && fwrite(data, length, 1, fp) != 1) return false;
+
+	/* Ensure we are word aligned */
+	if ((length & 1) == 1) {
+		uint8 empty = 0;
+		if (fwrite(&empty, 1, 1, fp) != 1) return false;
+	}
+
+	return true;
+}
+
+/**
+ * Collect the records of one kind in use into a buffer.
+ *
+ * @param buffer The buffer to write to.
+ * @param r The records.
+ * @param withIndex True if every record is preceded by its index.
+ * @param offset The offset in each record to start at.
+ * @param length The amount of bytes of each record to use.
+ * @return The length of the data in the buffer.
+ */
+static uint32 Checkpoint_CollectRecords(uint8 *buffer, const CheckpointRecords *r, bool withIndex, uint16 offset, uint16 length)
+{
+	uint8 *b = buffer;
+	uint16 i;
+
+	for (i = 0; i < r->count; i++) {
+		if (r->used[i] == 0) continue;
+
+		if (withIndex) {
+			WRITE_LE_UINT16(b, i);
+			b += 2;
+		}
+
+		memcpy(b, r->data + (uint32)i * r->length + offset, length);
+		b += length;
+	}
+
+	return (uint32)(b - buffer);
+}
+
+/**
+ * Write an image as a normal savegame.
+ *
+ * @param image The image.
+ * @param buffer A buffer as large as the largest frame.
+ * @param fp The file to write to.
+ * @param tick The game tick of the image.
+ * @return True if and only if all bytes were written successful.
+ */
+static bool Checkpoint_WriteSavegame(const CheckpointImage *image, uint8 *buffer, FILE *fp, uint32 tick)
+{
+	const CheckpointRecords *units = &image->records[CHECKPOINT_UNIT];
+	uint16 unitLength = (uint16)SaveLoad_GetLength(g_saveUnit);
+	char description[32];
+	uint32 length;
+
+	if (image->records[CHECKPOINT_INFO].used[0] == 0) return false;
+
+	if (fwrite("FORM", 4, 1, fp) != 1) return false;
+	/* The total length is not known yet; it is ignored when loading */
+	WRITE_BE_UINT32(buffer, 0);
+	if (fwrite(buffer, 4, 1, fp) != 1) return false;
+	if (fwrite("SCEN", 4, 1, fp) != 1) return false;
+
+	sprintf(description, "Checkpoint %lu", (unsigned long)tick);
+	if (!Checkpoint_WriteChunk(fp, "NAME", (const uint8 *)description, (uint32)strlen(description) + 1)) return false;
+
+	WRITE_LE_UINT16(buffer, 0x0290);
+	memcpy(buffer + 2, image->records[CHECKPOINT_INFO].data, image->records[CHECKPOINT_INFO].length);
+	if (!Checkpoint_WriteChunk(fp, "INFO", buffer, 2 + image->records[CHECKPOINT_INFO].length)) return false;
+
+	length = Checkpoint_CollectRecords(buffer, &image->records[CHECKPOINT_HOUSE], false, 0, image->records[CHECKPOINT_HOUSE].length);
+	if (!Checkpoint_WriteChunk(fp, "PLYR", buffer, length)) return false;
+
+	length = Checkpoint_CollectRecords(buffer, units, false, 0, unitLength);
+	if (!Checkpoint_WriteChunk(fp, "UNIT", buffer, length)) return false;
+
+	length = Checkpoint_CollectRecords(buffer, &image->records[CHECKPOINT_STRUCTURE], false, 0, image->records[CHECKPOINT_STRUCTURE].length);
+	if (!Checkpoint_WriteChunk(fp, "BLDG", buffer, length)) return false;
+
+	length = Checkpoint_CollectRecords(buffer, &image->records[CHECKPOINT_TILE], true, 0, 4);
+	if (!Checkpoint_WriteChunk(fp, "MAP ", buffer, length)) return false;
+
+	length = Checkpoint_CollectRecords(buffer, &image->records[CHECKPOINT_TEAM], false, 0, image->records[CHECKPOINT_TEAM].length);
+	if (!Checkpoint_WriteChunk(fp, "TEAM", buffer, length)) return false;
+
+	length = Checkpoint_CollectRecords(buffer, units, true, unitLength, units->length - unitLength);
+	if (!Checkpoint_WriteChunk(fp, "ODUN", buffer, length)) return false;
+
+	/* Write the total length of all data in the FORM chunk */
+	length = ftell(fp) - 8;
+	fseek(fp, 4, SEEK_SET);
+	WRITE_BE_UINT32(buffer, length);
+	if (fwrite(buffer, 4, 1, fp) != 1) return false;
+
+	return true;
+}
+
+/**
+ * Rebuild the game at a tick from a checkpoint file, and write it as a
+ *  normal savegame. The last keyframe at or before the tick is taken, and
+ *  all frames after it up to the tick are applied to it.
+ *
+ * @param filename The checkpoint file.
+ * @param tick The game tick to rebuild; 0xFFFFFFFF for the last frame.
+ * @param savegame The savegame to write.
+ * @return True if and only if the savegame was written.
+ */
+bool Checkpoint_Extract(const char *filename, uint32 tick, const char *savegame)
+{
+	CheckpointImage image;
+	uint8 header[12];
+	uint8 *buffer;
+	uint32 bufferLength;
+	uint32 frameTick = 0;
+	bool haveKeyframe = false;
+	bool res = false;
+	FILE *fp;
+
+	if (!Checkpoint_AllocateImage(&image)) return false;
+
+	bufferLength = Checkpoint_GetFrameLength(&image);
+	buffer = (uint8 *)malloc(bufferLength);
+	if (buffer == NULL) {
+		Checkpoint_FreeImage(&image);
+		return false;
+	}
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL) {
+		Error("Failed to open checkpoint file '%s' for reading\n", filename);
+	} else {
+		while (fread(header, 12, 1, fp) == 1) {
+			uint32 length = READ_BE_UINT32(header + 4);
+			bool keyframe = (memcmp(header, "KEYF", 4) == 0);
+
+			if ((!keyframe && memcmp(header, "DLTA", 4) != 0) || length < 4 || length - 4 > bufferLength) {
+				Error("Checkpoint file '%s' is invalid\n", filename);
+				haveKeyframe = false;
+				break;
+			}
+			if (READ_LE_UINT32(header + 8) > tick) break;
+
+			if (fread(buffer, length - 4, 1, fp) != 1) break;
+
+			if (keyframe) {
+				uint8 i;
+
+				for (i = 0; i < CHECKPOINT_MAX; i++) memset(image.records[i].used, 0, image.records[i].count);
+				haveKeyframe = true;
+			}
+
+			/* A frame before the first keyframe has nothing to apply to */
+			if (!haveKeyframe) continue;
+
+			if (!Checkpoint_ApplyFrame(&image, buffer, length - 4)) {
+				Error("Checkpoint file '%s' is invalid\n", filename);
+				haveKeyframe = false;
+				break;
+			}
+			frameTick = READ_LE_UINT32(header + 8);
+		}
+
+		fclose(fp);
+
+		if (!haveKeyframe) {
+			Error("No checkpoint at or before tick %lu in '%s'\n", (unsigned long)tick, filename);
+		} else {
+			fp = fopendatadir(SEARCHDIR_PERSONAL_DATA_DIR, savegame, "wb");
+			if (fp == NULL) {
+				Error("Failed to open file '%s' for writing.\n", savegame);
+			} else {
+				res = Checkpoint_WriteSavegame(&image, buffer, fp, frameTick);
+				fclose(fp);
+
+				if (!res) Error("Error while writing savegame.\n");
+			}
+		}
+	}
+
+	free(buffer);
+	Checkpoint_FreeImage(&image);
+
+	return res;
+}
@@ -0,0 +1,15 @@
+/** @file src/checkpoint.h Checkpoint definitions. */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+extern uint32 g_checkpointInterval;
+extern uint16 g_checkpointKeyframe;
+
+extern bool Checkpoint_Open(const char *filename);
+extern void Checkpoint_Tick(void);
+extern void Checkpoint_ForceKeyframe(void);
+extern void Checkpoint_Close(void);
+extern bool Checkpoint_Extract(const char *filename, uint32 tick, const char *savegame);
+
+#endif /* CHECKPOINT_H */
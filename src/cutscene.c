@@ -24,6 +24,7 @@
 #include "input/input.h"
 #include "opendune.h"
 #include "sprites.h"
+#include "state.h"
 #include "string.h"
 #include "table/strings.h"
 #include "timer.h"
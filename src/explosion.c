@@ -11,18 +11,23 @@
 #include "audio/sound.h"
 #include "house.h"
 #include "map.h"
+#include "opendune.h"
 #include "sprites.h"
+#include "state.h"
 #include "structure.h"
 #include "tile.h"
 #include "timer.h"
+#include "timerwheel.h"
 #include "tools.h"
 #include "os/error.h"
 #include "os/sleep.h"
 #include "video/video.h"
 
 
-static Explosion g_explosions[EXPLOSION_MAX];               /*!< Explosions. */
-static uint32 s_explosionTimer = 0;                         /*!< Timeout value for next explosion activity. */
+#define g_explosions     (g_gameState->explosions)
+#define g_explosionWheel (g_gameState->explosionWheel)
+
+assert_compile((int)EXPLOSION_MAX <= (int)TIMERWHEEL_ENTRIES_MAX);
 
 
 /**
@@ -131,6 +136,8 @@ static void Explosion_Func_ScreenShake(Explosion *e, uint16 parameter)
 	VARIABLE_NOT_USED(parameter);
 #endif
 
+	if (g_headless) return;
+
 	for(i = 0; i < 2; i++) {
 #if defined(_WIN32)
 		msleep(30);
@@ -211,6 +218,7 @@ static void Explosion_Func_Stop(Explosion *e, uint16 parameter)
 	Explosion_Update(0, e);
 
 	e->commands = NULL;
+	TimerWheel_Cancel(&g_explosionWheel, (uint16)(e - g_explosions));
 }
 
 /**
@@ -272,6 +280,7 @@ static void Explosion_StopAtPosition(uint16 packed)
 void Explosion_Init(void)
 {
 	memset(g_explosions, 0, EXPLOSION_MAX * sizeof(Explosion));
+	TimerWheel_Init(&g_explosionWheel, g_timerGUI);
 }
 
 /**
@@ -305,7 +314,7 @@ void Explosion_Start(uint16 explosionType, tile32 position)
 		e->position = position;
 		e->isDirty  = false;
 		e->timeOut  = g_timerGUI;
-		s_explosionTimer = 0;
+		TimerWheel_Schedule(&g_explosionWheel, i, e->timeOut);
 		g_map[packed].hasExplosion = true;
 
 		break;
@@ -313,47 +322,45 @@ void Explosion_Start(uint16 explosionType, tile32 position)
 }
 
 /**
- * Timer tick for explosions.
+ * Timer tick for explosions. Only the explosions that are due are visited.
  */
 void Explosion_Tick(void)
 {
-	uint8 i;
+	uint16 i;
 
-	if (s_explosionTimer > g_timerGUI) return;
-	s_explosionTimer += 10000;
+	TimerWheel_Advance(&g_explosionWheel, g_timerGUI);
 
-	for (i = 0; i < EXPLOSION_MAX; i++) {
+	/* Explosions started while handling one are handled in this tick too if they come after it, as before */
+	for (i = TimerWheel_PopDue(&g_explosionWheel, 0); i != TIMERWHEEL_INVALID; i = TimerWheel_PopDue(&g_explosionWheel, i + 1)) {
 		Explosion *e;
+		uint16 parameter;
+		uint16 command;
 
 		e = &g_explosions[i];
 
-		if (e->commands == NULL) continue;
+		parameter = e->commands[e->current].parameter;
+		command   = e->commands[e->current].command;
+
+		e->current++;
 
-		if (e->timeOut <= g_timerGUI) {
-			uint16 parameter = e->commands[e->current].parameter;
-			uint16 command   = e->commands[e->current].command;
-
-			e->current++;
-
-			switch (command) {
-				default:
-				case EXPLOSION_STOP:               Explosion_Func_Stop(e, parameter); break;
-
-				case EXPLOSION_SET_SPRITE:         Explosion_Func_SetSpriteID(e, parameter); break;
-				case EXPLOSION_SET_TIMEOUT:        Explosion_Func_SetTimeout(e, parameter); break;
-				case EXPLOSION_SET_RANDOM_TIMEOUT: Explosion_Func_SetRandomTimeout(e, parameter); break;
-				case EXPLOSION_MOVE_Y_POSITION:    Explosion_Func_MoveYPosition(e, parameter); break;
-				case EXPLOSION_TILE_DAMAGE:        Explosion_Func_TileDamage(e, parameter); break;
-				case EXPLOSION_PLAY_VOICE:         Explosion_Func_PlayVoice(e, parameter); break;
-				case EXPLOSION_SCREEN_SHAKE:       Explosion_Func_ScreenShake(e, parameter); break;
-				case EXPLOSION_SET_ANIMATION:      Explosion_Func_SetAnimation(e, parameter); break;
-				case EXPLOSION_BLOOM_EXPLOSION:    Explosion_Func_BloomExplosion(e, parameter); break;
-			}
+		switch (command) {
+			default:
+			case EXPLOSION_STOP:               Explosion_Func_Stop(e, parameter); break;
+
+			case EXPLOSION_SET_SPRITE:         Explosion_Func_SetSpriteID(e, parameter); break;
+			case EXPLOSION_SET_TIMEOUT:        Explosion_Func_SetTimeout(e, parameter); break;
+			case EXPLOSION_SET_RANDOM_TIMEOUT: Explosion_Func_SetRandomTimeout(e, parameter); break;
+			case EXPLOSION_MOVE_Y_POSITION:    Explosion_Func_MoveYPosition(e, parameter); break;
+			case EXPLOSION_TILE_DAMAGE:        Explosion_Func_TileDamage(e, parameter); break;
+			case EXPLOSION_PLAY_VOICE:         Explosion_Func_PlayVoice(e, parameter); break;
+			case EXPLOSION_SCREEN_SHAKE:       Explosion_Func_ScreenShake(e, parameter); break;
+			case EXPLOSION_SET_ANIMATION:      Explosion_Func_SetAnimation(e, parameter); break;
+			case EXPLOSION_BLOOM_EXPLOSION:    Explosion_Func_BloomExplosion(e, parameter); break;
 		}
 
-		if (e->commands == NULL || e->timeOut > s_explosionTimer) continue;
+		if (e->commands == NULL) continue;
 
-		s_explosionTimer = e->timeOut;
+		TimerWheel_Schedule(&g_explosionWheel, i, e->timeOut);
 	}
 }
 
@@ -0,0 +1,254 @@
+/** @file src/flowfield.c Flow field routines. */
+
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+
+#include "flowfield.h"
+
+#include "map.h"
+#include "state.h"
+#include "tile.h"
+#include "unit.h"
+
+static const int16 s_mapDirection[8] = {-64, -63, 1, 65, 64, 63, -1, -65}; /*!< Tile index change when moving in a direction. */
+
+/* The scratch space of a search is per thread, as games can run side by side */
+static THREAD_LOCAL uint32 s_flowFieldCost[64 * 64];             /*!< Per tile, the cost to get to the destination. */
+static THREAD_LOCAL uint16 s_flowFieldHeapIndex[64 * 64];        /*!< Per tile, the index in the open list, 0xFFFF if closed, 0xFFFE if unvisited. */
+static THREAD_LOCAL uint16 s_flowFieldHeap[64 * 64];             /*!< The open list, as binary heap on the cost. */
+static THREAD_LOCAL uint16 s_flowFieldHeapSize;                  /*!< Amount of tiles in the open list. */
+
+/**
+ * Move a tile in the open list up until the heap is valid again.
+ * @param index The index in the open list to move up.
+ */
+static void FlowField_HeapUp(uint16 index)
+{
+	uint16 packed = s_flowFieldHeap[index];
+
+	while (index != 0) {
+		uint16 parent = (index - 1) / 2;
+
+		if (s_flowFieldCost[s_flowFieldHeap[parent]] <= s_flowFieldCost[packed]) break;
+
+		s_flowFieldHeap[index] = s_flowFieldHeap[parent];
+		s_flowFieldHeapIndex[s_flowFieldHeap[index]] = index;
+		index = parent;
+	}
+
+	s_flowFieldHeap[index] = packed;
+	s_flowFieldHeapIndex[packed] = index;
+}
+
+/**
+ * Remove the tile with the lowest cost from the open list.
+ * @return The packed tile removed from the open list.
+ */
+static uint16 FlowField_HeapPop(void)
+{
+	uint16 res = s_flowFieldHeap[0];
+	uint16 packed;
+	uint16 index = 0;
+
+	s_flowFieldHeapIndex[res] = 0xFFFF;
+	if (--s_flowFieldHeapSize == 0) return res;
+
+	packed = s_flowFieldHeap[s_flowFieldHeapSize];
+
+	while (true) {
+		uint16 child = index * 2 + 1;
+
+		if (child >= s_flowFieldHeapSize) break;
+		if (child + 1 < s_flowFieldHeapSize && s_flowFieldCost[s_flowFieldHeap[child + 1]] < s_flowFieldCost[s_flowFieldHeap[child]]) child++;
+		if (s_flowFieldCost[packed] <= s_flowFieldCost[s_flowFieldHeap[child]]) break;
+
+		s_flowFieldHeap[index] = s_flowFieldHeap[child];
+		s_flowFieldHeapIndex[s_flowFieldHeap[index]] = index;
+		index = child;
+	}
+
+	s_flowFieldHeap[index] = packed;
+	s_flowFieldHeapIndex[packed] = index;
+
+	return res;
+}
+
+/**
+ * Get the score to enter a tile, looking only at the landscape. This is
+ *  Unit_GetTileEnterScore without the checks for objects on the tile.
+ *
+ * @param packed The packed tile.
+ * @param type The UnitType entering the tile.
+ * @param orient8 The direction we enter the tile in.
+ * @return 256 if the tile is not accessable, or a score for entering otherwise.
+ */
+static uint16 FlowField_GetScore(uint16 packed, uint8 type, uint8 orient8)
+{
+	if (!Map_IsValidPosition(packed) && g_table_unitInfo[type].movementType != MOVEMENT_WINGER) return 256;
+
+	return Unit_GetLandscapeEnterScore(type, g_flowFieldCache.landscape[packed], orient8);
+}
+
+/**
+ * Fill a flow field, with a Dijkstra search from the destination outwards.
+ *  Tiles that can't be entered still get a direction, so units standing on
+ *  them can leave, but no route goes through them.
+ *
+ * @param ff The flow field to fill.
+ */
+static void FlowField_Build(FlowField *ff)
+{
+	uint16 i;
+
+	if (!g_flowFieldCache.landscapeValid) {
+		for (i = 0; i < 64 * 64; i++) g_flowFieldCache.landscape[i] = (uint8)Map_GetLandscapeType(i);
+		g_flowFieldCache.landscapeValid = true;
+	}
+
+	memset(ff->direction, 0xFF, sizeof(ff->direction));
+	for (i = 0; i < 64 * 64; i++) s_flowFieldHeapIndex[i] = 0xFFFE;
+
+	s_flowFieldCost[ff->packedDst]      = 0;
+	s_flowFieldHeap[0]                  = ff->packedDst;
+	s_flowFieldHeapIndex[ff->packedDst] = 0;
+	s_flowFieldHeapSize                 = 1;
+
+	while (s_flowFieldHeapSize != 0) {
+		uint16 packedCur;
+		uint16 x, y;
+		uint8 dir;
+
+		packedCur = FlowField_HeapPop();
+
+		if (packedCur != ff->packedDst && FlowField_GetScore(packedCur, ff->unitType, 0) > 255) continue;
+
+		x = Tile_GetPackedX(packedCur);
+		y = Tile_GetPackedY(packedCur);
+
+		for (dir = 0; dir < 8; dir++) {
+			uint16 packedPrev;
+			uint16 score;
+			uint32 cost;
+			uint8 orient8;
+
+			if ((x == 0 && dir >= 5) || (x == 63 && dir >= 1 && dir <= 3)) continue;
+			if ((y == 0 && (dir <= 1 || dir == 7)) || (y == 63 && dir >= 3 && dir <= 5)) continue;
+
+			packedPrev = packedCur + s_mapDirection[dir];
+			if (s_flowFieldHeapIndex[packedPrev] == 0xFFFF) continue;
+
+			/* From the previous tile we move in the opposite direction to get here */
+			orient8 = (dir + 4) & 0x7;
+
+			score = FlowField_GetScore(packedCur, ff->unitType, orient8);
+			if (score > 255) score = 1;
+
+			cost = s_flowFieldCost[packedCur] + score;
+
+			if (s_flowFieldHeapIndex[packedPrev] == 0xFFFE) {
+				s_flowFieldHeapIndex[packedPrev] = s_flowFieldHeapSize;
+				s_flowFieldHeap[s_flowFieldHeapSize++] = packedPrev;
+			} else if (cost >= s_flowFieldCost[packedPrev]) {
+				continue;
+			}
+
+			s_flowFieldCost[packedPrev] = cost;
+			ff->direction[packedPrev]   = orient8;
+			FlowField_HeapUp(s_flowFieldHeapIndex[packedPrev]);
+		}
+	}
+
+	ff->isBuilt = true;
+}
+
+/**
+ * Get the flow field towards a destination. A field is only built the second
+ *  time it is requested, so a destination requested once doesn't pay for a
+ *  search over the whole map. Units have their own speed on each landscape,
+ *  so fields are per UnitType.
+ *
+ * @param packedDst The destination.
+ * @param type The UnitType of the unit that wants to move.
+ * @return Per tile the direction to move in (0xFF if there is none), or NULL if there is no field (yet).
+ */
+const uint8 *FlowField_Get(uint16 packedDst, uint8 type)
+{
+	FlowField *ff = NULL;
+	uint8 i;
+
+	if (type >= UNIT_MAX) return NULL;
+
+	g_flowFieldCache.usage++;
+
+	for (i = 0; i < FLOWFIELD_CACHE_SIZE; i++) {
+		FlowField *f = &g_flowFieldCache.fields[i];
+
+		if (f->requests != 0 && f->packedDst == packedDst && f->unitType == type) {
+			ff = f;
+			break;
+		}
+
+		/* Remember the least recently used field, in case we need a new one */
+		if (ff == NULL || (ff->requests != 0 && (f->requests == 0 || f->lastUsed < ff->lastUsed))) ff = f;
+	}
+
+	if (ff->requests == 0 || ff->packedDst != packedDst || ff->unitType != type) {
+		ff->packedDst = packedDst;
+		ff->unitType  = type;
+		ff->requests  = 1;
+		ff->isBuilt   = false;
+		ff->lastUsed  = g_flowFieldCache.usage;
+		return NULL;
+	}
+
+	ff->lastUsed = g_flowFieldCache.usage;
+	if (ff->requests < 0xFF) ff->requests++;
+
+	if (!ff->isBuilt) FlowField_Build(ff);
+
+	return ff->direction;
+}
+
+/**
+ * Forget all flow fields of the active GameState, for example because a new
+ *  map is loaded.
+ */
+void FlowField_Invalidate(void)
+{
+	uint8 i;
+
+	for (i = 0; i < FLOWFIELD_CACHE_SIZE; i++) g_flowFieldCache.fields[i].requests = 0;
+
+	g_flowFieldCache.landscapeValid = false;
+}
+
+/**
+ * Tell the flow fields a tile might have changed. Fields for which the
+ *  passability of the tile changed are rebuilt the next time they are used.
+ *
+ * @param packed The packed tile that changed.
+ */
+void FlowField_TileChanged(uint16 packed)
+{
+	uint8 oldType;
+	uint8 type;
+	uint8 i;
+
+	if (!g_flowFieldCache.landscapeValid) return;
+
+	type = (uint8)Map_GetLandscapeType(packed & 0xFFF);
+	if (g_flowFieldCache.landscape[packed & 0xFFF] == type) return;
+
+	oldType = g_flowFieldCache.landscape[packed & 0xFFF];
+	g_flowFieldCache.landscape[packed & 0xFFF] = type;
+
+	for (i = 0; i < FLOWFIELD_CACHE_SIZE; i++) {
+		FlowField *ff = &g_flowFieldCache.fields[i];
+
+		if (!ff->isBuilt) continue;
+		if (Unit_GetLandscapeEnterScore(ff->unitType, oldType, 0) == Unit_GetLandscapeEnterScore(ff->unitType, type, 0)) continue;
+
+		ff->isBuilt = false;
+	}
+}
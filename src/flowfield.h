@@ -0,0 +1,40 @@
+/** @file src/flowfield.h Flow field definitions. */
+
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+enum {
+	FLOWFIELD_CACHE_SIZE = 16                               /*!< The maximum amount of flow fields kept at the same time. */
+};
+
+/**
+ * A flow field: for every tile of the map, the direction to move in to get
+ *  to a single destination via the cheapest route.
+ */
+typedef struct FlowField {
+	uint16 packedDst;                                       /*!< The destination of this field. */
+	uint8  unitType;                                        /*!< The UnitType this field is for. */
+	uint8  requests;                                        /*!< How often this field was requested; 0 if the slot is unused. */
+	bool   isBuilt;                                         /*!< True if direction is filled. */
+	uint32 lastUsed;                                        /*!< When this field was last requested, to find the least recently used one. */
+	uint8  direction[64 * 64];                              /*!< Per tile, the direction to move in, or 0xFF if there is none. */
+} FlowField;
+
+/**
+ * The cached flow fields of a game. Whether a unit gets a flow field or an
+ *  A* route depends on what was requested before, so the cache is part of
+ *  the GameState: a snapshot continues with the same routes as the game it
+ *  was taken from. All zeros is an empty cache.
+ */
+typedef struct FlowFieldCache {
+	FlowField fields[FLOWFIELD_CACHE_SIZE];                 /*!< The cached flow fields. */
+	uint32 usage;                                           /*!< Counter to track when fields are used. */
+	bool   landscapeValid;                                  /*!< True if landscape matches the map. */
+	uint8  landscape[64 * 64];                              /*!< Per tile, the LandscapeType the flow fields are built with. */
+} FlowFieldCache;
+
+extern const uint8 *FlowField_Get(uint16 packedDst, uint8 type);
+extern void FlowField_Invalidate(void);
+extern void FlowField_TileChanged(uint16 packed);
+
+#endif /* FLOWFIELD_H */
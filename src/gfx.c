@@ -13,6 +13,7 @@
 #include "sprites.h"
 #include "video/video.h"
 #include "os/error.h"
+#include "os/math.h"
 
 uint8 g_paletteActive[256 * 3];
 uint8 *g_palette1 = NULL;
@@ -36,6 +37,8 @@ static void *s_screenBuffer[GFX_SCREEN_BUFFER_COUNT] = { NULL, NULL, NULL, NULL
 #ifdef GFX_STORE_DIRTY_AREA
 static bool s_screen0_is_dirty = false;
 static struct dirty_area s_screen0_dirty_area = { 0, 0, 0, 0 };
+static struct dirty_area s_screen0_dirty_rects[GFX_DIRTY_RECTS_MAX]; /*!< The dirty parts of SCREEN_0, not overlapping much. */
+static uint16 s_screen0_dirty_rects_count = 0;              /*!< The amount of rectangles in s_screen0_dirty_rects. */
 #ifdef GFX_STORE_DIRTY_AREA_BLOCKS
 uint32 g_dirty_blocks[200];
 #endif
@@ -106,6 +109,97 @@ bool GFX_Screen_IsActive(Screen screenID)
 }
 
 #ifdef GFX_STORE_DIRTY_AREA
+/**
+ * Get the amount of pixels in a rectangle.
+ *
+ * @param rect The rectangle.
+ * @return The amount of pixels.
+ */
+static uint32 GFX_DirtyRect_Size(const struct dirty_area *rect)
+{
+	return (uint32)(rect->right - rect->left) * (rect->bottom - rect->top);
+}
+
+/**
+ * Get the smallest rectangle containing two rectangles.
+ *
+ * @param dst Where to store the rectangle.
+ * @param a The first rectangle.
+ * @param b The second rectangle.
+ */
+static void GFX_DirtyRect_Union(struct dirty_area *dst, const struct dirty_area *a, const struct dirty_area *b)
+{
+	dst->left   = min(a->left, b->left);
+	dst->top    = min(a->top, b->top);
+	dst->right  = max(a->right, b->right);
+	dst->bottom = max(a->bottom, b->bottom);
+}
+
+/**
+ * Add a rectangle to the dirty rectangles of SCREEN_0. Rectangles are merged
+ *  when the merged rectangle is not bigger than both together (so when they
+ *  overlap, touch or nearly touch); when the list is full, the new rectangle
+ *  is merged with the rectangle that grows the least from it.
+ *
+ * @param left The left side of the rectangle.
+ * @param top The top side of the rectangle.
+ * @param right The right side of the rectangle (excluded).
+ * @param bottom The bottom side of the rectangle (excluded).
+ */
+static void GFX_Screen0_AddDirtyRect(uint16 left, uint16 top, uint16 right, uint16 bottom)
+{
+	struct dirty_area rect;
+	uint16 i;
+
+	if (right > SCREEN_WIDTH) right = SCREEN_WIDTH;
+	if (bottom > SCREEN_HEIGHT) bottom = SCREEN_HEIGHT;
+	if (left >= right || top >= bottom) return;
+
+	rect.left   = left;
+	rect.top    = top;
+	rect.right  = right;
+	rect.bottom = bottom;
+
+	i = 0;
+	while (i < s_screen0_dirty_rects_count) {
+		struct dirty_area merged;
+
+		GFX_DirtyRect_Union(&merged, &rect, &s_screen0_dirty_rects[i]);
+		if (GFX_DirtyRect_Size(&merged) > GFX_DirtyRect_Size(&rect) + GFX_DirtyRect_Size(&s_screen0_dirty_rects[i])) {
+			i++;
+			continue;
+		}
+
+		/* The merged rectangle can now overlap with ones looked at before */
+		rect = merged;
+		s_screen0_dirty_rects[i] = s_screen0_dirty_rects[--s_screen0_dirty_rects_count];
+		i = 0;
+	}
+
+	if (s_screen0_dirty_rects_count == GFX_DIRTY_RECTS_MAX) {
+		uint32 bestGrowth = 0xFFFFFFFF;
+		uint16 best = 0;
+
+		for (i = 0; i < s_screen0_dirty_rects_count; i++) {
+			struct dirty_area merged;
+			uint32 growth;
+
+			GFX_DirtyRect_Union(&merged, &rect, &s_screen0_dirty_rects[i]);
+			growth = GFX_DirtyRect_Size(&merged) - GFX_DirtyRect_Size(&s_screen0_dirty_rects[i]);
+			if (growth >= bestGrowth) continue;
+
+			bestGrowth = growth;
+			best = i;
+		}
+
+		/* This can make it overlap others, which only means some pixels are drawn twice */
+		GFX_DirtyRect_Union(&s_screen0_dirty_rects[best], &rect, &s_screen0_dirty_rects[best]);
+		return;
+	}
+
+	s_screen0_dirty_rects[s_screen0_dirty_rects_count++] = rect;
+}
+
 void GFX_Screen_SetDirty(Screen screenID, uint16 left, uint16 top, uint16 right, uint16 bottom)
 {
 #ifdef GFX_STORE_DIRTY_AREA_BLOCKS
@@ -119,6 +213,7 @@ void GFX_Screen_SetDirty(Screen screenID, uint16 left, uint16 top, uint16 right,
 	if (top < s_screen0_dirty_area.top) s_screen0_dirty_area.top = top;
 	if (right > s_screen0_dirty_area.right) s_screen0_dirty_area.right = right;
 	if (bottom > s_screen0_dirty_area.bottom) s_screen0_dirty_area.bottom = bottom;
+	GFX_Screen0_AddDirtyRect(left, top, right, bottom);
 #ifdef GFX_STORE_DIRTY_AREA_BLOCKS
 	mask = (1 << ((right + 15) >> 4)) - 1;
 	mask -= (1 << (left >> 4)) - 1;
@@ -135,6 +230,7 @@ void GFX_Screen_SetClean(Screen screenID)
 	s_screen0_dirty_area.top = 0xffff;
 	s_screen0_dirty_area.right = 0;
 	s_screen0_dirty_area.bottom = 0;
+	s_screen0_dirty_rects_count = 0;
 #ifdef GFX_STORE_DIRTY_AREA_BLOCKS
 	memset(g_dirty_blocks, 0, sizeof(g_dirty_blocks));
 #endif
@@ -154,6 +250,24 @@ struct dirty_area * GFX_Screen_GetDirtyArea(Screen screenID)
 	return &s_screen0_dirty_area;
 }
 
+/**
+ * Get the dirty rectangles of a screen. Together they cover everything
+ *  changed since the screen was last set clean, and they do not overlap much,
+ *  so drawing them one by one touches fewer pixels than the dirty area.
+ *
+ * @param screenID The screen to get the dirty rectangles of.
+ * @param rects Where to store a pointer to the rectangles.
+ * @return The amount of rectangles; 0 if there are none, or if the screen has
+ *  no dirty rectangles kept (which means everything should be drawn).
+ */
+uint16 GFX_Screen_GetDirtyRects(Screen screenID, const struct dirty_area **rects)
+{
+	if(screenID == SCREEN_ACTIVE) screenID = s_screenActiveID;
+	*rects = s_screen0_dirty_rects;
+	if(screenID != SCREEN_0) return 0;
+	return s_screen0_dirty_rects_count;
+}
+
 #endif /* GFX_STORE_DIRTY_AREA */
 
 /**
@@ -181,7 +295,12 @@ void GFX_Init(void)
 	}
 
 	/* special case for SCREEN_0 which is the MCGA frame buffer */
-	s_screenBuffer[0] = Video_GetFrameBuffer(GFX_Screen_GetSize_ByIndex(0));
+	if (g_headless) {
+		/* There is no video driver, so allocate it like the other screens */
+		s_screenBuffer[0] = calloc(1, SCREEN_WIDTH * (SCREEN_HEIGHT + 4));
+	} else {
+		s_screenBuffer[0] = Video_GetFrameBuffer(GFX_Screen_GetSize_ByIndex(0));
+	}
 
 	s_screenActiveID = SCREEN_0;
 }
@@ -194,6 +313,7 @@ void GFX_Uninit(void)
 	int i;
 
 	free(s_screenBuffer[1]);
+	if (g_headless) free(s_screenBuffer[0]);
 
 	for (i = 0; i < GFX_SCREEN_BUFFER_COUNT; i++) {
 		s_screenBuffer[i] = NULL;
@@ -485,7 +605,7 @@ void GFX_SetPalette(uint8 *palette)
 		   palette[to*3+1] != g_paletteActive[to*3+1] ||
 		   palette[to*3+2] != g_paletteActive[to*3+2]) break;
 	}
-	Video_SetPalette(palette + 3 * from, from, to - from + 1);
+	if (!g_headless) Video_SetPalette(palette + 3 * from, from, to - from + 1);
 
 	memcpy(g_paletteActive + 3 * from, palette + 3 * from, (to - from + 1) * 3);
 }
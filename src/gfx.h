@@ -51,10 +51,15 @@ extern void GFX_CopyToBuffer(int16 left, int16 top, uint16 width, uint16 height,
 
 struct dirty_area { uint16 left; uint16 top; uint16 right; uint16 bottom; };
 #ifdef GFX_STORE_DIRTY_AREA
+enum {
+	GFX_DIRTY_RECTS_MAX = 8                                 /*!< The maximum amount of dirty rectangles kept for SCREEN_0. */
+};
+
 extern void GFX_Screen_SetDirty(Screen screenID, uint16 left, uint16 top, uint16 right, uint16 bottom);
 extern void GFX_Screen_SetClean(Screen screenID);
 extern bool GFX_Screen_IsDirty(Screen screenID);
 extern struct dirty_area * GFX_Screen_GetDirtyArea(Screen screenID);
+extern uint16 GFX_Screen_GetDirtyRects(Screen screenID, const struct dirty_area **rects);
 #ifdef GFX_STORE_DIRTY_AREA_BLOCKS
 extern uint32 g_dirty_blocks[200];
 #endif
@@ -38,12 +38,14 @@
 #include "../pool/structure.h"
 #include "../pool/unit.h"
 #include "../sprites.h"
+#include "../state.h"
 #include "../string.h"
 #include "../structure.h"
 #include "../table/strings.h"
 #include "../tile.h"
 #include "../timer.h"
 #include "../tools.h"
+#include "../trace.h"
 #include "../unit.h"
 #include "../video/video.h"
 #include "../wsa.h"
@@ -786,6 +788,12 @@ uint16 GUI_DisplayModalMessage(const char *str, unsigned int spriteID, ...)
 	vsnprintf(textBuffer, sizeof(textBuffer), str, ap);
 	va_end(ap);
 
+	/* Nobody is there to click the message away */
+	if (g_headless) {
+		Debug("%s\n", textBuffer);
+		return 0;
+	}
+
 	GUI_Mouse_Hide_Safe();
 
 	oldScreenID = GFX_Screen_SetActive(SCREEN_0);
@@ -4635,7 +4643,9 @@ void GUI_DrawScreen(Screen screenID)
 		}
 	}
 
+	TRACE_BEGIN("GUI_Widget_Viewport_Draw");
 	GUI_Widget_Viewport_Draw(g_viewport_forceRedraw, hasScrolled, !GFX_Screen_IsActive(SCREEN_0));
+	TRACE_END("GUI_Widget_Viewport_Draw");
 
 	g_viewport_forceRedraw = false;
 
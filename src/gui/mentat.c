@@ -26,6 +26,7 @@
 #include "../opendune.h"
 #include "../scenario.h"
 #include "../sprites.h"
+#include "../state.h"
 #include "../string.h"
 #include "../table/strings.h"
 #include "../timer.h"
@@ -19,6 +19,7 @@
 #include "../load.h"
 #include "../opendune.h"
 #include "../sprites.h"
+#include "../state.h"
 #include "../string.h"
 #include "../table/strings.h"
 #include "../timer.h"
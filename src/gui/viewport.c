@@ -23,6 +23,7 @@
 #include "../pool/unit.h"
 #include "../scenario.h"
 #include "../sprites.h"
+#include "../state.h"
 #include "../string.h"
 #include "../structure.h"
 #include "../table/strings.h"
@@ -474,9 +475,10 @@ void GUI_Widget_Viewport_Draw(bool forceRedraw, bool hasScrolled, bool drawToMai
 
 			if (u == NULL) break;
 
-			if (u->o.index < 20 || u->o.index > 101) continue;
+			index = Unit_Index(u);
+			if (index < 20 || index > 101) continue;
 
-			packed = Tile_PackTile(u->o.position);
+			packed = Tile_PackTile(g_unitHotPosition[index]);
 
 			if ((!u->o.flags.s.isDirty || u->o.flags.s.isNotOnMap) && !forceRedraw && !BitArray_Test(g_dirtyViewport, packed)) continue;
 			u->o.flags.s.isDirty = false;
@@ -671,9 +673,10 @@ void GUI_Widget_Viewport_Draw(bool forceRedraw, bool hasScrolled, bool drawToMai
 
 			if (u == NULL) break;
 
-			if (u->o.index > 15) continue;
+			index = Unit_Index(u);
+			if (index > 15) continue;
 
-			curPos = Tile_PackTile(u->o.position);
+			curPos = Tile_PackTile(g_unitHotPosition[index]);
 
 			if ((!u->o.flags.s.isDirty || u->o.flags.s.isNotOnMap) && !forceRedraw && !BitArray_Test(g_dirtyViewport, curPos)) continue;
 			u->o.flags.s.isDirty = false;
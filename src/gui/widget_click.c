@@ -28,6 +28,7 @@
 #include "../pool/unit.h"
 #include "../save.h"
 #include "../sprites.h"
+#include "../state.h"
 #include "../string.h"
 #include "../structure.h"
 #include "../table/strings.h"
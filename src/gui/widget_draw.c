@@ -14,6 +14,7 @@
 #include "../pool/house.h"
 #include "../pool/unit.h"
 #include "../sprites.h"
+#include "../state.h"
 #include "../string.h"
 #include "../structure.h"
 #include "../table/strings.h"
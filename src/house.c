@@ -20,6 +20,7 @@
 #include "pool/structure.h"
 #include "pool/unit.h"
 #include "scenario.h"
+#include "state.h"
 #include "string.h"
 #include "structure.h"
 #include "table/strings.h"
@@ -30,18 +31,11 @@
 #include "wsa.h"
 
 
-House *g_playerHouse = NULL;
-HouseType g_playerHouseID = HOUSE_INVALID;
-uint16 g_houseMissileCountdown = 0;
-uint16 g_playerCreditsNoSilo = 0;
-uint16 g_playerCredits = 0; /*!< Credits shown to player as 'current'. */
-uint32 g_tickHousePowerMaintenance = 0;
-
-static uint32 s_tickHouseHouse = 0;
-static uint32 s_tickHouseStarport = 0;
-static uint32 s_tickHouseReinforcement = 0;
-static uint32 s_tickHouseMissileCountdown = 0;
-static uint32 s_tickHouseStarportAvailability = 0;
+#define g_tickHouseHouse                (g_gameState->tickHouseHouse)
+#define g_tickHouseStarport             (g_gameState->tickHouseStarport)
+#define g_tickHouseReinforcement        (g_gameState->tickHouseReinforcement)
+#define g_tickHouseMissileCountdown     (g_gameState->tickHouseMissileCountdown)
+#define g_tickHouseStarportAvailability (g_gameState->tickHouseStarportAvailability)
 
 static void House_EnsureHarvesterAvailable(uint8 houseID);
 
@@ -61,9 +55,9 @@ void GameLoop_House(void)
 
 	if (g_debugScenario) return;
 
-	if (s_tickHouseHouse <= g_timerGame) {
+	if (g_tickHouseHouse <= g_timerGame) {
 		tickHouse = true;
-		s_tickHouseHouse = g_timerGame + 900;
+		g_tickHouseHouse = g_timerGame + 900;
 	}
 
 	if (g_tickHousePowerMaintenance <= g_timerGame) {
@@ -71,24 +65,24 @@ void GameLoop_House(void)
 		g_tickHousePowerMaintenance = g_timerGame + 10800;
 	}
 
-	if (s_tickHouseStarport <= g_timerGame) {
+	if (g_tickHouseStarport <= g_timerGame) {
 		tickStarport = true;
-		s_tickHouseStarport = g_timerGame + 180;
+		g_tickHouseStarport = g_timerGame + 180;
 	}
 
-	if (s_tickHouseReinforcement <= g_timerGame) {
+	if (g_tickHouseReinforcement <= g_timerGame) {
 		tickReinforcement = true;
-		s_tickHouseReinforcement = g_timerGame + (g_debugGame ? 60 : 600);
+		g_tickHouseReinforcement = g_timerGame + (g_debugGame ? 60 : 600);
 	}
 
-	if (s_tickHouseMissileCountdown <= g_timerGame) {
+	if (g_tickHouseMissileCountdown <= g_timerGame) {
 		tickMissileCountdown = true;
-		s_tickHouseMissileCountdown = g_timerGame + 60;
+		g_tickHouseMissileCountdown = g_timerGame + 60;
 	}
 
-	if (s_tickHouseStarportAvailability <= g_timerGame) {
+	if (g_tickHouseStarportAvailability <= g_timerGame) {
 		tickStarportAvailability = true;
-		s_tickHouseStarportAvailability = g_timerGame + 1800;
+		g_tickHouseStarportAvailability = g_timerGame + 1800;
 	}
 
 	if (tickMissileCountdown && g_houseMissileCountdown != 0) {
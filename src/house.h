@@ -173,13 +173,6 @@ extern const HouseAnimation_Animation g_table_houseAnimation_animation[HOUSEANIM
 extern const HouseAnimation_Subtitle g_table_houseAnimation_subtitle[HOUSEANIMATION_MAX][32];
 extern const HouseAnimation_SoundEffect g_table_houseAnimation_soundEffect[HOUSEANIMATION_MAX][90];
 
-extern House *g_playerHouse;
-extern HouseType g_playerHouseID;
-extern uint16 g_houseMissileCountdown;
-extern uint16 g_playerCreditsNoSilo;
-extern uint16 g_playerCredits;
-extern uint32 g_tickHousePowerMaintenance;
-
 extern void GameLoop_House(void);
 extern uint8 House_StringToType(const char *name);
 extern bool House_AreAllied(uint8 houseID1, uint8 houseID2);
@@ -10,6 +10,8 @@
 #include "load.h"
 
 #include "audio/sound.h"
+#include "autosave.h"
+#include "checkpoint.h"
 #include "config.h"
 #include "file.h"
 #include "gui/gui.h"
@@ -20,6 +22,7 @@
 #include "os/error.h"
 #include "saveload/saveload.h"
 #include "sprites.h"
+#include "state.h"
 #include "string.h"
 #include "structure.h"
 #include "table/strings.h"
@@ -143,6 +146,9 @@ bool SaveGame_LoadFile(char *filename)
 		return false;
 	}
 
+	/* A savegame is a few tens of KiB; buffer it so it is read in a few large blocks */
+	setvbuf(fp, NULL, _IOFBF, 0x10000);
+
 	Sprites_LoadTiles();
 
 	g_validateStrictIfZero++;
@@ -158,6 +164,9 @@ bool SaveGame_LoadFile(char *filename)
 
 	if (g_gameMode != GM_RESTART) Game_Prepare();
 
+	Autosave_Reset();
+	Checkpoint_ForceKeyframe();
+
 	return true;
 }
 
@@ -12,6 +12,7 @@
 #include "animation.h"
 #include "audio/sound.h"
 #include "explosion.h"
+#include "flowfield.h"
 #include "gfx.h"
 #include "gui/gui.h"
 #include "gui/widget.h"
@@ -23,6 +24,7 @@
 #include "pool/structure.h"
 #include "scenario.h"
 #include "sprites.h"
+#include "state.h"
 #include "structure.h"
 #include "team.h"
 #include "timer.h"
@@ -32,19 +34,11 @@
 #include "file.h"
 
 
-uint16 g_mapTileID[64 * 64];
-Tile g_map[64 * 64];                                        /*!< All map data. */
 uint8 g_functions[3][3] = {{0, 1, 0}, {2, 3, 0}, {0, 1, 0}};
 
-uint8 g_dirtyMinimap[512];                                  /*!< Dirty tiles of the minimap (must be rendered again). */
 uint8 g_displayedMinimap[512];                              /*!< Displayed part of the minimap. */
-uint8 g_dirtyViewport[512];                                 /*!< Dirty tiles of the viewport (must be rendered again). */
 uint8 g_displayedViewport[512];                             /*!< Displayed part of the viewport. */
 
-uint16 g_changedTilesCount;                                 /*!< Number of changed tiles in #_changedTiles. */
-uint16 g_changedTiles[200];                                 /*!< Array of positions of changed tiles. */
-uint8 g_changedTilesMap[512];                               /*!< Bit array of changed tiles, in order not to loose changes. */
-
 static bool s_debugNoExplosionDamage = false;               /*!< When non-zero, explosions do no damage to their surrounding. */
 
 uint16 g_dirtyViewportCount = 0;
@@ -601,6 +595,8 @@ void Map_Update(uint16 packed, uint16 type, bool ignoreInvisible)
 		0
 	};
 
+	FlowField_TileChanged(packed);
+
 	if (!ignoreInvisible && !Map_IsTileVisible(packed)) return;
 
 	switch (type) {
@@ -1673,6 +1669,8 @@ void Map_CreateLandscape(uint32 seed)
 	}
 
 	for (i = 0; i < 4096; i++) g_mapTileID[i] = g_map[i].groundTileID;
+
+	FlowField_Invalidate();
 }
 
 /**
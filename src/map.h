@@ -67,19 +67,11 @@ typedef struct LandscapeInfo {
 
 struct Unit;
 
-extern uint16 g_mapTileID[64 * 64];
-extern Tile g_map[64 * 64];
 extern uint8 g_functions[3][3];
 
-extern uint8 g_dirtyMinimap[512];
 extern uint8 g_displayedMinimap[512];
-extern uint8 g_dirtyViewport[512];
 extern uint8 g_displayedViewport[512];
 
-extern uint16 g_changedTilesCount;
-extern uint16 g_changedTiles[200];
-extern uint8 g_changedTilesMap[512];
-
 extern const MapInfo g_mapInfos[3];
 extern const int16 g_table_mapDiff[4];
 extern const tile32 g_table_tilediff[34][8];
@@ -8,6 +8,7 @@
 #include "map.h"
 #include "pool/structure.h"
 #include "pool/unit.h"
+#include "state.h"
 #include "structure.h"
 #include "tile.h"
 #include "tools.h"
@@ -37,6 +37,9 @@
 #include "animation.h"
 #include "audio/driver.h"
 #include "audio/sound.h"
+#include "autosave.h"
+#include "bench.h"
+#include "checkpoint.h"
 #include "config.h"
 #include "crashlog/crashlog.h"
 #include "cutscene.h"
@@ -59,8 +62,12 @@
 #include "pool/unit.h"
 #include "pool/structure.h"
 #include "pool/team.h"
+#include "replay.h"
+#include "saveload/saveload.h"
 #include "scenario.h"
+#include "script/profile.h"
 #include "sprites.h"
+#include "state.h"
 #include "string.h"
 #include "structure.h"
 #include "table/strings.h"
@@ -68,6 +75,7 @@
 #include "tile.h"
 #include "timer.h"
 #include "tools.h"
+#include "trace.h"
 #include "unit.h"
 #include "video/video.h"
 
@@ -80,20 +88,17 @@ const char *window_caption = "OpenDUNE - v0.9";
 
 bool g_dune2_enhanced = true; /*!< If false, the game acts exactly like the original Dune2, including bugs. */
 bool g_starPortEnforceUnitLimit = false;	/*!< If true, one cannot circumvent unit cap using starport */
+bool g_unitStaggered = false;	/*!< If true, the periodic work of Units is spread over the ticks instead of done for all Units at once */
 bool g_unpackSHPonLoad = true;	/*!< If true, Format80 encoded sprites from SHP files will be decoded on load. set to false to save memory */
 
-uint32 g_hintsShown1 = 0;          /*!< A bit-array to indicate which hints has been show already (0-31). */
-uint32 g_hintsShown2 = 0;          /*!< A bit-array to indicate which hints has been show already (32-63). */
 GameMode g_gameMode = GM_MENU;
-uint16 g_campaignID = 0;
-uint16 g_scenarioID = 1;
-uint16 g_activeAction = 0xFFFF;      /*!< Action the controlled unit will do. */
-uint32 g_tickScenarioStart = 0;      /*!< The tick the scenario started in. */
-static uint32 s_tickGameTimeout = 0; /*!< The tick the game will timeout. */
+
+#define g_tickGameTimeout (g_gameState->tickGameTimeout)
 
 bool   g_debugGame = false;        /*!< When true, you can control the AI. */
 bool   g_debugScenario = false;    /*!< When true, you can review the scenario. There is no fog. The game is not running (no unit-movement, no structure-building, etc). You can click on individual tiles. */
 bool   g_debugSkipDialogs = false; /*!< When non-zero, you immediately go to house selection, and skip all intros. */
+bool   g_headless = false;         /*!< When true, there is no video, audio or input, and a single scenario is simulated as fast as possible. */
 
 void *g_readBuffer = NULL;
 uint32 g_readBufferSize = 0;
@@ -102,15 +107,12 @@ static bool  s_debugForceWin = false; /*!< When true, you immediately win the le
 
 static uint8 s_enableLog = 0; /*!< 0 = off, 1 = record game, 2 = playback game (stored in 'dune.log'). */
 
-uint16 g_validateStrictIfZero = 0; /*!< 0 = strict validation, basically: no-cheat-mode. */
+THREAD_LOCAL uint16 g_validateStrictIfZero = 0; /*!< 0 = strict validation, basically: no-cheat-mode. Per thread, as saving raises it. */
 bool g_running = true; /*!< true if game needs to keep running; false to stop the game. */
-uint16 g_selectionType = 0;
 uint16 g_selectionTypeNew = 0;
 bool g_viewport_forceRedraw = false; /*!< Force a full redraw of the screen. */
 bool g_viewport_fadein = false; /*!< Fade in the screen. */
 
-int16 g_musicInBattle = 0; /*!< 0 = no battle, 1 = fight is going on, -1 = music of fight is going on is active. */
-
 /**
  * Check if a level is finished, based on the values in WinFlags.
  *
@@ -173,7 +175,7 @@ static bool GameLoop_IsLevelFinished(void)
 		/* XXX -- This code was with '<' instead of '>=', which makes
 		 *  no sense. As it is unused, who knows what the intentions
 		 *  were. This at least makes it sensible. */
-		if (g_timerGame >= s_tickGameTimeout) {
+		if (g_timerGame >= g_tickGameTimeout) {
 			finish = true;
 		}
 	}
@@ -236,7 +238,7 @@ static bool GameLoop_IsLevelWon(void)
 
 	/* Check for reaching timeout */
 	if (!win && (g_scenario.loseFlags & 0x8) != 0) {
-		win = (g_timerGame < s_tickGameTimeout);
+		win = (g_timerGame < g_tickGameTimeout);
 	}
 
 	return win;
@@ -251,6 +253,11 @@ void GameLoop_Uninit(void)
 		free(w);
 	}
 
+	ScriptProfile_Uninit();
+	Autosave_Uninit();
+	Checkpoint_Close();
+	SaveLoad_Uninit();
+
 	Script_ClearInfo(g_scriptStructure);
 	Script_ClearInfo(g_scriptTeam);
 
@@ -897,6 +904,38 @@ static void InGame_Numpad_Move(uint16 key)
 	}
 }
 
+/**
+ * Set the input flags the game is played with.
+ */
+static void GameLoop_Input_Init(void)
+{
+	Input_Flags_SetBits(INPUT_FLAG_KEY_REPEAT | INPUT_FLAG_UNKNOWN_0010 | INPUT_FLAG_UNKNOWN_0200 |
+	                    INPUT_FLAG_KBD_MOUSE_CLK);
+	Input_Flags_ClearBits(INPUT_FLAG_KEY_RELEASE | INPUT_FLAG_UNKNOWN_0400 | INPUT_FLAG_UNKNOWN_0100 |
+	                      INPUT_FLAG_UNKNOWN_0080 | INPUT_FLAG_UNKNOWN_0040 | INPUT_FLAG_UNKNOWN_0020 |
+	                      INPUT_FLAG_UNKNOWN_0008 | INPUT_FLAG_UNKNOWN_0004 | INPUT_FLAG_NO_TRANSLATE);
+}
+
+/**
+ * Create the palette mappings the widgets and the viewport are drawn with,
+ *  from g_palette1.
+ */
+static void GameLoop_PaletteMappings_Create(void)
+{
+	g_paletteMapping1 = malloc(256);
+	g_paletteMapping2 = malloc(256);
+
+	GUI_Palette_CreateMapping(g_palette1, g_paletteMapping1, 0xC, 0x55);
+	g_paletteMapping1[0xFF] = 0xFF;
+	g_paletteMapping1[0xDF] = 0xDF;
+	g_paletteMapping1[0xEF] = 0xEF;
+
+	GUI_Palette_CreateMapping(g_palette1, g_paletteMapping2, 0xF, 0x55);
+	g_paletteMapping2[0xFF] = 0xFF;
+	g_paletteMapping2[0xDF] = 0xDF;
+	g_paletteMapping2[0xEF] = 0xEF;
+}
+
 /**
  * Main game loop.
  */
@@ -917,11 +956,7 @@ static void GameLoop_Main(void)
 	if (IniFile_GetInteger("mt32midi", 0) != 0) Music_InitMT32();
 #endif
 
-	Input_Flags_SetBits(INPUT_FLAG_KEY_REPEAT | INPUT_FLAG_UNKNOWN_0010 | INPUT_FLAG_UNKNOWN_0200 |
-	                    INPUT_FLAG_KBD_MOUSE_CLK);
-	Input_Flags_ClearBits(INPUT_FLAG_KEY_RELEASE | INPUT_FLAG_UNKNOWN_0400 | INPUT_FLAG_UNKNOWN_0100 |
-	                      INPUT_FLAG_UNKNOWN_0080 | INPUT_FLAG_UNKNOWN_0040 | INPUT_FLAG_UNKNOWN_0020 |
-	                      INPUT_FLAG_UNKNOWN_0008 | INPUT_FLAG_UNKNOWN_0004 | INPUT_FLAG_NO_TRANSLATE);
+	GameLoop_Input_Init();
 
 	Timer_SetTimer(TIMER_GAME, true);
 	Timer_SetTimer(TIMER_GUI, true);
@@ -953,18 +988,7 @@ static void GameLoop_Main(void)
 	GFX_SetPalette(g_palette1);
 	GFX_SetPalette(g_palette2);
 
-	g_paletteMapping1 = malloc(256);
-	g_paletteMapping2 = malloc(256);
-
-	GUI_Palette_CreateMapping(g_palette1, g_paletteMapping1, 0xC, 0x55);
-	g_paletteMapping1[0xFF] = 0xFF;
-	g_paletteMapping1[0xDF] = 0xDF;
-	g_paletteMapping1[0xEF] = 0xEF;
-
-	GUI_Palette_CreateMapping(g_palette1, g_paletteMapping2, 0xF, 0x55);
-	g_paletteMapping2[0xFF] = 0xFF;
-	g_paletteMapping2[0xDF] = 0xDF;
-	g_paletteMapping2[0xEF] = 0xEF;
+	GameLoop_PaletteMappings_Create();
 
 	Script_LoadFromFile("TEAM.EMC", g_scriptTeam, g_scriptFunctionsTeam, NULL);
 	Script_LoadFromFile("BUILD.EMC", g_scriptStructure, g_scriptFunctionsStructure, NULL);
@@ -1086,7 +1110,9 @@ static void GameLoop_Main(void)
 
 		GFX_Screen_SetActive(SCREEN_0);
 
+		TRACE_BEGIN("GUI_Widget_HandleEvents");
 		key = GUI_Widget_HandleEvents(g_widgetLinkedListHead);
+		TRACE_END("GUI_Widget_HandleEvents");
 
 		if (g_selectionType == SELECTIONTYPE_TARGET || g_selectionType == SELECTIONTYPE_PLACE || g_selectionType == SELECTIONTYPE_UNIT || g_selectionType == SELECTIONTYPE_STRUCTURE) {
 			if (g_unitSelected != NULL) {
@@ -1106,12 +1132,25 @@ static void GameLoop_Main(void)
 
 			GUI_DrawCredits(g_playerHouseID, 0);
 
+			TRACE_BEGIN("GameLoop_Team");
 			GameLoop_Team();
+			TRACE_END("GameLoop_Team");
+			TRACE_BEGIN("GameLoop_Unit");
 			GameLoop_Unit();
+			TRACE_END("GameLoop_Unit");
+			TRACE_BEGIN("GameLoop_Structure");
 			GameLoop_Structure();
+			TRACE_END("GameLoop_Structure");
+			TRACE_BEGIN("GameLoop_House");
 			GameLoop_House();
+			TRACE_END("GameLoop_House");
+
+			Autosave_Tick();
+			Checkpoint_Tick();
 
+			TRACE_BEGIN("GUI_DrawScreen");
 			GUI_DrawScreen(SCREEN_0);
+			TRACE_END("GUI_DrawScreen");
 		}
 
 		GUI_DisplayText(NULL, 0);
@@ -1138,6 +1177,216 @@ static void GameLoop_Main(void)
 	GUI_Screen_FadeIn(g_curWidgetXBase, g_curWidgetYBase, g_curWidgetXBase, g_curWidgetYBase, g_curWidgetWidth, g_curWidgetHeight, SCREEN_1, SCREEN_0);
 }
 
+/**
+ * Load everything the headless game loop needs, except for the scenario.
+ */
+static void GameLoop_Headless_Init(void)
+{
+	String_Init();
+	Sprites_Init();
+
+	Timer_SetTimer(TIMER_GAME, true);
+	Timer_SetTimer(TIMER_GUI, true);
+
+	g_palette1 = calloc(1, 256 * 3);
+	g_palette2 = calloc(1, 256 * 3);
+
+	g_readBufferSize = 12000;
+	g_readBuffer = calloc(1, g_readBufferSize);
+
+	ReadProfileIni("PROFILE.INI");
+
+	Script_LoadFromFile("TEAM.EMC", g_scriptTeam, g_scriptFunctionsTeam, NULL);
+	Script_LoadFromFile("BUILD.EMC", g_scriptStructure, g_scriptFunctionsStructure, NULL);
+
+	GameOptions_Load();
+}
+
+/**
+ * Handle the input of a tick in the headless game loop, the way
+ *  GameLoop_Main() does. The input comes from the input log being played
+ *  back; the widgets are drawn to the screen buffers, but never shown.
+ */
+static void GameLoop_Headless_Input(void)
+{
+	uint16 key;
+
+	if (g_selectionTypeNew != g_selectionType) GUI_ChangeSelectionType(g_selectionTypeNew);
+
+	GFX_Screen_SetActive(SCREEN_0);
+
+	key = GUI_Widget_HandleEvents(g_widgetLinkedListHead);
+
+	if (g_selectionType == SELECTIONTYPE_TARGET || g_selectionType == SELECTIONTYPE_PLACE || g_selectionType == SELECTIONTYPE_UNIT || g_selectionType == SELECTIONTYPE_STRUCTURE) {
+		InGame_Numpad_Move(key);
+	}
+}
+
+/**
+ * Load a scenario and simulate it without any video or audio. The only input
+ *  is an optional input log played back. Instead of waiting for the timer
+ *  interrupt, the game time is advanced by this loop itself, so the game
+ *  runs as fast as the CPU allows.
+ *
+ * @param houseID The House the scenario is played as.
+ * @param scenarioID The Scenario to load.
+ * @param ticks The amount of game ticks to simulate, or 0 to run until the level ends.
+ * @param seed The seed for the random generators.
+ * @param input The input log to play back (as written with debug_log_game=1), or NULL for no input.
+ * @return The amount of game ticks simulated.
+ */
+static uint32 GameLoop_Headless_Run(uint8 houseID, uint16 scenarioID, uint32 ticks, uint32 seed, const char *input)
+{
+	uint32 tick;
+
+	Unit_Init();
+	Team_Init();
+	House_Init();
+	Structure_Init();
+
+	/* Scenario 1 is campaign 0, scenario 2 to 4 is campaign 1, etc. See GUI_StrategicMap_ScenarioSelection() */
+	g_campaignID = (scenarioID + 1) / 3;
+	g_playerHouseID = houseID;
+	g_selectionType = SELECTIONTYPE_MENTAT;
+	g_selectionTypeNew = SELECTIONTYPE_MENTAT;
+
+	Game_LoadScenario(houseID, scenarioID);
+
+	/* Playing back an input log seeds the random generators too; the seed of the run wins */
+	if (input != NULL) {
+		Input_History_Clear();
+		Mouse_SetMouseMode(INPUT_MOUSE_MODE_PLAY, input);
+	}
+
+	Tools_Random_Seed(seed);
+	Tools_RandomLCG_Seed((uint16)seed);
+
+	g_gameMode = GM_NORMAL;
+	GUI_ChangeSelectionType(SELECTIONTYPE_STRUCTURE);
+
+	Bench_Start();
+
+	for (tick = 0; ticks == 0 || tick < ticks; tick++) {
+		uint32 lap;
+
+		Timer_Tick();
+
+		if (input != NULL) GameLoop_Headless_Input();
+
+		lap = Bench_Now();
+		GameLoop_Team();
+		lap = Bench_Lap(BENCH_TEAM, lap);
+		GameLoop_Unit();
+		lap = Bench_Lap(BENCH_UNIT, lap);
+		GameLoop_Structure();
+		lap = Bench_Lap(BENCH_STRUCTURE, lap);
+		GameLoop_House();
+		Bench_Lap(BENCH_HOUSE, lap);
+
+		Autosave_Tick();
+		Checkpoint_Tick();
+
+		/* These are normally done by GUI_DrawScreen() */
+		lap = Bench_Now();
+		Explosion_Tick();
+		lap = Bench_Lap(BENCH_EXPLOSION, lap);
+		Animation_Tick();
+		Bench_Lap(BENCH_ANIMATION, lap);
+		Unit_Sort();
+
+		if (!Replay_Tick(tick)) {
+			tick++;
+			break;
+		}
+
+		if (GameLoop_IsLevelFinished()) break;
+	}
+
+	if (input != NULL) Mouse_SetMouseMode(INPUT_MOUSE_MODE_NORMAL, NULL);
+
+	return tick;
+}
+
+/**
+ * Get how a scenario simulated by GameLoop_Headless_Run() ended.
+ *
+ * @return "won", "lost" or "unfinished".
+ */
+static const char *GameLoop_Headless_Result(void)
+{
+	if (!GameLoop_IsLevelFinished()) return "unfinished";
+	if (GameLoop_IsLevelWon()) return "won";
+	return "lost";
+}
+
+/**
+ * Headless game loop. Loads a single scenario, simulates it and prints the
+ *  result.
+ *
+ * @param houseID The House the scenario is played as.
+ * @param scenarioID The Scenario to load.
+ * @param ticks The amount of game ticks to simulate, or 0 to run until the level ends.
+ * @param seed The seed for the random generators.
+ * @param input The input log to play back, or NULL for no input.
+ */
+static void GameLoop_Headless(uint8 houseID, uint16 scenarioID, uint32 ticks, uint32 seed, const char *input)
+{
+	uint32 timeStart;
+	uint32 timeTaken;
+	uint32 tick;
+
+	GameLoop_Headless_Init();
+
+	/* The input log is handled by the same widgets as in the normal game */
+	if (input != NULL) {
+		GameLoop_Input_Init();
+
+		File_ReadBlockFile("IBM.PAL", g_palette1, 256 * 3);
+		GameLoop_PaletteMappings_Create();
+
+		Window_WidgetClick_Create();
+	}
+
+	timeStart = Timer_GetTime();
+	tick = GameLoop_Headless_Run(houseID, scenarioID, ticks, seed, input);
+	timeTaken = Timer_GetTime() - timeStart;
+
+	printf("scenario=%u house=%s seed=%lu ticks=%lu time_ms=%lu result=%s\n",
+		scenarioID, g_table_houseInfo[houseID].name, (unsigned long)seed, (unsigned long)tick, (unsigned long)timeTaken, GameLoop_Headless_Result());
+}
+
+/**
+ * Headless benchmark. Simulates every scenario of every playable House for
+ *  a fixed amount of ticks with the same seed, and writes the timings with
+ *  Bench_Report().
+ *
+ * @param ticks The amount of game ticks to simulate per scenario.
+ * @param seed The seed for the random generators.
+ */
+static void GameLoop_Bench(uint32 ticks, uint32 seed)
+{
+	static const uint8 houses[] = { HOUSE_HARKONNEN, HOUSE_ATREIDES, HOUSE_ORDOS };
+	uint8 i;
+
+	GameLoop_Headless_Init();
+
+	for (i = 0; i < lengthof(houses); i++) {
+		uint16 scenarioID;
+
+		for (scenarioID = 1; scenarioID <= 22; scenarioID++) {
+			char filename[14];
+			uint32 tick;
+
+			sprintf(filename, "SCEN%c%03hu.INI", g_table_houseInfo[houses[i]].name[0], scenarioID);
+			if (!File_Exists(filename)) continue;
+
+			tick = GameLoop_Headless_Run(houses[i], scenarioID, ticks, seed, NULL);
+
+			Bench_Report(scenarioID, g_table_houseInfo[houses[i]].name, seed, tick, GameLoop_Headless_Result());
+		}
+	}
+}
+
 /**
  * Initialize Timer, Video, Mouse, GFX, Fonts, Random number generator
  * and current Widget
@@ -1156,15 +1405,20 @@ static bool OpenDune_Init(int screen_magnification, VideoScaleFilter filter, int
 		return false;
 	}
 
-	Timer_Init();
+	if (g_headless) {
+		/* Time is advanced by GameLoop_Headless() */
+		Timer_SetManual(true);
+	} else {
+		Timer_Init();
 
-	if (!Video_Init(screen_magnification, filter)) return false;
+		if (!Video_Init(screen_magnification, filter)) return false;
 
-	Mouse_Init();
+		Mouse_Init();
 
-	/* Add the general tickers */
-	Timer_Add(Timer_Tick, 1000000 / 60, false);
-	Timer_Add(Video_Tick, 1000000 / frame_rate, true);
+		/* Add the general tickers */
+		Timer_Add(Timer_Tick, 1000000 / 60, false);
+		Timer_Add(Video_Tick, 1000000 / frame_rate, true);
+	}
 
 	g_mouseDisabled = -1;
 
@@ -1248,6 +1502,22 @@ int main(int argc, char **argv)
 	int scaling_factor = 2;
 	int frame_rate = 60;
 	char filter_text[64];
+	char house_text[16];
+	char replay_record[256];
+	char replay_verify[256];
+	char replay_input[256];
+	char checkpoint_file[256];
+	char checkpoint_extract[256];
+	char checkpoint_savegame[256];
+	char bench_file[256];
+	char trace_file[256];
+	uint32 checkpoint_tick = 0xFFFFFFFF;
+	uint16 headless_scenario;
+	uint8 headless_house;
+	uint32 headless_ticks;
+	uint32 headless_seed;
+	bool replay_match = true;
+	int i;
 #if defined(_WIN32)
 	#if defined(__MINGW32__) && defined(__STRICT_ANSI__)
 	#if 0 /* NOTE : disabled because it generates warnings when cross compiling
@@ -1293,10 +1563,9 @@ int main(int argc, char **argv)
 	if(g_outlog != NULL) setvbuf(g_outlog, NULL, _IOLBF, 0);
 #endif
 #endif /* DOS */
-	CrashLog_Init();
+	GameState_Reset(g_gameState);
 
-	VARIABLE_NOT_USED(argc);
-	VARIABLE_NOT_USED(argv);
+	CrashLog_Init();
 
 	/* Load opendune.ini file */
 	Load_IniFile();
@@ -1308,6 +1577,90 @@ int main(int argc, char **argv)
 	g_debugSkipDialogs = (IniFile_GetInteger("debug_skip_dialogs", 0) != 0) ? true : false;
 	s_enableLog = (uint8)IniFile_GetInteger("debug_log_game", 0);
 	g_starPortEnforceUnitLimit = (IniFile_GetInteger("startport_unit_cap", 0) != 0) ? true : false;
+	g_unitStaggered = (IniFile_GetInteger("unit_stagger", 0) != 0) ? true : false;
+	g_headless = (IniFile_GetInteger("headless", 0) != 0) ? true : false;
+	g_scriptProfile = (IniFile_GetInteger("debug_script_profile", 0) != 0) ? true : false;
+	g_autosaveInterval = (uint32)IniFile_GetInteger("autosave", 0) * 60 * 60;
+	headless_scenario = (uint16)IniFile_GetInteger("headless_scenario", 1);
+	headless_ticks = (uint32)IniFile_GetInteger("headless_ticks", 0);
+	headless_seed = (uint32)IniFile_GetInteger("headless_seed", 0);
+	IniFile_GetString("headless_house", "atreides", house_text, sizeof(house_text));
+	IniFile_GetString("headless_record", "", replay_record, sizeof(replay_record));
+	IniFile_GetString("headless_verify", "", replay_verify, sizeof(replay_verify));
+	IniFile_GetString("headless_input", "", replay_input, sizeof(replay_input));
+	IniFile_GetString("headless_bench", "", bench_file, sizeof(bench_file));
+	IniFile_GetString("checkpoint", "", checkpoint_file, sizeof(checkpoint_file));
+	g_checkpointInterval = (uint32)IniFile_GetInteger("checkpoint_interval", 5) * 60;
+	g_checkpointKeyframe = (uint16)IniFile_GetInteger("checkpoint_keyframe", 60);
+	if (IniFile_GetString("trace", NULL, trace_file, sizeof(trace_file)) != NULL) Trace_Init(trace_file);
+	checkpoint_extract[0] = '\0';
+	strcpy(checkpoint_savegame, "_checkpt.dat");
+
+	/* Command line options prevail over opendune.ini */
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--headless") == 0) {
+			g_headless = true;
+		} else if (strncmp(argv[i], "--scenario=", 11) == 0) {
+			headless_scenario = (uint16)atoi(argv[i] + 11);
+		} else if (strncmp(argv[i], "--ticks=", 8) == 0) {
+			headless_ticks = (uint32)strtoul(argv[i] + 8, NULL, 10);
+		} else if (strncmp(argv[i], "--seed=", 7) == 0) {
+			headless_seed = (uint32)strtoul(argv[i] + 7, NULL, 10);
+		} else if (strncmp(argv[i], "--house=", 8) == 0) {
+			strncpy(house_text, argv[i] + 8, sizeof(house_text) - 1);
+			house_text[sizeof(house_text) - 1] = '\0';
+		} else if (strncmp(argv[i], "--record=", 9) == 0) {
+			strncpy(replay_record, argv[i] + 9, sizeof(replay_record) - 1);
+			replay_record[sizeof(replay_record) - 1] = '\0';
+		} else if (strncmp(argv[i], "--verify=", 9) == 0) {
+			strncpy(replay_verify, argv[i] + 9, sizeof(replay_verify) - 1);
+			replay_verify[sizeof(replay_verify) - 1] = '\0';
+		} else if (strncmp(argv[i], "--input=", 8) == 0) {
+			strncpy(replay_input, argv[i] + 8, sizeof(replay_input) - 1);
+			replay_input[sizeof(replay_input) - 1] = '\0';
+		} else if (strncmp(argv[i], "--bench=", 8) == 0) {
+			strncpy(bench_file, argv[i] + 8, sizeof(bench_file) - 1);
+			bench_file[sizeof(bench_file) - 1] = '\0';
+		} else if (strncmp(argv[i], "--checkpoint=", 13) == 0) {
+			strncpy(checkpoint_file, argv[i] + 13, sizeof(checkpoint_file) - 1);
+			checkpoint_file[sizeof(checkpoint_file) - 1] = '\0';
+		} else if (strncmp(argv[i], "--extract=", 10) == 0) {
+			strncpy(checkpoint_extract, argv[i] + 10, sizeof(checkpoint_extract) - 1);
+			checkpoint_extract[sizeof(checkpoint_extract) - 1] = '\0';
+		} else if (strncmp(argv[i], "--extract-tick=", 15) == 0) {
+			checkpoint_tick = (uint32)strtoul(argv[i] + 15, NULL, 10);
+		} else if (strncmp(argv[i], "--extract-savegame=", 19) == 0) {
+			strncpy(checkpoint_savegame, argv[i] + 19, sizeof(checkpoint_savegame) - 1);
+			checkpoint_savegame[sizeof(checkpoint_savegame) - 1] = '\0';
+		} else {
+			Warning("Unknown command line option '%s'\n", argv[i]);
+		}
+	}
+
+	headless_house = House_StringToType(house_text);
+	if (g_headless && headless_house == HOUSE_INVALID) {
+		Error("unrecognized house '%s'\n", house_text);
+		return 1;
+	}
+
+	/* A benchmark runs every scenario headless; replays are for a single scenario */
+	if (bench_file[0] != '\0') {
+		g_headless = true;
+		if (!Bench_Open(bench_file)) return 1;
+
+		/* Without a limit, a scenario could run forever */
+		if (headless_ticks == 0) headless_ticks = 3600;
+	} else if (g_headless && replay_verify[0] != '\0') {
+		/* A replay is run with the settings and input it was recorded with, until its last tick */
+		if (!Replay_Verify(replay_verify, &headless_house, &headless_scenario, &headless_seed, replay_input, sizeof(replay_input))) return 1;
+		if (headless_house >= HOUSE_MAX) {
+			Error("unrecognized house %d in replay\n", headless_house);
+			return 1;
+		}
+		headless_ticks = 0;
+	} else if (g_headless && replay_record[0] != '\0') {
+		if (!Replay_Record(replay_record, headless_house, headless_scenario, headless_seed, replay_input)) return 1;
+	}
 
 	Debug("Globals :\n");
 	Debug("  g_dune2_enhanced = %d\n", (int)g_dune2_enhanced);
@@ -1316,11 +1669,30 @@ int main(int argc, char **argv)
 	Debug("  g_debugSkipDialogs = %d\n", (int)g_debugSkipDialogs);
 	Debug("  s_enableLog = %d\n", (int)s_enableLog);
 	Debug("  g_starPortEnforceUnitLimit = %d\n", (int)g_starPortEnforceUnitLimit);
+	Debug("  g_unitStaggered = %d\n", (int)g_unitStaggered);
+	Debug("  g_headless = %d\n", (int)g_headless);
+	Debug("  g_scriptProfile = %d\n", (int)g_scriptProfile);
 
 	if (!File_Init()) {
 		return 1;
 	}
 
+	if (!SaveLoad_Init()) {
+		return 1;
+	}
+
+	/* Rebuilding a savegame from a checkpoint file needs nothing else */
+	if (checkpoint_extract[0] != '\0') {
+		bool res = Checkpoint_Extract(checkpoint_extract, checkpoint_tick, checkpoint_savegame);
+
+		Free_IniFile();
+		return res ? 0 : 1;
+	}
+
+	if (checkpoint_file[0] != '\0') {
+		if (!Checkpoint_Open(checkpoint_file)) return 1;
+	}
+
 	/* Loading config from dune.cfg */
 	if (!Config_Read("dune.cfg", &g_config)) {
 		Config_Default(&g_config);
@@ -1338,6 +1710,11 @@ int main(int argc, char **argv)
 	Input_Init();
 	/* if no mouse is detected, we should Input_Flags_SetBits(INPUT_FLAG_MOUSE_EMUL) */
 
+	if (g_headless) {
+		g_enableSoundMusic = false;
+		g_enableVoices = false;
+	}
+
 	Drivers_All_Init();
 
 	scaling_factor = IniFile_GetInteger("scalefactor", 2);
@@ -1359,14 +1736,24 @@ int main(int argc, char **argv)
 
 	g_mouseDisabled = 0;
 
-	GameLoop_Main();
+	if (g_bench) {
+		GameLoop_Bench(headless_ticks, headless_seed);
 
-	PrintToConsole(String_Get_ByIndex(STR_THANK_YOU_FOR_PLAYING_DUNE_II));
+		Bench_Close();
+	} else if (g_headless) {
+		GameLoop_Headless(headless_house, headless_scenario, headless_ticks, headless_seed, (replay_input[0] != '\0') ? replay_input : NULL);
+
+		replay_match = Replay_Close();
+	} else {
+		GameLoop_Main();
+
+		PrintToConsole(String_Get_ByIndex(STR_THANK_YOU_FOR_PLAYING_DUNE_II));
+	}
 
 	PrepareEnd();
 	Free_IniFile();
 
-	return 0;
+	return replay_match ? 0 : 1;
 }
 
 /**
@@ -1562,6 +1949,9 @@ void Game_LoadScenario(uint8 houseID, uint16 scenarioID)
 	}
 
 	g_validateStrictIfZero--;
+
+	Autosave_Reset();
+	Checkpoint_ForceKeyframe();
 }
 
 /**
@@ -1586,5 +1976,5 @@ void PrepareEnd(void)
 	File_Uninit();
 	Timer_Uninit();
 	GFX_Uninit();
-	Video_Uninit();
+	if (!g_headless) Video_Uninit();
 }
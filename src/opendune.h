@@ -19,28 +19,21 @@ typedef struct XYPosition {
 extern const char *window_caption;
 extern bool g_dune2_enhanced;
 extern bool g_starPortEnforceUnitLimit;
+extern bool g_unitStaggered;
 extern bool g_unpackSHPonLoad;
 
-extern uint32 g_hintsShown1;
-extern uint32 g_hintsShown2;
 extern GameMode g_gameMode;
-extern uint16 g_campaignID;
-extern uint16 g_scenarioID;
-extern uint16 g_activeAction;
-extern uint32 g_tickScenarioStart;
 extern bool   g_debugGame;
 extern bool   g_debugScenario;
 extern bool   g_debugSkipDialogs;
+extern bool   g_headless;
 
-extern uint16 g_validateStrictIfZero;
+extern THREAD_LOCAL uint16 g_validateStrictIfZero;
 extern bool g_running;
-extern uint16 g_selectionType;
 extern uint16 g_selectionTypeNew;
 extern bool g_viewport_forceRedraw;
 extern bool g_viewport_fadein;
 
-extern int16 g_musicInBattle;
-
 extern void *g_readBuffer;
 extern uint32 g_readBufferSize;
 
@@ -8,6 +8,13 @@
 	typedef HANDLE Thread;
 	typedef HANDLE Semaphore;
 	typedef DWORD ThreadStatus;
+#elif defined(PTHREAD)
+	#include <pthread.h>
+	typedef pthread_t *Thread;
+	typedef struct PthreadSemaphore *Semaphore;
+	typedef void *ThreadStatus;
+
+	#define WINAPI
 #else
 /* Thead is only used with Windows
 	#include <SDL.h>
@@ -20,7 +27,9 @@
 */
 #endif /* _WIN32 */
 
-#if defined(_WIN32)
+#if defined(_WIN32) || defined(PTHREAD)
+#define WITH_THREADS
+
 typedef ThreadStatus (WINAPI *ThreadProc)(void *);
 
 extern Thread Thread_Create(ThreadProc proc, void *data);
@@ -30,6 +39,6 @@ extern bool Semaphore_Unlock(Semaphore sem);
 extern bool Semaphore_Lock(Semaphore sem);
 extern bool Semaphore_TryLock(Semaphore sem);
 extern void Semaphore_Destroy(Semaphore sem);
-#endif /* _WIN32 */
+#endif /* _WIN32 || PTHREAD */
 
 #endif /* OS_THREAD_H */
@@ -0,0 +1,108 @@
+/** @file src/os/thread_pthread.c Platform dependant thread implementation for POSIX threads. */
+
+#if !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE 200112L
+#endif /* !_POSIX_C_SOURCE */
+#include <signal.h>
+#include <stdlib.h>
+#include "types.h"
+
+#include "thread.h"
+
+/**
+ * A semaphore with at most one unit, like the ones used on win32.
+ */
+struct PthreadSemaphore {
+	pthread_mutex_t mutex;                                  /*!< Protects value. */
+	pthread_cond_t cond;                                    /*!< Signalled when value becomes non-zero. */
+	int value;                                              /*!< The amount of units available. */
+};
+
+Thread Thread_Create(ThreadProc proc, void *data)
+{
+	Thread thread;
+	sigset_t all;
+	sigset_t old;
+	int res;
+
+	thread = (Thread)malloc(sizeof(pthread_t));
+	if (thread == NULL) return NULL;
+
+	/* The timer is driven by SIGALRM, which has to be handled by the game
+	 *  thread; block all signals in the new thread (it inherits the mask) */
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &old);
+	res = pthread_create(thread, NULL, proc, data);
+	pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+	if (res != 0) {
+		free(thread);
+		return NULL;
+	}
+
+	return thread;
+}
+
+void Thread_Wait(Thread thread, ThreadStatus *status)
+{
+	pthread_join(*thread, status);
+	free(thread);
+}
+
+Semaphore Semaphore_Create(int value)
+{
+	Semaphore sem = (Semaphore)malloc(sizeof(struct PthreadSemaphore));
+	if (sem == NULL) return NULL;
+
+	pthread_mutex_init(&sem->mutex, NULL);
+	pthread_cond_init(&sem->cond, NULL);
+	sem->value = value;
+
+	return sem;
+}
+
+bool Semaphore_Unlock(Semaphore sem)
+{
+	bool res = false;
+
+	pthread_mutex_lock(&sem->mutex);
+	if (sem->value < 1) {
+		sem->value++;
+		pthread_cond_signal(&sem->cond);
+		res = true;
+	}
+	pthread_mutex_unlock(&sem->mutex);
+
+	return res;
+}
+
+bool Semaphore_Lock(Semaphore sem)
+{
+	pthread_mutex_lock(&sem->mutex);
+	while (sem->value == 0) pthread_cond_wait(&sem->cond, &sem->mutex);
+	sem->value--;
+	pthread_mutex_unlock(&sem->mutex);
+
+	return true;
+}
+
+bool Semaphore_TryLock(Semaphore sem)
+{
+	bool res = false;
+
+	pthread_mutex_lock(&sem->mutex);
+	if (sem->value != 0) {
+		sem->value--;
+		res = true;
+	}
+	pthread_mutex_unlock(&sem->mutex);
+
+	return res;
+}
+
+void Semaphore_Destroy(Semaphore sem)
+{
+	pthread_cond_destroy(&sem->cond);
+	pthread_mutex_destroy(&sem->mutex);
+	free(sem);
+}
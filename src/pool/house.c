@@ -1,6 +1,7 @@
 /** @file src/pool/house.c %House pool routines. */
 
 #include <assert.h>
+#include <stdio.h>
 #include <string.h>
 #include "types.h"
 
@@ -9,10 +10,11 @@
 #include "pool.h"
 #include "unit.h"
 #include "../house.h"
+#include "../state.h"
 
-static struct House g_houseArray[HOUSE_INDEX_MAX];
-static struct House *g_houseFindArray[HOUSE_INDEX_MAX];
-static uint16 g_houseFindCount;
+#define g_houseArray     (g_gameState->houseArray)
+#define g_houseFindArray (g_gameState->houseFindArray)
+#define g_houseFindCount (g_gameState->houseFindCount)
 
 /**
  * Get a House from the pool with the indicated index.
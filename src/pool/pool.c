@@ -0,0 +1,129 @@
+/** @file src/pool/pool.c %Generic pool routines. */
+
+#include "types.h"
+
+#include "pool.h"
+
+/**
+ * Make a PoolList empty.
+ *
+ * @param list The list to initialize.
+ */
+void PoolList_Init(PoolList *list)
+{
+	list->first = 0xFFFF;
+	list->last  = 0xFFFF;
+	list->count = 0;
+}
+
+/**
+ * Insert an item in a PoolList, keeping the list sorted on position. Items
+ *  are normally added at the end of the find array, so the search for the
+ *  right place starts at the end of the list.
+ *
+ * @param list The list to insert the item in.
+ * @param links The links of all items of the pool.
+ * @param position Per item, its position in the find array of the pool.
+ * @param index The index of the item to insert.
+ */
+void PoolList_Insert(PoolList *list, PoolLink *links, const uint16 *position, uint16 index)
+{
+	uint16 prev = list->last;
+
+	while (prev != 0xFFFF && position[prev] > position[index]) prev = links[prev].prev;
+
+	links[index].prev = prev;
+	if (prev == 0xFFFF) {
+		links[index].next = list->first;
+		list->first = index;
+	} else {
+		links[index].next = links[prev].next;
+		links[prev].next = index;
+	}
+
+	if (links[index].next == 0xFFFF) {
+		list->last = index;
+	} else {
+		links[links[index].next].prev = index;
+	}
+
+	list->count++;
+}
+
+/**
+ * Remove an item from a PoolList.
+ *
+ * @param list The list to remove the item from.
+ * @param links The links of all items of the pool.
+ * @param index The index of the item to remove.
+ */
+void PoolList_Remove(PoolList *list, PoolLink *links, uint16 index)
+{
+	uint16 next = links[index].next;
+	uint16 prev = links[index].prev;
+
+	if (prev == 0xFFFF) {
+		list->first = next;
+	} else {
+		links[prev].next = next;
+	}
+
+	if (next == 0xFFFF) {
+		list->last = prev;
+	} else {
+		links[next].prev = prev;
+	}
+
+	list->count--;
+}
+
+/**
+ * Swap an item in a PoolList with the item after it.
+ *
+ * @param list The list the items are in.
+ * @param links The links of all items of the pool.
+ * @param index The index of the first of both items.
+ */
+void PoolList_Swap(PoolList *list, PoolLink *links, uint16 index)
+{
+	uint16 other = links[index].next;
+	uint16 prev  = links[index].prev;
+	uint16 next  = links[other].next;
+
+	links[other].prev = prev;
+	links[other].next = index;
+	links[index].prev = other;
+	links[index].next = next;
+
+	if (prev == 0xFFFF) {
+		list->first = other;
+	} else {
+		links[prev].next = other;
+	}
+
+	if (next == 0xFFFF) {
+		list->last = index;
+	} else {
+		links[next].prev = index;
+	}
+}
+
+/**
+ * Find the first item in a PoolList at or after a position in the find array.
+ *
+ * @param list The list to search in.
+ * @param links The links of all items of the pool.
+ * @param position Per item, its position in the find array of the pool.
+ * @param start The position to start at.
+ * @return The index of the item, or 0xFFFF if there is none.
+ */
+uint16 PoolList_Find(const PoolList *list, const PoolLink *links, const uint16 *position, uint16 start)
+{
+	uint16 index;
+
+	for (index = list->first; index != 0xFFFF; index = links[index].next) {
+		if (position[index] >= start) break;
+	}
+
+	return index;
+}
@@ -13,4 +13,28 @@ typedef struct PoolFindStruct {
 	uint16 index;   /*!< Last index of search, or -1 to start from begin. */
 } PoolFindStruct;
 
+/**
+ * A list of pool items, linked via their index. The items are kept in the
+ *  same order as they have in the find array of the pool.
+ */
+typedef struct PoolList {
+	uint16 first;   /*!< Index of the first item, or 0xFFFF if the list is empty. */
+	uint16 last;    /*!< Index of the last item, or 0xFFFF if the list is empty. */
+	uint16 count;   /*!< Amount of items in the list. */
+} PoolList;
+
+/**
+ * The links of a single pool item in a PoolList.
+ */
+typedef struct PoolLink {
+	uint16 next;    /*!< Index of the next item, or 0xFFFF if this is the last. */
+	uint16 prev;    /*!< Index of the previous item, or 0xFFFF if this is the first. */
+} PoolLink;
+
+extern void PoolList_Init(PoolList *list);
+extern void PoolList_Insert(PoolList *list, PoolLink *links, const uint16 *position, uint16 index);
+extern void PoolList_Remove(PoolList *list, PoolLink *links, uint16 index);
+extern void PoolList_Swap(PoolList *list, PoolLink *links, uint16 index);
+extern uint16 PoolList_Find(const PoolList *list, const PoolLink *links, const uint16 *position, uint16 start);
+
 #endif /* POOL_POOL_H */
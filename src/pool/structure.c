@@ -11,11 +11,20 @@
 #include "pool.h"
 #include "../house.h"
 #include "../opendune.h"
+#include "../state.h"
 #include "../structure.h"
-
-static struct Structure g_structureArray[STRUCTURE_INDEX_MAX_HARD];
-static struct Structure *g_structureFindArray[STRUCTURE_INDEX_MAX_SOFT];
-static uint16 g_structureFindCount;
+#include "../tools.h"
+
+#define g_structureArray        (g_gameState->structureArray)
+#define g_structureFindArray    (g_gameState->structureFindArray)
+#define g_structureFindCount    (g_gameState->structureFindCount)
+#define g_structureFree         (g_gameState->structureFree)
+#define g_structureFindPosition (g_gameState->structureFindPosition)
+#define g_structureHouseList    (g_gameState->structureHouseList)
+#define g_structureHouses       (g_gameState->structureHouses)
+#define g_structureHouseLinks   (g_gameState->structureHouseLinks)
+#define g_structureTypes        (g_gameState->structureTypes)
+#define g_structureTypeLinks    (g_gameState->structureTypeLinks)
 
 /**
  * Get a Structure from the pool with the indicated index.
@@ -39,10 +48,50 @@ Structure *Structure_Get_ByIndex(uint16 index)
  */
 Structure *Structure_Find(PoolFindStruct *find)
 {
+	const PoolList *list = NULL;
+	const PoolLink *links = NULL;
+
 	if (find->index >= g_structureFindCount + 3 && find->index != 0xFFFF) return NULL;
 	find->index++; /* First, we always go to the next index */
 
 	assert(g_structureFindCount <= STRUCTURE_INDEX_MAX_SOFT);
+
+	/* Walk the shortest list of Structures that all match part of the filter */
+	if (find->houseID < HOUSE_MAX) {
+		list  = &g_structureHouses[find->houseID];
+		links = g_structureHouseLinks;
+	}
+	if (find->type < STRUCTURE_MAX && (list == NULL || g_structureTypes[find->type].count < list->count)) {
+		list  = &g_structureTypes[find->type];
+		links = g_structureTypeLinks;
+	}
+
+	if (list != NULL && find->index < g_structureFindCount) {
+		Structure *prev = (find->index == 0) ? NULL : g_structureFindArray[find->index - 1];
+		uint16 index;
+
+		/* Normally we continue right after the previous result, which is in the list too */
+		if (prev != NULL && (links == g_structureHouseLinks ? g_structureHouseList[prev->o.index] == find->houseID : prev->o.type == find->type)) {
+			index = links[prev->o.index].next;
+		} else {
+			index = PoolList_Find(list, links, g_structureFindPosition, find->index);
+		}
+
+		for (; index != 0xFFFF; index = links[index].next) {
+			Structure *s = &g_structureArray[index];
+
+			if (s->o.flags.s.isNotOnMap && g_validateStrictIfZero == 0) continue;
+			if (find->houseID != HOUSE_INVALID           && find->houseID != s->o.houseID) continue;
+			if (find->type    != STRUCTURE_INDEX_INVALID && find->type    != s->o.type)  continue;
+
+			find->index = g_structureFindPosition[index];
+			return s;
+		}
+
+		/* Continue with the special structures after the find array */
+		find->index = g_structureFindCount;
+	}
+
 	for (; find->index < g_structureFindCount + 3; find->index++) {
 		Structure *s = NULL;
 
@@ -80,6 +129,51 @@ Structure *Structure_Find(PoolFindStruct *find)
 	return NULL;
 }
 
+/**
+ * Add a Structure to the end of the find array and to the lists it belongs in.
+ *
+ * @param s The Structure to add.
+ */
+static void Structure_AddToFind(Structure *s)
+{
+	uint16 index = s->o.index;
+
+	g_structureFindPosition[index] = g_structureFindCount;
+	g_structureFindArray[g_structureFindCount++] = s;
+
+	g_structureHouseList[index] = s->o.houseID;
+	PoolList_Insert(&g_structureHouses[s->o.houseID], g_structureHouseLinks, g_structureFindPosition, index);
+	PoolList_Insert(&g_structureTypes[s->o.type], g_structureTypeLinks, g_structureFindPosition, index);
+}
+
+/**
+ * Make all Structure lists empty.
+ */
+static void Structure_ClearLists(void)
+{
+	uint8 i;
+
+	for (i = 0; i < HOUSE_MAX; i++) PoolList_Init(&g_structureHouses[i]);
+	for (i = 0; i < STRUCTURE_MAX; i++) PoolList_Init(&g_structureTypes[i]);
+}
+
+/**
+ * Move a Structure to the House list for its current House. Call this every
+ *  time the House of the Structure changes.
+ *
+ * @param s The Structure to update.
+ */
+void Structure_UpdateHouseList(Structure *s)
+{
+	uint16 index = s->o.index;
+
+	if (index >= STRUCTURE_INDEX_MAX_SOFT || !s->o.flags.s.used || g_structureHouseList[index] == s->o.houseID) return;
+
+	PoolList_Remove(&g_structureHouses[g_structureHouseList[index]], g_structureHouseLinks, index);
+	g_structureHouseList[index] = s->o.houseID;
+	PoolList_Insert(&g_structureHouses[s->o.houseID], g_structureHouseLinks, g_structureFindPosition, index);
+}
+
 /**
  * Initialize the Structure array.
  *
@@ -90,6 +184,9 @@ void Structure_Init(void)
 	memset(g_structureArray, 0, sizeof(g_structureArray));
 	memset(g_structureFindArray, 0, sizeof(g_structureFindArray));
 	g_structureFindCount = 0;
+	memset(g_structureFree, 0xFF, sizeof(g_structureFree));
+
+	Structure_ClearLists();
 }
 
 /**
@@ -108,10 +205,16 @@ void Structure_Recount(void)
 	}
 
 	g_structureFindCount = 0;
+	memset(g_structureFree, 0xFF, sizeof(g_structureFree));
+
+	Structure_ClearLists();
 
 	for (index = 0; index < STRUCTURE_INDEX_MAX_SOFT; index++) {
 		Structure *s = Structure_Get_ByIndex(index);
-		if (s->o.flags.s.used) g_structureFindArray[g_structureFindCount++] = s;
+		if (!s->o.flags.s.used) continue;
+
+		BitArray_Clear(g_structureFree, index);
+		Structure_AddToFind(s);
 	}
 }
 
@@ -120,9 +223,10 @@ void Structure_Recount(void)
  *
  * @param index The index to use, or STRUCTURE_INDEX_INVALID to find an unused index.
  * @param typeID The type of the new Structure.
+ * @param houseID The House of the new Structure.
  * @return The Structure allocated, or NULL on failure.
  */
-Structure *Structure_Allocate(uint16 index, uint8 type)
+Structure *Structure_Allocate(uint16 index, uint8 type, uint8 houseID)
 {
 	Structure *s = NULL;
 
@@ -145,17 +249,14 @@ Structure *Structure_Allocate(uint16 index, uint8 type)
 		default:
 			if (index == STRUCTURE_INDEX_INVALID) {
 				/* Find the first unused index */
-				for (index = 0; index < STRUCTURE_INDEX_MAX_SOFT; index++) {
-					s = Structure_Get_ByIndex(index);
-					if (!s->o.flags.s.used) break;
-				}
-				if (index == STRUCTURE_INDEX_MAX_SOFT) return NULL;
+				index = BitArray_FindFirst(g_structureFree, 0, STRUCTURE_INDEX_MAX_SOFT - 1);
+				if (index == 0xFFFF) return NULL;
+
+				s = Structure_Get_ByIndex(index);
 			} else {
 				s = Structure_Get_ByIndex(index);
 				if (s->o.flags.s.used) return NULL;
 			}
-
-			g_structureFindArray[g_structureFindCount++] = s;
 			break;
 	}
 	assert(s != NULL);
@@ -164,11 +265,17 @@ Structure *Structure_Allocate(uint16 index, uint8 type)
 	memset(s, 0, sizeof(Structure));
 	s->o.index             = index;
 	s->o.type              = type;
+	s->o.houseID           = houseID;
 	s->o.linkedID          = 0xFF;
 	s->o.flags.s.used      = true;
 	s->o.flags.s.allocated = true;
 	s->o.script.delay = 0;
 
+	if (index < STRUCTURE_INDEX_MAX_SOFT) {
+		BitArray_Clear(g_structureFree, index);
+		Structure_AddToFind(s);
+	}
+
 	return s;
 }
 
@@ -179,7 +286,8 @@ Structure *Structure_Allocate(uint16 index, uint8 type)
  */
 void Structure_Free(Structure *s)
 {
-	int i;
+	uint16 index = s->o.index;
+	uint16 i;
 
 	memset(&s->o.flags, 0, sizeof(s->o.flags));
 
@@ -187,16 +295,19 @@ void Structure_Free(Structure *s)
 
 	if (s->o.type == STRUCTURE_SLAB_1x1 || s->o.type == STRUCTURE_SLAB_2x2 || s->o.type == STRUCTURE_WALL) return;
 
-	/* Walk the array to find the Structure we are removing */
 	assert(g_structureFindCount <= STRUCTURE_INDEX_MAX_SOFT);
-	for (i = 0; i < g_structureFindCount; i++) {
-		if (g_structureFindArray[i] == s) break;
-	}
-	assert(i < g_structureFindCount); /* We should always find an entry */
+	BitArray_Set(g_structureFree, index);
+	i = g_structureFindPosition[index];
+	assert(i < g_structureFindCount && g_structureFindArray[i] == s); /* We should always find an entry */
+
+	PoolList_Remove(&g_structureHouses[g_structureHouseList[index]], g_structureHouseLinks, index);
+	PoolList_Remove(&g_structureTypes[s->o.type], g_structureTypeLinks, index);
 
 	g_structureFindCount--;
 
 	/* If needed, close the gap */
 	if (i == g_structureFindCount) return;
 	memmove(&g_structureFindArray[i], &g_structureFindArray[i + 1], (g_structureFindCount - i) * sizeof(g_structureFindArray[0]));
+
+	for (; i < g_structureFindCount; i++) g_structureFindPosition[g_structureFindArray[i]->o.index] = i;
 }
@@ -21,7 +21,8 @@ extern struct Structure *Structure_Find(struct PoolFindStruct *find);
 
 extern void Structure_Init(void);
 extern void Structure_Recount(void);
-extern struct Structure *Structure_Allocate(uint16 index, uint8 type);
+extern struct Structure *Structure_Allocate(uint16 index, uint8 type, uint8 houseID);
 extern void Structure_Free(struct Structure *s);
+extern void Structure_UpdateHouseList(struct Structure *s);
 
 #endif /* POOL_STRUCTURE_H */
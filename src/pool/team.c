@@ -9,11 +9,15 @@
 
 #include "../house.h"
 #include "pool.h"
+#include "../state.h"
 #include "../team.h"
 
-static struct Team g_teamArray[TEAM_INDEX_MAX];
-static struct Team *g_teamFindArray[TEAM_INDEX_MAX];
-static uint16 g_teamFindCount;
+#define g_teamArray        (g_gameState->teamArray)
+#define g_teamFindArray    (g_gameState->teamFindArray)
+#define g_teamFindCount    (g_gameState->teamFindCount)
+#define g_teamFindPosition (g_gameState->teamFindPosition)
+#define g_teamHouses       (g_gameState->teamHouses)
+#define g_teamHouseLinks   (g_gameState->teamHouseLinks)
 
 /**
  * Get a Team from the pool with the indicated index.
@@ -40,6 +44,26 @@ Team *Team_Find(PoolFindStruct *find)
 	if (find->index >= g_teamFindCount && find->index != 0xFFFF) return NULL;
 	find->index++; /* First, we always go to the next index */
 
+	if (find->houseID < HOUSE_MAX) {
+		Team *prev = (find->index == 0) ? NULL : g_teamFindArray[find->index - 1];
+		uint16 index;
+
+		/* Normally we continue right after the previous result, which is in the list too */
+		if (prev != NULL && prev->houseID == find->houseID) {
+			index = g_teamHouseLinks[prev->index].next;
+		} else {
+			index = PoolList_Find(&g_teamHouses[find->houseID], g_teamHouseLinks, g_teamFindPosition, find->index);
+		}
+
+		if (index == 0xFFFF) {
+			find->index = g_teamFindCount;
+			return NULL;
+		}
+
+		find->index = g_teamFindPosition[index];
+		return &g_teamArray[index];
+	}
+
 	for (; find->index < g_teamFindCount; find->index++) {
 		Team *t = g_teamFindArray[find->index];
 		if (t == NULL) continue;
@@ -50,6 +74,29 @@ Team *Team_Find(PoolFindStruct *find)
 	return NULL;
 }
 
+/**
+ * Add a Team to the end of the find array and to the list of its House.
+ *
+ * @param t The Team to add.
+ */
+static void Team_AddToFind(Team *t)
+{
+	g_teamFindPosition[t->index] = g_teamFindCount;
+	g_teamFindArray[g_teamFindCount++] = t;
+
+	PoolList_Insert(&g_teamHouses[t->houseID], g_teamHouseLinks, g_teamFindPosition, t->index);
+}
+
+/**
+ * Make all Team lists empty.
+ */
+static void Team_ClearLists(void)
+{
+	uint8 i;
+
+	for (i = 0; i < HOUSE_MAX; i++) PoolList_Init(&g_teamHouses[i]);
+}
+
 /**
  * Initialize the Team array.
  *
@@ -60,6 +107,8 @@ void Team_Init(void)
 	memset(g_teamArray, 0, sizeof(g_teamArray));
 	memset(g_teamFindArray, 0, sizeof(g_teamFindArray));
 	g_teamFindCount = 0;
+
+	Team_ClearLists();
 }
 
 /**
@@ -71,9 +120,11 @@ void Team_Recount(void)
 
 	g_teamFindCount = 0;
 
+	Team_ClearLists();
+
 	for (index = 0; index < TEAM_INDEX_MAX; index++) {
 		Team *t = Team_Get_ByIndex(index);
-		if (t->flags.used) g_teamFindArray[g_teamFindCount++] = t;
+		if (t->flags.used) Team_AddToFind(t);
 	}
 }
 
@@ -81,9 +132,10 @@ void Team_Recount(void)
  * Allocate a Team.
  *
  * @param index The index to use, or TEAM_INDEX_INVALID to find an unused index.
+ * @param houseID The House of the new Team.
  * @return The Team allocated, or NULL on failure.
  */
-Team *Team_Allocate(uint16 index)
+Team *Team_Allocate(uint16 index, uint8 houseID)
 {
 	Team *t = NULL;
 
@@ -103,9 +155,10 @@ Team *Team_Allocate(uint16 index)
 	/* Initialize the Team */
 	memset(t, 0, sizeof(Team));
 	t->index      = index;
+	t->houseID    = houseID;
 	t->flags.used = true;
 
-	g_teamFindArray[g_teamFindCount++] = t;
+	Team_AddToFind(t);
 
 	return t;
 }
@@ -117,19 +170,20 @@ Team *Team_Allocate(uint16 index)
  */
 void Team_Free(Team *t)
 {
-	int i;
+	uint16 i;
 
 	memset(&t->flags, 0, sizeof(t->flags));
 
-	/* Walk the array to find the Team we are removing */
-	for (i = 0; i < g_teamFindCount; i++) {
-		if (g_teamFindArray[i] == t) break;
-	}
-	assert(i < g_teamFindCount); /* We should always find an entry */
+	i = g_teamFindPosition[t->index];
+	assert(i < g_teamFindCount && g_teamFindArray[i] == t); /* We should always find an entry */
+
+	PoolList_Remove(&g_teamHouses[t->houseID], g_teamHouseLinks, t->index);
 
 	g_teamFindCount--;
 
 	/* If needed, close the gap */
 	if (i == g_teamFindCount) return;
 	memmove(&g_teamFindArray[i], &g_teamFindArray[i + 1], (g_teamFindCount - i) * sizeof(g_teamFindArray[0]));
+
+	for (; i < g_teamFindCount; i++) g_teamFindPosition[g_teamFindArray[i]->index] = i;
 }
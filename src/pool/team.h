@@ -16,7 +16,7 @@ extern struct Team *Team_Find(struct PoolFindStruct *find);
 
 extern void Team_Init(void);
 extern void Team_Recount(void);
-extern struct Team *Team_Allocate(uint16 index);
+extern struct Team *Team_Allocate(uint16 index, uint8 houseID);
 extern void Team_Free(struct Team *au);
 
 #endif /* POOL_TEAM_H */
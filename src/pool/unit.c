@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "types.h"
+#include "../os/math.h"
 
 #include "unit.h"
 
@@ -12,12 +13,24 @@
 #include "../os/error.h"
 #include "../house.h"
 #include "../opendune.h"
+#include "../state.h"
+#include "../tile.h"
+#include "../tools.h"
 #include "../unit.h"
 
 
-static struct Unit g_unitArray[UNIT_INDEX_MAX];
-struct Unit *g_unitFindArray[UNIT_INDEX_MAX];
-uint16 g_unitFindCount;
+#define g_unitArray        (g_gameState->unitArray)
+#define g_unitFree         (g_gameState->unitFree)
+#define g_unitFindPosition (g_gameState->unitFindPosition)
+#define g_unitHouseList    (g_gameState->unitHouseList)
+#define g_unitHouses       (g_gameState->unitHouses)
+#define g_unitHouseLinks   (g_gameState->unitHouseLinks)
+#define g_unitTypes        (g_gameState->unitTypes)
+#define g_unitTypeLinks    (g_gameState->unitTypeLinks)
+#define g_unitGridHead     (g_gameState->unitGridHead)
+#define g_unitGridNext     (g_gameState->unitGridNext)
+#define g_unitGridPrev     (g_gameState->unitGridPrev)
+#define g_unitGridCell     (g_gameState->unitGridCell)
 
 /**
  * Get a Unit from the pool with the indicated index.
@@ -41,16 +54,56 @@ Unit *Unit_Get_ByIndex(uint16 index)
  */
 Unit *Unit_Find(PoolFindStruct *find)
 {
+	const PoolList *list = NULL;
+	const PoolLink *links = NULL;
+
 	if (find->index >= g_unitFindCount && find->index != 0xFFFF) return NULL;
 	find->index++; /* First, we always go to the next index */
 
+	/* Walk the shortest list of Units that all match part of the filter */
+	if (find->houseID < HOUSE_MAX) {
+		list  = &g_unitHouses[find->houseID];
+		links = g_unitHouseLinks;
+	}
+	if (find->type < UNIT_MAX && (list == NULL || g_unitTypes[find->type].count < list->count)) {
+		list  = &g_unitTypes[find->type];
+		links = g_unitTypeLinks;
+	}
+
+	if (list != NULL) {
+		Unit *prev = (find->index == 0) ? NULL : g_unitFindArray[find->index - 1];
+		uint16 index;
+
+		/* Normally we continue right after the previous result, which is in the list too */
+		if (prev != NULL && (links == g_unitHouseLinks ? g_unitHouseList[prev->o.index] == find->houseID : prev->o.type == find->type)) {
+			index = links[prev->o.index].next;
+		} else {
+			index = PoolList_Find(list, links, g_unitFindPosition, find->index);
+		}
+
+		for (; index != 0xFFFF; index = links[index].next) {
+			if (BitArray_Test(g_unitHotNotOnMap, index) && g_validateStrictIfZero == 0) continue;
+			if (find->houseID != HOUSE_INVALID       && find->houseID != g_unitHouseList[index]) continue;
+			if (find->type    != UNIT_INDEX_INVALID  && find->type    != g_unitHotType[index])  continue;
+
+			find->index = g_unitFindPosition[index];
+			return &g_unitArray[index];
+		}
+
+		find->index = g_unitFindCount;
+		return NULL;
+	}
+
 	for (; find->index < g_unitFindCount; find->index++) {
 		Unit *u = g_unitFindArray[find->index];
+		uint16 index;
+
 		if (u == NULL) continue;
+		index = Unit_Index(u);
 
-		if (u->o.flags.s.isNotOnMap && g_validateStrictIfZero == 0) continue;
-		if (find->houseID != HOUSE_INVALID       && find->houseID != Unit_GetHouseID(u)) continue;
-		if (find->type    != UNIT_INDEX_INVALID  && find->type    != u->o.type)  continue;
+		if (BitArray_Test(g_unitHotNotOnMap, index) && g_validateStrictIfZero == 0) continue;
+		if (find->houseID != HOUSE_INVALID       && find->houseID != g_unitHouseList[index]) continue;
+		if (find->type    != UNIT_INDEX_INVALID  && find->type    != g_unitHotType[index])  continue;
 
 		return u;
 	}
@@ -58,6 +111,236 @@ Unit *Unit_Find(PoolFindStruct *find)
 	return NULL;
 }
 
+/**
+ * Copy the fields scans over all Units look at into the hot arrays. The hot
+ *  arrays are small enough to stay in the cache, where the Units themselves
+ *  (with their ScriptEngine) are not.
+ *
+ * @param u The Unit to copy the fields of.
+ */
+static void Unit_Hot_Update(Unit *u)
+{
+	uint16 index = u->o.index;
+
+	g_unitHotPosition[index] = u->o.position;
+	g_unitHotType[index]     = u->o.type;
+
+	if (!u->o.flags.s.used || u->o.flags.s.isNotOnMap) {
+		BitArray_Set(g_unitHotNotOnMap, index);
+	} else {
+		BitArray_Clear(g_unitHotNotOnMap, index);
+	}
+}
+
+/**
+ * Get the grid cell for a coordinate of a tile32.
+ *
+ * @param coordinate The X or Y coordinate.
+ * @return The cell in that direction; positions outside the map are clamped.
+ */
+static uint16 Unit_Grid_GetCell(uint16 coordinate)
+{
+	return min(coordinate >> UNIT_GRID_CELL_SHIFT, UNIT_GRID_SIZE - 1);
+}
+
+/**
+ * Remove a Unit from the grid cell it is in.
+ *
+ * @param index The index of the Unit.
+ */
+static void Unit_Grid_Remove(uint16 index)
+{
+	uint16 cell = g_unitGridCell[index];
+
+	if (cell == 0xFFFF) return;
+
+	if (g_unitGridPrev[index] == UNIT_INDEX_INVALID) {
+		g_unitGridHead[cell] = g_unitGridNext[index];
+	} else {
+		g_unitGridNext[g_unitGridPrev[index]] = g_unitGridNext[index];
+	}
+	if (g_unitGridNext[index] != UNIT_INDEX_INVALID) g_unitGridPrev[g_unitGridNext[index]] = g_unitGridPrev[index];
+
+	g_unitGridCell[index] = 0xFFFF;
+}
+
+/**
+ * Clear the grid, so no Unit is in any cell.
+ */
+static void Unit_Grid_Clear(void)
+{
+	uint16 i;
+
+	for (i = 0; i < UNIT_GRID_SIZE * UNIT_GRID_SIZE; i++) g_unitGridHead[i] = UNIT_INDEX_INVALID;
+	for (i = 0; i < UNIT_INDEX_MAX; i++) g_unitGridCell[i] = 0xFFFF;
+}
+
+/**
+ * Put a Unit in the grid cell of its current position, or take it out of the
+ *  grid if it is not on the map, and update its hot fields. Call this every
+ *  time a Unit might have moved or left the map.
+ *
+ * @param u The Unit to update.
+ */
+void Unit_Grid_Update(Unit *u)
+{
+	uint16 index;
+	uint16 cell;
+
+	if (u == NULL) return;
+
+	index = u->o.index;
+
+	Unit_Hot_Update(u);
+
+	if (BitArray_Test(g_unitHotNotOnMap, index)) {
+		Unit_Grid_Remove(index);
+		return;
+	}
+
+	cell = Unit_Grid_GetCell(u->o.position.y) * UNIT_GRID_SIZE + Unit_Grid_GetCell(u->o.position.x);
+	if (cell == g_unitGridCell[index]) return;
+
+	Unit_Grid_Remove(index);
+
+	g_unitGridCell[index] = cell;
+	g_unitGridPrev[index] = UNIT_INDEX_INVALID;
+	g_unitGridNext[index] = g_unitGridHead[cell];
+	if (g_unitGridHead[cell] != UNIT_INDEX_INVALID) g_unitGridPrev[g_unitGridHead[cell]] = index;
+	g_unitGridHead[cell] = index;
+}
+
+/**
+ * Find all Units within a distance of a position. Only the grid cells
+ *  around the position are visited. Like Unit_Find, Units that are not on the
+ *  map are skipped.
+ *
+ * @param position The position to search around.
+ * @param distance The maximum distance (as in Tile_GetDistance) to the Units.
+ * @param units An array of at least UNIT_INDEX_MAX entries to store the Units in, sorted on index.
+ * @return The amount of Units found.
+ */
+uint16 Unit_FindInRange(tile32 position, uint16 distance, Unit **units)
+{
+	uint16 count = 0;
+	uint16 left, top, right, bottom;
+	uint16 x, y;
+	uint16 i;
+
+	/* When validating, Unit_Find also returns Units not on the map, which are not in the grid */
+	if (g_validateStrictIfZero != 0) {
+		PoolFindStruct find;
+
+		find.houseID = HOUSE_INVALID;
+		find.type    = 0xFFFF;
+		find.index   = 0xFFFF;
+
+		while (true) {
+			Unit *u = Unit_Find(&find);
+			if (u == NULL) break;
+			if (Tile_GetDistance(position, u->o.position) > distance) continue;
+			units[count++] = u;
+		}
+	} else {
+		left   = Unit_Grid_GetCell(position.x < distance ? 0 : position.x - distance);
+		top    = Unit_Grid_GetCell(position.y < distance ? 0 : position.y - distance);
+		right  = Unit_Grid_GetCell(min((uint32)position.x + distance, 0xFFFF));
+		bottom = Unit_Grid_GetCell(min((uint32)position.y + distance, 0xFFFF));
+
+		for (y = top; y <= bottom; y++) {
+			for (x = left; x <= right; x++) {
+				uint16 index;
+
+				for (index = g_unitGridHead[y * UNIT_GRID_SIZE + x]; index != UNIT_INDEX_INVALID; index = g_unitGridNext[index]) {
+					if (BitArray_Test(g_unitHotNotOnMap, index)) continue;
+					if (Tile_GetDistance(position, g_unitHotPosition[index]) > distance) continue;
+
+					units[count++] = &g_unitArray[index];
+				}
+			}
+		}
+	}
+
+	/* Sort on index, so the order doesn't depend on how Units moved between cells */
+	for (i = 1; i < count; i++) {
+		Unit *u = units[i];
+		uint16 j;
+
+		for (j = i; j > 0 && Unit_Index(units[j - 1]) > Unit_Index(u); j--) units[j] = units[j - 1];
+		units[j] = u;
+	}
+
+	return count;
+}
+
+/**
+ * Add a Unit to the end of the find array and to the lists it belongs in.
+ *
+ * @param u The Unit to add.
+ */
+static void Unit_AddToFind(Unit *u)
+{
+	uint16 index = u->o.index;
+
+	g_unitFindPosition[index] = g_unitFindCount;
+	g_unitFindArray[g_unitFindCount++] = u;
+
+	g_unitHouseList[index] = Unit_GetHouseID(u);
+	PoolList_Insert(&g_unitHouses[g_unitHouseList[index]], g_unitHouseLinks, g_unitFindPosition, index);
+	PoolList_Insert(&g_unitTypes[u->o.type], g_unitTypeLinks, g_unitFindPosition, index);
+}
+
+/**
+ * Make all Unit lists empty.
+ */
+static void Unit_ClearLists(void)
+{
+	uint8 i;
+
+	for (i = 0; i < HOUSE_MAX; i++) PoolList_Init(&g_unitHouses[i]);
+	for (i = 0; i < UNIT_MAX; i++) PoolList_Init(&g_unitTypes[i]);
+}
+
+/**
+ * Move a Unit to the House list for its current House. Call this every time
+ *  the result of Unit_GetHouseID for the Unit might have changed.
+ *
+ * @param u The Unit to update.
+ */
+void Unit_UpdateHouseList(Unit *u)
+{
+	uint16 index = u->o.index;
+	uint8 houseID = Unit_GetHouseID(u);
+
+	if (!u->o.flags.s.used || g_unitHouseList[index] == houseID) return;
+
+	PoolList_Remove(&g_unitHouses[g_unitHouseList[index]], g_unitHouseLinks, index);
+	g_unitHouseList[index] = houseID;
+	PoolList_Insert(&g_unitHouses[houseID], g_unitHouseLinks, g_unitFindPosition, index);
+}
+
+/**
+ * Swap a Unit in the find array with the one after it.
+ *
+ * @param position The position in the find array of the first Unit.
+ */
+void Unit_SwapFindOrder(uint16 position)
+{
+	Unit *u1 = g_unitFindArray[position];
+	Unit *u2 = g_unitFindArray[position + 1];
+	uint16 index1 = Unit_Index(u1);
+	uint16 index2 = Unit_Index(u2);
+
+	g_unitFindArray[position]     = u2;
+	g_unitFindArray[position + 1] = u1;
+	g_unitFindPosition[index1] = position + 1;
+	g_unitFindPosition[index2] = position;
+
+	/* Units next to each other in the find array are also next to each other in a list they share */
+	if (g_unitHouseList[index1] == g_unitHouseList[index2]) PoolList_Swap(&g_unitHouses[g_unitHouseList[index1]], g_unitHouseLinks, index1);
+	if (g_unitHotType[index1] == g_unitHotType[index2]) PoolList_Swap(&g_unitTypes[g_unitHotType[index1]], g_unitTypeLinks, index1);
+}
+
 /**
  * Initialize the Unit array.
  */
@@ -66,6 +349,11 @@ void Unit_Init(void)
 	memset(g_unitArray, 0, sizeof(g_unitArray));
 	memset(g_unitFindArray, 0, sizeof(g_unitFindArray));
 	g_unitFindCount = 0;
+	memset(g_unitFree, 0xFF, sizeof(g_unitFree));
+	memset(g_unitHotNotOnMap, 0xFF, sizeof(g_unitHotNotOnMap));
+
+	Unit_ClearLists();
+	Unit_Grid_Clear();
 }
 
 /**
@@ -84,15 +372,24 @@ void Unit_Recount(void)
 	}
 
 	g_unitFindCount = 0;
+	memset(g_unitFree, 0xFF, sizeof(g_unitFree));
+	memset(g_unitHotNotOnMap, 0xFF, sizeof(g_unitHotNotOnMap));
+
+	Unit_ClearLists();
+	Unit_Grid_Clear();
 
 	for (index = 0; index < UNIT_INDEX_MAX; index++) {
 		Unit *u = Unit_Get_ByIndex(index);
 		if (!u->o.flags.s.used) continue;
 
+		BitArray_Clear(g_unitFree, index);
+
 		h = House_Get_ByIndex(u->o.houseID);
 		h->unitCount++;
 
-		g_unitFindArray[g_unitFindCount++] = u;
+		Unit_AddToFind(u);
+
+		Unit_Grid_Update(u);
 	}
 }
 
@@ -119,14 +416,11 @@ Unit *Unit_Allocate(uint16 index, uint8 type, uint8 houseID)
 	}
 
 	if (index == 0 || index == UNIT_INDEX_INVALID) {
-		uint16 indexStart = g_table_unitInfo[type].indexStart;
-		uint16 indexEnd   = g_table_unitInfo[type].indexEnd;
+		/* Take the lowest unused index in the range of this type */
+		index = BitArray_FindFirst(g_unitFree, g_table_unitInfo[type].indexStart, g_table_unitInfo[type].indexEnd);
+		if (index == 0xFFFF) return NULL;
 
-		for (index = indexStart; index <= indexEnd; index++) {
-			u = Unit_Get_ByIndex(index);
-			if (!u->o.flags.s.used) break;
-		}
-		if (index > indexEnd) return NULL;
+		u = Unit_Get_ByIndex(index);
 	} else {
 		u = Unit_Get_ByIndex(index);
 		if (u->o.flags.s.used) return NULL;
@@ -134,6 +428,7 @@ Unit *Unit_Allocate(uint16 index, uint8 type, uint8 houseID)
 	assert(u != NULL);
 
 	h->unitCount++;
+	BitArray_Clear(g_unitFree, index);
 
 	/* Initialize the Unit */
 	memset(u, 0, sizeof(Unit));
@@ -148,7 +443,8 @@ Unit *Unit_Allocate(uint16 index, uint8 type, uint8 houseID)
 	u->route[0]            = 0xFF;
 	if (type == UNIT_SANDWORM) u->amount = 3;
 
-	g_unitFindArray[g_unitFindCount++] = u;
+	Unit_Hot_Update(u);
+	Unit_AddToFind(u);
 
 	return u;
 }
@@ -160,17 +456,22 @@ Unit *Unit_Allocate(uint16 index, uint8 type, uint8 houseID)
  */
 void Unit_Free(Unit *u)
 {
-	int i;
+	uint16 index = u->o.index;
+	uint16 i;
 
 	memset(&u->o.flags, 0, sizeof(u->o.flags));
 
 	Script_Reset(&u->o.script, g_scriptUnit);
 
-	/* Walk the array to find the Unit we are removing */
-	for (i = 0; i < g_unitFindCount; i++) {
-		if (g_unitFindArray[i] == u) break;
-	}
-	assert(i < g_unitFindCount); /* We should always find an entry */
+	Unit_Grid_Remove(index);
+	BitArray_Set(g_unitFree, index);
+	BitArray_Set(g_unitHotNotOnMap, index);
+
+	i = g_unitFindPosition[index];
+	assert(i < g_unitFindCount && g_unitFindArray[i] == u); /* We should always find an entry */
+
+	PoolList_Remove(&g_unitHouses[g_unitHouseList[index]], g_unitHouseLinks, index);
+	PoolList_Remove(&g_unitTypes[u->o.type], g_unitTypeLinks, index);
 
 	g_unitFindCount--;
 
@@ -182,4 +483,6 @@ void Unit_Free(Unit *u)
 	/* If needed, close the gap */
 	if (i == g_unitFindCount) return;
 	memmove(&g_unitFindArray[i], &g_unitFindArray[i + 1], (g_unitFindCount - i) * sizeof(g_unitFindArray[0]));
+
+	for (; i < g_unitFindCount; i++) g_unitFindPosition[g_unitFindArray[i]->o.index] = i;
 }
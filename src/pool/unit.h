@@ -9,17 +9,23 @@ enum {
 	UNIT_INDEX_INVALID = 0xFFFF
 };
 
-struct PoolFindStruct;
+enum {
+	UNIT_GRID_CELL_SHIFT = 10,                              /*!< Shift to get from a tile32 coordinate to a grid cell; a cell is 4x4 tiles. */
+	UNIT_GRID_SIZE = 16                                     /*!< The amount of grid cells in each direction. */
+};
 
-extern struct Unit *g_unitFindArray[UNIT_INDEX_MAX];
-extern uint16 g_unitFindCount;
+struct PoolFindStruct;
 
 extern struct Unit *Unit_Get_ByIndex(uint16 index);
 extern struct Unit *Unit_Find(struct PoolFindStruct *find);
+extern uint16 Unit_FindInRange(tile32 position, uint16 distance, struct Unit **units);
 
 extern void Unit_Init(void);
 extern void Unit_Recount(void);
 extern struct Unit *Unit_Allocate(uint16 index, uint8 type, uint8 houseID);
 extern void Unit_Free(struct Unit *u);
+extern void Unit_UpdateHouseList(struct Unit *u);
+extern void Unit_SwapFindOrder(uint16 position);
+extern void Unit_Grid_Update(struct Unit *u);
 
 #endif /* POOL_UNIT_H */
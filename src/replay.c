@@ -0,0 +1,273 @@
+/** @file src/replay.c Replay routines. */
+
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+#include "os/endian.h"
+#include "os/error.h"
+
+#include "replay.h"
+
+#include "opendune.h"
+#include "saveload/saveload.h"
+#include "state.h"
+
+static FILE  *s_replayFile     = NULL;                      /*!< The file the hashes are written to or compared with. */
+static bool   s_replayVerify   = false;                     /*!< True if the hashes are compared with the file, false if they are written to it. */
+static bool   s_replayDiverged = false;                     /*!< True if a tick had another hash than in the file. */
+static uint32 s_replayHash     = 0;                         /*!< The hash over all ticks so far. */
+static uint32 s_replayTicks    = 0;                         /*!< The amount of ticks written or compared. */
+
+/**
+ * Add data to a hash (FNV-1a).
+ *
+ * @param hash The hash so far.
+ * @param data The data to add.
+ * @param length The length of the data.
+ * @return The new hash.
+ */
+static uint32 Replay_Hash(uint32 hash, const void *data, uint32 length)
+{
+	const uint8 *d = (const uint8 *)data;
+
+	while (length-- != 0) {
+		hash ^= *d++;
+		hash *= 16777619;
+	}
+
+	return hash;
+}
+
+/**
+ * Add an object to a hash, serialised the way it is in a savegame. This
+ *  doesn't depend on the padding or layout of the struct in memory, nor on
+ *  the address the scripts are loaded at.
+ *
+ * @param hash The hash so far.
+ * @param sld The description of the object.
+ * @param object The object.
+ * @return The new hash.
+ */
+static uint32 Replay_HashObject(uint32 hash, const SaveLoadDesc *sld, void *object)
+{
+	uint8 buffer[SAVELOAD_BUFFER_SIZE];
+	uint32 length = SaveLoad_GetLength(sld);
+
+	if (!SaveLoad_SaveToBuffer(sld, buffer, sizeof(buffer), object)) return hash;
+
+	return Replay_Hash(hash, buffer, length);
+}
+
+/**
+ * Hash the state of the game, as it would be in a savegame: the game info,
+ *  the map, the House, Unit, Structure and Team pools, and the state of the
+ *  random generators.
+ *
+ * @param hash The hash to continue from.
+ * @return The new hash.
+ */
+uint32 Replay_HashState(uint32 hash)
+{
+	uint8 buffer[4];
+	uint16 i;
+
+	/* Like the savegame, include the Units and Structures which are not on the map */
+	g_validateStrictIfZero++;
+
+	hash = Replay_HashObject(hash, g_saveInfo, g_gameState);
+
+	for (i = 0; i < 64 * 64; i++) {
+		Map_SaveTile(&g_map[i], buffer);
+		hash = Replay_Hash(hash, buffer, sizeof(buffer));
+	}
+
+	for (i = 0; i < HOUSE_INDEX_MAX; i++) {
+		House *h = House_Get_ByIndex((uint8)i);
+
+		if (!h->flags.used) continue;
+
+		hash = Replay_HashObject(hash, g_saveHouse, h);
+	}
+
+	for (i = 0; i < UNIT_INDEX_MAX; i++) {
+		Unit *u = Unit_Get_ByIndex(i);
+
+		if (!u->o.flags.s.used) continue;
+
+		hash = Replay_HashObject(hash, g_saveUnit, u);
+		hash = Replay_HashObject(hash, g_saveUnitNew, u);
+	}
+
+	for (i = 0; i < STRUCTURE_INDEX_MAX_HARD; i++) {
+		Structure *s = Structure_Get_ByIndex(i);
+
+		if (!s->o.flags.s.used) continue;
+
+		hash = Replay_HashObject(hash, g_saveStructure, s);
+	}
+
+	for (i = 0; i < TEAM_INDEX_MAX; i++) {
+		Team *t = Team_Get_ByIndex(i);
+
+		if (!t->flags.used) continue;
+
+		hash = Replay_HashObject(hash, g_saveTeam, t);
+	}
+
+	g_validateStrictIfZero--;
+
+	/* The random generators are not in a savegame */
+	hash = Replay_Hash(hash, g_gameState->randomSeed, sizeof(g_gameState->randomSeed));
+	WRITE_LE_UINT32(buffer, g_gameState->randomLCG);
+	hash = Replay_Hash(hash, buffer, sizeof(buffer));
+
+	return hash;
+}
+
+/**
+ * Start recording the hash of every tick to a file.
+ *
+ * @param filename The file to write to.
+ * @param houseID The House the scenario is played as.
+ * @param scenarioID The Scenario being played.
+ * @param seed The seed for the random generators.
+ * @param input The input log played back during the game, or an empty string if none.
+ * @return True if and only if the file could be created.
+ */
+bool Replay_Record(const char *filename, uint8 houseID, uint16 scenarioID, uint32 seed, const char *input)
+{
+	s_replayFile = fopen(filename, "w");
+	if (s_replayFile == NULL) {
+		Error("Failed to open replay file '%s' for writing\n", filename);
+		return false;
+	}
+
+	fprintf(s_replayFile, "house=%u scenario=%u seed=%lu", houseID, scenarioID, (unsigned long)seed);
+	if (input[0] != '\0') fprintf(s_replayFile, " input=%s", input);
+	fprintf(s_replayFile, "\n");
+
+	s_replayVerify   = false;
+	s_replayDiverged = false;
+	s_replayHash     = 2166136261U;
+	s_replayTicks    = 0;
+
+	return true;
+}
+
+/**
+ * Start comparing the hash of every tick with a file made by Replay_Record.
+ *
+ * @param filename The file to read from.
+ * @param houseID Is set to the House the scenario was played as.
+ * @param scenarioID Is set to the Scenario that was played.
+ * @param seed Is set to the seed for the random generators.
+ * @param input Is set to the input log played back during the game, or an empty string if there was none.
+ * @param inputLength The size of input.
+ * @return True if and only if the file could be read.
+ */
+bool Replay_Verify(const char *filename, uint8 *houseID, uint16 *scenarioID, uint32 *seed, char *input, size_t inputLength)
+{
+	unsigned int house;
+	unsigned int scenario;
+	unsigned long s;
+	char line[512];
+
+	s_replayFile = fopen(filename, "r");
+	if (s_replayFile == NULL) {
+		Error("Failed to open replay file '%s' for reading\n", filename);
+		return false;
+	}
+
+	if (fscanf(s_replayFile, "house=%u scenario=%u seed=%lu", &house, &scenario, &s) != 3) {
+		Error("Replay file '%s' is invalid\n", filename);
+		fclose(s_replayFile);
+		s_replayFile = NULL;
+		return false;
+	}
+
+	*houseID    = (uint8)house;
+	*scenarioID = (uint16)scenario;
+	*seed       = (uint32)s;
+
+	/* The input log is optional, and is the rest of the line, as its name can contain spaces */
+	input[0] = '\0';
+	if (fgets(line, sizeof(line), s_replayFile) != NULL && strncmp(line, " input=", 7) == 0) {
+		size_t length = strcspn(line + 7, "\r\n");
+
+		if (length > inputLength - 1) length = inputLength - 1;
+		memcpy(input, line + 7, length);
+		input[length] = '\0';
+	}
+
+	s_replayVerify   = true;
+	s_replayDiverged = false;
+	s_replayHash     = 2166136261U;
+	s_replayTicks    = 0;
+
+	return true;
+}
+
+/**
+ * Hash the state of the game after a tick, and write it to or compare it
+ *  with the replay file.
+ *
+ * @param tick The tick that was just simulated.
+ * @return False if the game should stop: it diverged from the replay file, or the file has no more ticks.
+ */
+bool Replay_Tick(uint32 tick)
+{
+	unsigned long refTick;
+	unsigned long refHash;
+
+	if (s_replayFile == NULL) return true;
+
+	s_replayHash = Replay_HashState(s_replayHash);
+
+	if (!s_replayVerify) {
+		fprintf(s_replayFile, "%lu %08lX\n", (unsigned long)tick, (unsigned long)s_replayHash);
+		s_replayTicks++;
+		return true;
+	}
+
+	if (fscanf(s_replayFile, "%lu %lX", &refTick, &refHash) != 2) {
+		printf("replay: first divergence at tick %lu: the replay ended, but the game continues\n", (unsigned long)tick);
+		s_replayDiverged = true;
+		return false;
+	}
+
+	s_replayTicks++;
+
+	if (refTick == tick && (uint32)refHash == s_replayHash) return true;
+
+	printf("replay: first divergence at tick %lu: expected %08lX, got %08lX\n", (unsigned long)tick, refHash, (unsigned long)s_replayHash);
+	s_replayDiverged = true;
+
+	return false;
+}
+
+/**
+ * Stop recording or comparing, and report the result of a comparison.
+ *
+ * @return False if the game diverged from the replay file.
+ */
+bool Replay_Close(void)
+{
+	unsigned long refTick;
+	unsigned long refHash;
+
+	if (s_replayFile == NULL) return true;
+
+	if (s_replayVerify && !s_replayDiverged) {
+		if (fscanf(s_replayFile, "%lu %lX", &refTick, &refHash) == 2) {
+			printf("replay: first divergence at tick %lu: the game ended, but the replay continues\n", refTick);
+			s_replayDiverged = true;
+		} else {
+			printf("replay: all %lu ticks match\n", (unsigned long)s_replayTicks);
+		}
+	}
+
+	fclose(s_replayFile);
+	s_replayFile = NULL;
+
+	return !s_replayDiverged;
+}
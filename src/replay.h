@@ -0,0 +1,12 @@
+/** @file src/replay.h Replay definitions. */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+extern uint32 Replay_HashState(uint32 hash);
+extern bool Replay_Record(const char *filename, uint8 houseID, uint16 scenarioID, uint32 seed, const char *input);
+extern bool Replay_Verify(const char *filename, uint8 *houseID, uint16 *scenarioID, uint32 *seed, char *input, size_t inputLength);
+extern bool Replay_Tick(uint32 tick);
+extern bool Replay_Close(void);
+
+#endif /* REPLAY_H */
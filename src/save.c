@@ -18,6 +18,7 @@
 #include "pool/unit.h"
 #include "saveload/saveload.h"
 #include "sprites.h"
+#include "state.h"
 #include "structure.h"
 #include "team.h"
 #include "unit.h"
@@ -68,9 +69,10 @@ static bool Save_Chunk(FILE *fp, const char *header, bool (*saveProc)(FILE *fp))
  *
  * @param fp The file to save to.
  * @param description The description of the savegame.
+ * @param infoSave The proc to call to generate the content of the INFO chunk.
  * @return True if and only if all bytes were written successful.
  */
-static bool Save_Main(FILE *fp, char *description)
+static bool Save_Main(FILE *fp, const char *description, bool (*infoSave)(FILE *fp))
 {
 	uint32 length;
 	uint32 lengthSwapped;
@@ -97,7 +99,7 @@ static bool Save_Main(FILE *fp, char *description)
 	}
 
 	/* Store all additional chunks */
-	if (!Save_Chunk(fp, "INFO", &Info_Save)) return false;
+	if (!Save_Chunk(fp, "INFO", infoSave)) return false;
 	if (!Save_Chunk(fp, "PLYR", &House_Save)) return false;
 	if (!Save_Chunk(fp, "UNIT", &Unit_Save)) return false;
 	if (!Save_Chunk(fp, "BLDG", &Structure_Save)) return false;
@@ -115,17 +117,54 @@ static bool Save_Main(FILE *fp, char *description)
 }
 
 /**
- * Save the game to a filename
+ * Write the active GameState to a savegame. Unlike SaveGame_SaveFile() it
+ *  never changes the GameState, so it can be used from another thread on a
+ *  snapshot.
  *
- * @param fp The filename of the savegame.
+ * @param filename The filename of the savegame.
  * @param description The description of the savegame.
+ * @param infoSave The proc to call to generate the content of the INFO chunk.
  * @return True if and only if all bytes were written successful.
  */
-bool SaveGame_SaveFile(char *filename, char *description)
+bool SaveGame_Write(const char *filename, const char *description, bool (*infoSave)(FILE *fp))
 {
 	FILE *fp;
 	bool res;
 
+	fp = fopendatadir(SEARCHDIR_PERSONAL_DATA_DIR, filename, "wb");
+	if (fp == NULL) {
+		Error("Failed to open file '%s' for writing.\n", filename);
+		return false;
+	}
+
+	/* A savegame is a few tens of KiB; buffer it so it is written in a few large blocks */
+	setvbuf(fp, NULL, _IOFBF, 0x10000);
+
+	g_validateStrictIfZero++;
+	res = Save_Main(fp, description, infoSave);
+	g_validateStrictIfZero--;
+
+	fclose(fp);
+
+	if (!res) {
+		/* TODO -- Also remove the savegame now */
+
+		Error("Error while writing savegame.\n");
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Save the game to a filename
+ *
+ * @param fp The filename of the savegame.
+ * @param description The description of the savegame.
+ * @return True if and only if all bytes were written successful.
+ */
+bool SaveGame_SaveFile(char *filename, char *description)
+{
 	/* In debug-scenario mode, the whole map is uncovered. Cover it now in
 	 *  the savegame based on the current position of the units and
 	 *  structures. */
@@ -170,24 +209,5 @@ bool SaveGame_SaveFile(char *filename, char *description)
 		}
 	}
 
-	fp = fopendatadir(SEARCHDIR_PERSONAL_DATA_DIR, filename, "wb");
-	if (fp == NULL) {
-		Error("Failed to open file '%s' for writing.\n", filename);
-		return false;
-	}
-
-	g_validateStrictIfZero++;
-	res = Save_Main(fp, description);
-	g_validateStrictIfZero--;
-
-	fclose(fp);
-
-	if (!res) {
-		/* TODO -- Also remove the savegame now */
-
-		Error("Error while writing savegame.\n");
-		return false;
-	}
-
-	return true;
+	return SaveGame_Write(filename, description, &Info_Save);
 }
@@ -4,5 +4,6 @@
 #define SAVE_H
 
 extern bool SaveGame_SaveFile(char *filename, char *description);
+extern bool SaveGame_Write(const char *filename, const char *description, bool (*infoSave)(FILE *fp));
 
 #endif /* SAVE_H */
@@ -8,8 +8,9 @@
 #include "../house.h"
 #include "../pool/house.h"
 #include "../pool/pool.h"
+#include "../state.h"
 
-static const SaveLoadDesc s_saveHouse[] = {
+const SaveLoadDesc g_saveHouse[] = {
 	SLD_ENTRY2(House, SLDT_UINT16, index,           SLDT_UINT8),
 	SLD_ENTRY (House, SLDT_UINT16, harvestersIncoming),
 	SLD_ENTRY2(House, SLDT_UINT16, flags,           SLDT_HOUSEFLAGS),
@@ -51,9 +52,9 @@ bool House_Load(FILE *fp, uint32 length)
 		memset(&hl, 0, sizeof(hl));
 
 		/* Read the next House from disk */
-		if (!SaveLoad_Load(s_saveHouse, fp, &hl)) return false;
+		if (!SaveLoad_Load(g_saveHouse, fp, &hl)) return false;
 
-		length -= SaveLoad_GetLength(s_saveHouse);
+		length -= SaveLoad_GetLength(g_saveHouse);
 
 		/* Create the House in the pool */
 		h = House_Allocate(hl.index);
@@ -87,7 +88,7 @@ bool House_LoadOld(FILE *fp, uint32 length)
 		House hl;
 
 		/* Read the next House from disk */
-		if (!SaveLoad_Load(s_saveHouse, fp, &hl)) return false;
+		if (!SaveLoad_Load(g_saveHouse, fp, &hl)) return false;
 
 		/* See if it is a human house */
 		if (hl.flags.human) {
@@ -95,7 +96,7 @@ bool House_LoadOld(FILE *fp, uint32 length)
 			break;
 		}
 
-		length -= SaveLoad_GetLength(s_saveHouse);
+		length -= SaveLoad_GetLength(g_saveHouse);
 	}
 	if (length == 0) return false;
 
@@ -121,7 +122,7 @@ bool House_Save(FILE *fp)
 		h = House_Find(&find);
 		if (h == NULL) break;
 
-		if (!SaveLoad_Save(s_saveHouse, fp, h)) return false;
+		if (!SaveLoad_Save(g_saveHouse, fp, h)) return false;
 	}
 
 	return true;
@@ -11,6 +11,7 @@
 #include "../pool/unit.h"
 #include "../scenario.h"
 #include "../sprites.h"
+#include "../state.h"
 #include "../structure.h"
 #include "../timer.h"
 #include "../unit.h"
@@ -121,36 +122,39 @@ static uint32 SaveLoad_UnitHouseMissile(void *object, uint32 value, bool loading
 	}
 }
 
-static const SaveLoadDesc s_saveInfo[] = {
-	SLD_GSLD   (g_scenario,  g_saveScenario),
-	SLD_GENTRY (SLDT_UINT16, g_playerCreditsNoSilo),
+static uint8  s_infoCaptured[512];                          /*!< The INFO chunk as captured by Info_Capture(). */
+static uint32 s_infoCapturedLength = 0;                     /*!< The length of the captured INFO chunk. */
+
+const SaveLoadDesc g_saveInfo[] = {
+	SLD_SLD    (GameState, scenario, g_saveScenario),
+	SLD_ENTRY  (GameState, SLDT_UINT16, playerCreditsNoSilo),
 	SLD_GENTRY (SLDT_UINT16, g_minimapPosition),
 	SLD_GENTRY (SLDT_UINT16, g_selectionRectanglePosition),
-	SLD_GCALLB (SLDT_INT8,   g_selectionType, &SaveLoad_SelectionType),
-	SLD_GENTRY2(SLDT_INT8,   g_structureActiveType, SLDT_UINT16),
+	SLD_CALLB  (GameState, SLDT_INT8,   selectionType, &SaveLoad_SelectionType),
+	SLD_ENTRY2 (GameState, SLDT_INT8,   structureActiveType, SLDT_UINT16),
 	SLD_GENTRY (SLDT_UINT16, g_structureActivePosition),
-	SLD_GCALLB (SLDT_UINT16, g_structureActive, &SaveLoad_StructureActive),
-	SLD_GCALLB (SLDT_UINT16, g_unitSelected, &SaveLoad_UnitSelected),
-	SLD_GCALLB (SLDT_UINT16, g_unitActive, &SaveLoad_UnitActive),
-	SLD_GENTRY (SLDT_UINT16, g_activeAction),
+	SLD_CALLB  (GameState, SLDT_UINT16, structureActive, &SaveLoad_StructureActive),
+	SLD_CALLB  (GameState, SLDT_UINT16, unitSelected, &SaveLoad_UnitSelected),
+	SLD_CALLB  (GameState, SLDT_UINT16, unitActive, &SaveLoad_UnitActive),
+	SLD_ENTRY  (GameState, SLDT_UINT16, activeAction),
 	SLD_GENTRY (SLDT_UINT32, g_strategicRegionBits),
-	SLD_GENTRY (SLDT_UINT16, g_scenarioID),
-	SLD_GENTRY (SLDT_UINT16, g_campaignID),
-	SLD_GENTRY (SLDT_UINT32, g_hintsShown1),
-	SLD_GENTRY (SLDT_UINT32, g_hintsShown2),
-	SLD_GCALLB (SLDT_UINT32, g_tickScenarioStart, &SaveLoad_TickScenarioStart),
-	SLD_GENTRY (SLDT_UINT16, g_playerCreditsNoSilo),
-	SLD_GARRAY (SLDT_INT16,  g_starportAvailable, UNIT_MAX),
-	SLD_GENTRY (SLDT_UINT16, g_houseMissileCountdown),
-	SLD_GCALLB (SLDT_UINT16, g_unitHouseMissile, &SaveLoad_UnitHouseMissile),
-	SLD_GENTRY (SLDT_UINT16, g_structureIndex),
+	SLD_ENTRY  (GameState, SLDT_UINT16, scenarioID),
+	SLD_ENTRY  (GameState, SLDT_UINT16, campaignID),
+	SLD_ENTRY  (GameState, SLDT_UINT32, hintsShown1),
+	SLD_ENTRY  (GameState, SLDT_UINT32, hintsShown2),
+	SLD_CALLB  (GameState, SLDT_UINT32, tickScenarioStart, &SaveLoad_TickScenarioStart),
+	SLD_ENTRY  (GameState, SLDT_UINT16, playerCreditsNoSilo),
+	SLD_ARRAY  (GameState, SLDT_INT16,  starportAvailable, UNIT_MAX),
+	SLD_ENTRY  (GameState, SLDT_UINT16, houseMissileCountdown),
+	SLD_CALLB  (GameState, SLDT_UINT16, unitHouseMissile, &SaveLoad_UnitHouseMissile),
+	SLD_ENTRY  (GameState, SLDT_UINT16, structureIndex),
 	SLD_END
 };
 
-static const SaveLoadDesc s_saveInfoOld[] = {
+const SaveLoadDesc g_saveInfoOld[] = {
 	SLD_EMPTY2(SLDT_UINT8,  250),
-	SLD_GENTRY(SLDT_UINT16, g_scenarioID),
-	SLD_GENTRY(SLDT_UINT16, g_campaignID),
+	SLD_ENTRY(GameState, SLDT_UINT16, scenarioID),
+	SLD_ENTRY(GameState, SLDT_UINT16, campaignID),
 	SLD_END
 };
 
@@ -162,8 +166,8 @@ static const SaveLoadDesc s_saveInfoOld[] = {
  */
 bool Info_Load(FILE *fp, uint32 length)
 {
-	if (SaveLoad_GetLength(s_saveInfo) != length) return false;
-	if (!SaveLoad_Load(s_saveInfo, fp, NULL)) return false;
+	if (SaveLoad_GetLength(g_saveInfo) != length) return false;
+	if (!SaveLoad_Load(g_saveInfo, fp, g_gameState)) return false;
 
 	g_viewportPosition = g_minimapPosition;
 	g_selectionPosition = g_selectionRectanglePosition;
@@ -185,7 +189,7 @@ bool Info_LoadOld(FILE *fp, uint32 length)
 {
 	VARIABLE_NOT_USED(length);
 
-	if (!SaveLoad_Load(s_saveInfoOld, fp, NULL)) return false;
+	if (!SaveLoad_Load(g_saveInfoOld, fp, g_gameState)) return false;
 
 	return true;
 }
@@ -201,7 +205,42 @@ bool Info_Save(FILE *fp)
 
 	if (!fwrite_le_uint16(savegameVersion, fp)) return false;
 
-	if (!SaveLoad_Save(s_saveInfo, fp, NULL)) return false;
+	if (!SaveLoad_Save(g_saveInfo, fp, g_gameState)) return false;
+
+	return true;
+}
+
+/**
+ * Capture the info for the savegame in memory. Part of it (the selection, the
+ *  viewport, ..) is not in the GameState, so this has to be done on the game
+ *  thread, while the rest of the savegame can be written from a snapshot.
+ * @return True if and only if the info fits in the buffer.
+ */
+bool Info_Capture(void)
+{
+	s_infoCapturedLength = 0;
+
+	if (!SaveLoad_SaveToBuffer(g_saveInfo, s_infoCaptured, sizeof(s_infoCaptured), g_gameState)) return false;
+
+	s_infoCapturedLength = SaveLoad_GetLength(g_saveInfo);
+
+	return true;
+}
+
+/**
+ * Save the info captured by Info_Capture() to the savegame.
+ * @param fp The file to save to.
+ * @return True if and only if all bytes were written successful.
+ */
+bool Info_SaveCaptured(FILE *fp)
+{
+	static uint16 savegameVersion = 0x0290;
+
+	if (s_infoCapturedLength == 0) return false;
+
+	if (!fwrite_le_uint16(savegameVersion, fp)) return false;
+
+	if (fwrite(s_infoCaptured, s_infoCapturedLength, 1, fp) != 1) return false;
 
 	return true;
 }
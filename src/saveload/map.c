@@ -6,6 +6,7 @@
 #include "../file.h"
 #include "../map.h"
 #include "../sprites.h"
+#include "../state.h"
 
 /**
  * Load a Tile structure to a file (Little endian)
@@ -30,6 +31,20 @@ static bool fread_tile(Tile *t, FILE *fp)
 	return true;
 }
 
+/**
+ * Save a Tile structure to a buffer, the way it is stored on disk.
+ *
+ * @param t The tile to save
+ * @param buffer The buffer to write the 4 bytes to
+ */
+void Map_SaveTile(const Tile *t, uint8 *buffer)
+{
+	buffer[0] = t->groundTileID & 0xff;
+	buffer[1] = (t->groundTileID >> 8) | (t->overlayTileID << 1);
+	buffer[2] = t->houseID | (t->isUnveiled << 3) | (t->hasUnit << 4) | (t->hasStructure << 5) | (t->hasAnimation << 6) | (t->hasExplosion << 7);
+	buffer[3] = t->index;
+}
+
 /**
  * Save a Tile structure to a file (Little endian)
  *
@@ -40,10 +55,7 @@ static bool fread_tile(Tile *t, FILE *fp)
 static bool fwrite_tile(const Tile *t, FILE *fp)
 {
 	uint8 buffer[4];
-	buffer[0] = t->groundTileID & 0xff;
-	buffer[1] = (t->groundTileID >> 8) | (t->overlayTileID << 1);
-	buffer[2] = t->houseID | (t->isUnveiled << 3) | (t->hasUnit << 4) | (t->hasStructure << 5) | (t->hasAnimation << 6) | (t->hasExplosion << 7);
-	buffer[3] = t->index;
+	Map_SaveTile(t, buffer);
 	if (fwrite(buffer, 1, 4, fp) != 4) return false;
 	return true;
 }
@@ -1,7 +1,11 @@
 /** @file src/saveload/saveload.c General routines for load/save. */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "types.h"
+#include "../os/common.h"
+#include "../os/endian.h"
 
 #include "saveload.h"
 #include "../house.h"
@@ -11,332 +15,496 @@
 #include "../os/error.h"
 
 
+enum {
+	SAVELOAD_PROGRAM_MAX = 16                               /*!< The maximum amount of compiled SaveLoadDesc tables. */
+};
+
 /**
- * Get the length of the struct how it would be on disk.
+ * A single step of a compiled SaveLoadDesc table: a single element, or a
+ *  run of elements which are the same on disk and in memory.
+ */
+typedef struct SaveLoadOp {
+	uint8 *address;                                         /*!< The address the offset is from, or NULL for the object. */
+	size_t offset;                                          /*!< The offset of the element. */
+	uint8 *objectAddress;                                   /*!< The address the objectOffset is from, or NULL for the object. */
+	size_t objectOffset;                                    /*!< The offset of the (sub-)object the element is in, for callbacks. */
+	uint16 length;                                          /*!< If non-zero, the amount of bytes to copy as they are. */
+	uint8 type_disk;                                        /*!< The SaveLoadType on disk. */
+	uint8 type_memory;                                      /*!< The SaveLoadType in memory. */
+	uint32 (*callback)(void *object, uint32 value, bool loading); /*!< The custom callback. */
+} SaveLoadOp;
+
+/**
+ * A compiled SaveLoadDesc table: the steps to convert between disk and
+ *  memory, with all sub-tables and arrays unrolled.
+ */
+typedef struct SaveLoadProgram {
+	const SaveLoadDesc *sld;                                /*!< The table that is compiled. */
+	uint32 length;                                          /*!< The length on disk. */
+	uint16 count;                                           /*!< The amount of steps. */
+	SaveLoadOp *ops;                                        /*!< The steps. */
+} SaveLoadProgram;
+
+static SaveLoadProgram s_saveLoadPrograms[SAVELOAD_PROGRAM_MAX]; /*!< The compiled tables. */
+static uint16 s_saveLoadProgramCount = 0;                   /*!< The amount of compiled tables. */
+
+/**
+ * Get the length of a type on disk.
+ * @param type The SaveLoadType.
+ * @return The length in bytes.
+ */
+static uint16 SaveLoad_GetTypeLength(SaveLoadType type)
+{
+	switch (type) {
+		case SLDT_UINT8:  return sizeof(uint8);
+		case SLDT_UINT16: return sizeof(uint16);
+		case SLDT_UINT32: return sizeof(uint32);
+		case SLDT_INT8:   return sizeof(int8);
+		case SLDT_INT16:  return sizeof(int16);
+		case SLDT_INT32:  return sizeof(int32);
+		default:          return 0;
+	}
+}
+
+/**
+ * Count the amount of steps needed for a SaveLoadDesc table.
  * @param sld The description of the struct.
- * @return The length of the struct on disk.
+ * @return The amount of steps.
  */
-uint32 SaveLoad_GetLength(const SaveLoadDesc *sld)
+static uint16 SaveLoad_CountOps(const SaveLoadDesc *sld)
 {
-	uint32 length = 0;
+	uint16 count = 0;
 
 	while (sld->type_disk != SLDT_NULL) {
-		switch (sld->type_disk) {
-			case SLDT_NULL:     length += 0; break;
-			case SLDT_CALLBACK: length += 0; break;
-			case SLDT_UINT8:    length += sizeof(uint8)  * sld->count;  break;
-			case SLDT_UINT16:   length += sizeof(uint16) * sld->count;  break;
-			case SLDT_UINT32:   length += sizeof(uint32) * sld->count;  break;
-			case SLDT_INT8:     length += sizeof(int8)   * sld->count;  break;
-			case SLDT_INT16:    length += sizeof(int16)  * sld->count;  break;
-			case SLDT_INT32:    length += sizeof(int32)  * sld->count;  break;
-			case SLDT_SLD:      length += SaveLoad_GetLength(sld->sld) * sld->count; break;
-			default:            length += 0;
+		if (sld->type_disk == SLDT_SLD) {
+			count += SaveLoad_CountOps(sld->sld) * sld->count;
+		} else {
+			count += sld->count;
 		}
 		sld++;
 	}
 
-	return length;
+	return count;
 }
 
 /**
- * Load from a file into a struct.
+ * Add the steps for a SaveLoadDesc table to a program. Elements that are
+ *  stored on disk exactly as they are in memory, directly after the previous
+ *  one, are merged into a single copy.
+ *
+ * @param program The program to add to.
  * @param sld The description of the struct.
- * @param fp The file to read from.
- * @param object The object instance to read to.
- * @return True if and only if the reading was successful.
+ * @param address The address the struct is at, or NULL if it is in the object.
+ * @param offset The offset of the struct.
+ * @return True if and only if the description is valid.
  */
-bool SaveLoad_Load(const SaveLoadDesc *sld, FILE *fp, void *object)
+static bool SaveLoad_CompileOps(SaveLoadProgram *program, const SaveLoadDesc *sld, uint8 *address, size_t offset)
 {
 	while (sld->type_disk != SLDT_NULL) {
-		uint32 value = 0;
 		uint16 i;
 
 		for (i = 0; i < sld->count; i++) {
-			void *ptr = (sld->address == NULL ? ((uint8 *)object) + sld->offset : (uint8 *)sld->address) + i * sld->size;
-
-			switch (sld->type_disk) {
-				case SLDT_CALLBACK:
-				case SLDT_SLD:
-				case SLDT_NULL:
-					value = 0;
-					break;
+			SaveLoadOp *op;
+			SaveLoadOp *prev;
+			uint8 *opAddress  = (sld->address == NULL) ? address : (uint8 *)sld->address;
+			size_t opOffset   = ((sld->address == NULL) ? offset + sld->offset : 0) + i * sld->size;
+			uint16 length     = SaveLoad_GetTypeLength(sld->type_disk);
+			bool copy         = false;
+
+			if (sld->type_disk == SLDT_SLD) {
+				if (!SaveLoad_CompileOps(program, sld->sld, opAddress, opOffset)) return false;
+				continue;
+			}
 
-				case SLDT_UINT8: {
-					uint8 v;
+			if (sld->type_disk == SLDT_INVALID || sld->type_disk == SLDT_CALLBACK || sld->type_memory == SLDT_INVALID || sld->type_memory == SLDT_SLD) {
+				Error("Error in Save/Load structure descriptions");
+				return false;
+			}
 
-					if (fread(&v, sizeof(uint8), 1, fp) != 1) return false;
+			/* Values of the same type in memory as on disk can be copied as they are, if the byte order matches */
+			if (sld->type_disk == sld->type_memory && sld->size == length) {
+				copy = (length == 1);
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+				copy = true;
+#endif
+			}
 
-					value = v;
-				} break;
+			program->length += length;
 
-				case SLDT_UINT16: {
-					uint16 v;
+			prev = (program->count == 0) ? NULL : &program->ops[program->count - 1];
+			if (copy && prev != NULL && prev->length != 0 && prev->address == opAddress && prev->offset + prev->length == opOffset && prev->length + length <= 0xFFFF) {
+				prev->length += length;
+				continue;
+			}
 
-					if (!fread_le_uint16(&v, fp)) return false;
+			op = &program->ops[program->count++];
+			op->address       = opAddress;
+			op->offset        = opOffset;
+			op->objectAddress = address;
+			op->objectOffset  = offset;
+			op->length        = copy ? length : 0;
+			op->type_disk     = (uint8)sld->type_disk;
+			op->type_memory   = (uint8)sld->type_memory;
+			op->callback      = sld->callback;
+		}
 
-					value = v;
-				} break;
+		sld++;
+	}
 
-				case SLDT_UINT32: {
-					uint32 v;
+	return true;
+}
 
-					if (!fread_le_uint32(&v, fp)) return false;
+/**
+ * Get the compiled program for a SaveLoadDesc table, compiling it the first
+ *  time it is used.
+ *
+ * @param sld The description of the struct.
+ * @return The program, or NULL if it could not be compiled.
+ */
+static const SaveLoadProgram *SaveLoad_GetProgram(const SaveLoadDesc *sld)
+{
+	SaveLoadProgram *program;
+	uint16 i;
 
-					value = v;
-				} break;
+	for (i = 0; i < s_saveLoadProgramCount; i++) {
+		if (s_saveLoadPrograms[i].sld == sld) return &s_saveLoadPrograms[i];
+	}
 
+	if (s_saveLoadProgramCount == SAVELOAD_PROGRAM_MAX) {
+		Error("Too many Save/Load structure descriptions");
+		return NULL;
+	}
 
-				case SLDT_INT8: {
-					int8 v;
+	program = &s_saveLoadPrograms[s_saveLoadProgramCount];
+	program->sld    = sld;
+	program->length = 0;
+	program->count  = 0;
+	program->ops    = (SaveLoadOp *)malloc((SaveLoad_CountOps(sld) + 1) * sizeof(SaveLoadOp));
+	if (program->ops == NULL) return NULL;
+
+	if (!SaveLoad_CompileOps(program, sld, NULL, 0) || program->length > SAVELOAD_BUFFER_SIZE) {
+		Error("Error in Save/Load structure descriptions");
+		free(program->ops);
+		program->ops = NULL;
+		return NULL;
+	}
 
-					if (fread(&v, sizeof(int8), 1, fp) != 1) return false;
+	s_saveLoadProgramCount++;
 
-					value = v;
-				} break;
+	return program;
+}
 
-				case SLDT_INT16: {
-					int16 v;
+/**
+ * Compile all SaveLoadDesc tables used to load or save a game. After this no
+ *  table is compiled anymore, so other threads (like the autosave) can use
+ *  the programs without any locking.
+ *
+ * @return True if and only if all tables compiled.
+ */
+bool SaveLoad_Init(void)
+{
+	static const SaveLoadDesc * const tables[] = {
+		g_saveInfo, g_saveInfoOld, g_saveHouse, g_saveUnit, g_saveUnitNew, g_saveStructure, g_saveTeam
+	};
+	uint16 i;
 
-					if (!fread_le_int16(&v, fp)) return false;
+	for (i = 0; i < lengthof(tables); i++) {
+		if (SaveLoad_GetProgram(tables[i]) == NULL) return false;
+	}
 
-					value = v;
-				} break;
+	return true;
+}
 
-				case SLDT_INT32: {
-					int32 v;
+/**
+ * Free all compiled SaveLoadDesc tables.
+ */
+void SaveLoad_Uninit(void)
+{
+	uint16 i;
 
-					if (!fread_le_int32(&v, fp)) return false;
+	for (i = 0; i < s_saveLoadProgramCount; i++) {
+		free(s_saveLoadPrograms[i].ops);
+		s_saveLoadPrograms[i].ops = NULL;
+	}
 
-					value = v;
-				} break;
+	s_saveLoadProgramCount = 0;
+}
 
-				case SLDT_INVALID:
-				default:
-					Error("Error in Save/Load structure descriptions");
-					return false;
-			}
+/**
+ * Get the length of the struct how it would be on disk.
+ * @param sld The description of the struct.
+ * @return The length of the struct on disk.
+ */
+uint32 SaveLoad_GetLength(const SaveLoadDesc *sld)
+{
+	const SaveLoadProgram *program = SaveLoad_GetProgram(sld);
 
-			switch (sld->type_memory) {
-				case SLDT_NULL:
-					break;
-
-				case SLDT_UINT8:
-					*(uint8 *)ptr = (uint8)value;
-					break;
-
-				case SLDT_UINT16:
-					*(uint16 *)ptr = (uint16)value;
-					break;
-
-				case SLDT_UINT32:
-					*(uint32 *)ptr = (uint32)value;
-					break;
-
-
-				case SLDT_INT8:
-					*(int8 *)ptr = (uint8)value;
-					break;
-
-				case SLDT_INT16:
-					*(int16 *)ptr = (uint16)value;
-					break;
-
-				case SLDT_INT32:
-					*(int32 *)ptr = (uint32)value;
-					break;
-
-
-				case SLDT_HOUSEFLAGS: {
-					HouseFlags *f = (HouseFlags *)ptr;
-					f->used = (value & 0x01) ? true : false;
-					f->human = (value & 0x02) ? true : false;
-					f->doneFullScaleAttack = (value & 0x04) ? true : false;
-					f->isAIActive = (value & 0x08) ? true : false;
-					f->radarActivated = (value & 0x10) ? true : false;
-					f->unused_0020 = 0;
-				} break;
-
-				case SLDT_OBJECTFLAGS: {
-					ObjectFlags *f = (ObjectFlags *)ptr;
-					f->s.used = (value & 0x01) ? true : false;
-					f->s.allocated = (value & 0x02) ? true : false;
-					f->s.isNotOnMap = (value & 0x04) ? true : false;
-					f->s.isSmoking = (value & 0x08) ? true : false;
-					f->s.fireTwiceFlip = (value & 0x10) ? true : false;
-					f->s.animationFlip = (value & 0x20) ? true : false;
-					f->s.bulletIsBig = (value & 0x40) ? true : false;
-					f->s.isWobbling = (value & 0x80) ? true : false;
-					f->s.inTransport = (value & 0x0100) ? true : false;
-					f->s.byScenario = (value & 0x0200) ? true : false;
-					f->s.degrades = (value & 0x0400) ? true : false;
-					f->s.isHighlighted = (value & 0x0800) ? true : false;
-					f->s.isDirty = (value & 0x1000) ? true : false;
-					f->s.repairing = (value & 0x2000) ? true : false;
-					f->s.onHold = (value & 0x4000) ? true : false;
-					f->s.notused_4_8000 = 0;
-					f->s.isUnit = (value & 0x010000) ? true : false;
-					f->s.upgrading = (value & 0x020000) ? true : false;
-					f->s.notused_6_0004 = 0;
-					f->s.notused_6_0100 = 0;
-				} break;
-
-				case SLDT_TEAMFLAGS: {
-					TeamFlags *f = (TeamFlags *)ptr;
-					f->used = (value & 0x01) ? true : false;
-					f->notused_0002 = 0;
-				} break;
-
-
-				case SLDT_SLD:
-					if (!SaveLoad_Load(sld->sld, fp, ptr)) return false;
-					break;
-
-				case SLDT_CALLBACK:
-					sld->callback(object, value, true);
-					break;
-
-				case SLDT_INVALID:
-					Error("Error in Save/Load structure descriptions");
-					return false;
-			}
-		}
+	if (program == NULL) return 0;
 
-		sld++;
-	}
-
-	return true;
+	return program->length;
 }
 
 /**
- * Save from a struct to a file.
- * @param sld The description of the struct.
- * @param fp The file to write to.
- * @param object The object instance to write from.
- * @return True if and only if the writing was successful.
+ * Load from a buffer into a struct.
+ * @param program The compiled description of the struct.
+ * @param buffer The buffer to read from.
+ * @param object The object instance to read to.
  */
-bool SaveLoad_Save(const SaveLoadDesc *sld, FILE *fp, void *object)
+static void SaveLoad_LoadBuffer(const SaveLoadProgram *program, const uint8 *buffer, void *object)
 {
-	while (sld->type_disk != SLDT_NULL) {
-		uint32 value = 0;
-		uint16 i;
+	const SaveLoadOp *op = program->ops;
+	const SaveLoadOp *end = program->ops + program->count;
 
-		for (i = 0; i < sld->count; i++) {
-			void *ptr = (sld->address == NULL ? ((uint8 *)object) + sld->offset : (uint8 *)sld->address) + i * sld->size;
+	for (; op != end; op++) {
+		uint8 *ptr = (op->address == NULL ? (uint8 *)object : op->address) + op->offset;
+		uint32 value = 0;
 
-			switch (sld->type_memory) {
-				case SLDT_NULL:
-					value = 0;
-					break;
+		if (op->length != 0) {
+			memcpy(ptr, buffer, op->length);
+			buffer += op->length;
+			continue;
+		}
 
-				case SLDT_UINT8:
-					value = *(uint8 *)ptr;
-					break;
+		switch (op->type_disk) {
+			case SLDT_UINT8:  value = buffer[0]; break;
+			case SLDT_UINT16: value = READ_LE_UINT16(buffer); break;
+			case SLDT_UINT32: value = READ_LE_UINT32(buffer); break;
+			case SLDT_INT8:   value = (int8)buffer[0]; break;
+			case SLDT_INT16:  value = (int16)READ_LE_UINT16(buffer); break;
+			case SLDT_INT32:  value = (int32)READ_LE_UINT32(buffer); break;
+			default: break;
+		}
+		buffer += SaveLoad_GetTypeLength(op->type_disk);
+
+		switch (op->type_memory) {
+			case SLDT_UINT8:
+				*(uint8 *)ptr = (uint8)value;
+				break;
+
+			case SLDT_UINT16:
+				*(uint16 *)ptr = (uint16)value;
+				break;
+
+			case SLDT_UINT32:
+				*(uint32 *)ptr = (uint32)value;
+				break;
+
+
+			case SLDT_INT8:
+				*(int8 *)ptr = (uint8)value;
+				break;
+
+			case SLDT_INT16:
+				*(int16 *)ptr = (uint16)value;
+				break;
+
+			case SLDT_INT32:
+				*(int32 *)ptr = (uint32)value;
+				break;
+
+
+			case SLDT_HOUSEFLAGS: {
+				HouseFlags *f = (HouseFlags *)ptr;
+				f->used = (value & 0x01) ? true : false;
+				f->human = (value & 0x02) ? true : false;
+				f->doneFullScaleAttack = (value & 0x04) ? true : false;
+				f->isAIActive = (value & 0x08) ? true : false;
+				f->radarActivated = (value & 0x10) ? true : false;
+				f->unused_0020 = 0;
+			} break;
+
+			case SLDT_OBJECTFLAGS: {
+				ObjectFlags *f = (ObjectFlags *)ptr;
+				f->s.used = (value & 0x01) ? true : false;
+				f->s.allocated = (value & 0x02) ? true : false;
+				f->s.isNotOnMap = (value & 0x04) ? true : false;
+				f->s.isSmoking = (value & 0x08) ? true : false;
+				f->s.fireTwiceFlip = (value & 0x10) ? true : false;
+				f->s.animationFlip = (value & 0x20) ? true : false;
+				f->s.bulletIsBig = (value & 0x40) ? true : false;
+				f->s.isWobbling = (value & 0x80) ? true : false;
+				f->s.inTransport = (value & 0x0100) ? true : false;
+				f->s.byScenario = (value & 0x0200) ? true : false;
+				f->s.degrades = (value & 0x0400) ? true : false;
+				f->s.isHighlighted = (value & 0x0800) ? true : false;
+				f->s.isDirty = (value & 0x1000) ? true : false;
+				f->s.repairing = (value & 0x2000) ? true : false;
+				f->s.onHold = (value & 0x4000) ? true : false;
+				f->s.notused_4_8000 = 0;
+				f->s.isUnit = (value & 0x010000) ? true : false;
+				f->s.upgrading = (value & 0x020000) ? true : false;
+				f->s.notused_6_0004 = 0;
+				f->s.notused_6_0100 = 0;
+			} break;
+
+			case SLDT_TEAMFLAGS: {
+				TeamFlags *f = (TeamFlags *)ptr;
+				f->used = (value & 0x01) ? true : false;
+				f->notused_0002 = 0;
+			} break;
+
+
+			case SLDT_CALLBACK:
+				op->callback((op->objectAddress == NULL ? (uint8 *)object : op->objectAddress) + op->objectOffset, value, true);
+				break;
+
+			default:
+				break;
+		}
+	}
+}
 
-				case SLDT_UINT16:
-					value = *(uint16 *)ptr;
-					break;
+/**
+ * Save from a struct into a buffer.
+ * @param program The compiled description of the struct.
+ * @param buffer The buffer to write to.
+ * @param object The object instance to write from.
+ */
+static void SaveLoad_SaveBuffer(const SaveLoadProgram *program, uint8 *buffer, void *object)
+{
+	const SaveLoadOp *op = program->ops;
+	const SaveLoadOp *end = program->ops + program->count;
 
-				case SLDT_UINT32:
-					value = *(uint32 *)ptr;
-					break;
+	for (; op != end; op++) {
+		uint8 *ptr = (op->address == NULL ? (uint8 *)object : op->address) + op->offset;
+		uint32 value = 0;
 
+		if (op->length != 0) {
+			memcpy(buffer, ptr, op->length);
+			buffer += op->length;
+			continue;
+		}
 
-				case SLDT_INT8:
-					value = *(int8 *)ptr;
-					break;
+		switch (op->type_memory) {
+			case SLDT_UINT8:
+				value = *(uint8 *)ptr;
+				break;
 
-				case SLDT_INT16:
-					value = *(int16 *)ptr;
-					break;
+			case SLDT_UINT16:
+				value = *(uint16 *)ptr;
+				break;
 
-				case SLDT_INT32:
-					value = *(int32 *)ptr;
-					break;
+			case SLDT_UINT32:
+				value = *(uint32 *)ptr;
+				break;
 
 
-				case SLDT_HOUSEFLAGS: {
-					HouseFlags *f = (HouseFlags *)ptr;
-					value = f->used | (f->human << 1) | (f->doneFullScaleAttack << 2) | (f->isAIActive << 3) | (f->radarActivated << 4);
-				} break;
+			case SLDT_INT8:
+				value = *(int8 *)ptr;
+				break;
 
-				case SLDT_OBJECTFLAGS: {
-					ObjectFlags *f = (ObjectFlags *)ptr;
-					value = f->s.used | (f->s.allocated << 1) | (f->s.isNotOnMap << 2) | (f->s.isSmoking << 3) | (f->s.fireTwiceFlip << 4) | (f->s.animationFlip << 5) | (f->s.bulletIsBig << 6) | (f->s.isWobbling << 7) | (f->s.inTransport << 8) | (f->s.byScenario << 9) | (f->s.degrades << 10) | (f->s.isHighlighted << 11) | (f->s.isDirty << 12) | (f->s.repairing << 13) | (f->s.onHold << 14) | (f->s.isUnit << 16) | (f->s.upgrading << 17);
-				} break;
+			case SLDT_INT16:
+				value = *(int16 *)ptr;
+				break;
 
-				case SLDT_TEAMFLAGS: {
-					TeamFlags *f = (TeamFlags *)ptr;
-					value = f->used;
-				} break;
+			case SLDT_INT32:
+				value = *(int32 *)ptr;
+				break;
 
 
-				case SLDT_SLD:
-					if (!SaveLoad_Save(sld->sld, fp, ptr)) return false;
-					break;
+			case SLDT_HOUSEFLAGS: {
+				HouseFlags *f = (HouseFlags *)ptr;
+				value = f->used | (f->human << 1) | (f->doneFullScaleAttack << 2) | (f->isAIActive << 3) | (f->radarActivated << 4);
+			} break;
 
-				case SLDT_CALLBACK:
-					value = sld->callback(object, 0, false);
-					break;
+			case SLDT_OBJECTFLAGS: {
+				ObjectFlags *f = (ObjectFlags *)ptr;
+				value = f->s.used | (f->s.allocated << 1) | (f->s.isNotOnMap << 2) | (f->s.isSmoking << 3) | (f->s.fireTwiceFlip << 4) | (f->s.animationFlip << 5) | (f->s.bulletIsBig << 6) | (f->s.isWobbling << 7) | (f->s.inTransport << 8) | (f->s.byScenario << 9) | (f->s.degrades << 10) | (f->s.isHighlighted << 11) | (f->s.isDirty << 12) | (f->s.repairing << 13) | (f->s.onHold << 14) | (f->s.isUnit << 16) | (f->s.upgrading << 17);
+			} break;
 
-				case SLDT_INVALID:
-					Error("Error in Save/Load structure descriptions");
-					return false;
-			}
+			case SLDT_TEAMFLAGS: {
+				TeamFlags *f = (TeamFlags *)ptr;
+				value = f->used;
+			} break;
 
-			switch (sld->type_disk) {
-				case SLDT_CALLBACK:
-				case SLDT_SLD:
-				case SLDT_NULL:
-					break;
 
+			case SLDT_CALLBACK:
+				value = op->callback((op->objectAddress == NULL ? (uint8 *)object : op->objectAddress) + op->objectOffset, 0, false);
+				break;
 
-				case SLDT_UINT8: {
-					uint8 v = (uint8)value;
+			default:
+				value = 0;
+				break;
+		}
 
-					if (fwrite(&v, sizeof(uint8), 1, fp) != 1) return false;
-				} break;
+		switch (op->type_disk) {
+			case SLDT_UINT32:
+			case SLDT_INT32:
+				buffer[3] = (uint8)(value >> 24);
+				buffer[2] = (uint8)(value >> 16);
+				/* FALL-THROUGH */
+			case SLDT_UINT16:
+			case SLDT_INT16:
+				buffer[1] = (uint8)(value >> 8);
+				/* FALL-THROUGH */
+			case SLDT_UINT8:
+			case SLDT_INT8:
+				buffer[0] = (uint8)value;
+				break;
+
+			default: break;
+		}
+		buffer += SaveLoad_GetTypeLength(op->type_disk);
+	}
+}
 
-				case SLDT_UINT16: {
-					uint16 v = (uint16)value;
+/**
+ * Load from a file into a struct.
+ * @param sld The description of the struct.
+ * @param fp The file to read from.
+ * @param object The object instance to read to.
+ * @return True if and only if the reading was successful.
+ */
+bool SaveLoad_Load(const SaveLoadDesc *sld, FILE *fp, void *object)
+{
+	const SaveLoadProgram *program = SaveLoad_GetProgram(sld);
+	uint8 buffer[SAVELOAD_BUFFER_SIZE];
 
-					if (!fwrite_le_uint16(v, fp)) return false;
-				} break;
+	if (program == NULL) return false;
 
-				case SLDT_UINT32: {
-					uint32 v = (uint32)value;
+	if (program->length != 0 && fread(buffer, program->length, 1, fp) != 1) return false;
 
-					if (!fwrite_le_uint32(v, fp)) return false;
-				} break;
+	SaveLoad_LoadBuffer(program, buffer, object);
 
+	return true;
+}
 
-				case SLDT_INT8: {
-					int8 v = (int8)value;
+/**
+ * Save from a struct to a file.
+ * @param sld The description of the struct.
+ * @param fp The file to write to.
+ * @param object The object instance to write from.
+ * @return True if and only if the writing was successful.
+ */
+bool SaveLoad_Save(const SaveLoadDesc *sld, FILE *fp, void *object)
+{
+	const SaveLoadProgram *program = SaveLoad_GetProgram(sld);
+	uint8 buffer[SAVELOAD_BUFFER_SIZE];
 
-					if (fwrite(&v, sizeof(int8), 1, fp) != 1) return false;
-				} break;
+	if (program == NULL) return false;
 
-				case SLDT_INT16: {
-					int16 v = (int16)value;
+	SaveLoad_SaveBuffer(program, buffer, object);
 
-					if (!fwrite_le_int16(v, fp)) return false;
-				} break;
+	if (program->length != 0 && fwrite(buffer, program->length, 1, fp) != 1) return false;
 
-				case SLDT_INT32: {
-					int32 v = (int32)value;
+	return true;
+}
 
-					if (!fwrite_le_int32(v, fp)) return false;
-				} break;
+/**
+ * Save from a struct to a buffer in memory, in the same format as on disk.
+ * @param sld The description of the struct.
+ * @param buffer The buffer to write to.
+ * @param length The length of the buffer.
+ * @param object The object instance to write from.
+ * @return True if and only if the struct fits in the buffer.
+ */
+bool SaveLoad_SaveToBuffer(const SaveLoadDesc *sld, uint8 *buffer, uint32 length, void *object)
+{
+	const SaveLoadProgram *program = SaveLoad_GetProgram(sld);
 
-				default:
-				case SLDT_INVALID:
-					Error("Error in Save/Load structure descriptions");
-					return false;
-			}
-		}
+	if (program == NULL || program->length > length) return false;
 
-		sld++;
-	}
+	SaveLoad_SaveBuffer(program, buffer, object);
 
 	return true;
 }
@@ -3,6 +3,12 @@
 #ifndef SAVELOAD_SAVELOAD_H
 #define SAVELOAD_SAVELOAD_H
 
+struct Tile;
+
+enum {
+	SAVELOAD_BUFFER_SIZE = 1024                             /*!< The maximum length on disk of a single SaveLoadDesc table. */
+};
+
 /**
  * Types of storage we support / understand.
  */
@@ -133,10 +139,20 @@ typedef struct SaveLoadDesc {
 extern const SaveLoadDesc g_saveObject[];
 extern const SaveLoadDesc g_saveScriptEngine[];
 extern const SaveLoadDesc g_saveScenario[];
-
+extern const SaveLoadDesc g_saveHouse[];
+extern const SaveLoadDesc g_saveInfo[];
+extern const SaveLoadDesc g_saveInfoOld[];
+extern const SaveLoadDesc g_saveStructure[];
+extern const SaveLoadDesc g_saveTeam[];
+extern const SaveLoadDesc g_saveUnit[];
+extern const SaveLoadDesc g_saveUnitNew[];
+
+extern bool SaveLoad_Init(void);
+extern void SaveLoad_Uninit(void);
 extern uint32 SaveLoad_GetLength(const SaveLoadDesc *sld);
 extern bool SaveLoad_Load(const SaveLoadDesc *sld, FILE *fp, void *object);
 extern bool SaveLoad_Save(const SaveLoadDesc *sld, FILE *fp, void *object);
+extern bool SaveLoad_SaveToBuffer(const SaveLoadDesc *sld, uint8 *buffer, uint32 length, void *object);
 
 extern bool House_Load(FILE *fp, uint32 length);
 extern bool House_LoadOld(FILE *fp, uint32 length);
@@ -145,8 +161,11 @@ extern bool House_Save(FILE *fp);
 extern bool Info_Load(FILE *fp, uint32 length);
 extern bool Info_LoadOld(FILE *fp, uint32 length);
 extern bool Info_Save(FILE *fp);
+extern bool Info_Capture(void);
+extern bool Info_SaveCaptured(FILE *fp);
 
 extern bool Map_Save(FILE *fp);
+extern void Map_SaveTile(const struct Tile *t, uint8 *buffer);
 extern bool Map_Load(FILE *fp, uint32 length);
 
 extern bool Unit_Load(FILE *fp, uint32 length);
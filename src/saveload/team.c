@@ -10,7 +10,7 @@
 #include "../pool/team.h"
 #include "../team.h"
 
-static const SaveLoadDesc s_saveTeam[] = {
+const SaveLoadDesc g_saveTeam[] = {
 	SLD_ENTRY (Team, SLDT_UINT16, index),
 	SLD_ENTRY2(Team, SLDT_UINT16, flags, SLDT_TEAMFLAGS),
 	SLD_ENTRY (Team, SLDT_UINT16, members),
@@ -45,9 +45,9 @@ bool Team_Load(FILE *fp, uint32 length)
 		memset(&tl, 0, sizeof(tl));
 
 		/* Read the next Structure from disk */
-		if (!SaveLoad_Load(s_saveTeam, fp, &tl)) return false;
+		if (!SaveLoad_Load(g_saveTeam, fp, &tl)) return false;
 
-		length -= SaveLoad_GetLength(s_saveTeam);
+		length -= SaveLoad_GetLength(g_saveTeam);
 
 		tl.script.scriptInfo = g_scriptTeam;
 		tl.script.script = g_scriptTeam->start + (size_t)tl.script.script;
@@ -87,7 +87,7 @@ bool Team_Save(FILE *fp)
 		if (t == NULL) break;
 		st = *t;
 
-		if (!SaveLoad_Save(s_saveTeam, fp, &st)) return false;
+		if (!SaveLoad_Save(g_saveTeam, fp, &st)) return false;
 	}
 
 	return true;
@@ -17,7 +17,7 @@ static const SaveLoadDesc s_saveUnitOrientation[] = {
 	SLD_END
 };
 
-static const SaveLoadDesc s_saveUnit[] = {
+const SaveLoadDesc g_saveUnit[] = {
 	SLD_SLD   (Unit,              o, g_saveObject),
 	SLD_EMPTY (      SLDT_UINT16),
 	SLD_ENTRY (Unit, SLDT_UINT16, currentDestination.x),
@@ -54,7 +54,7 @@ static const SaveLoadDesc s_saveUnitNewIndex[] = {
 	SLD_END
 };
 
-static const SaveLoadDesc s_saveUnitNew[] = {
+const SaveLoadDesc g_saveUnitNew[] = {
 	SLD_ENTRY (Unit, SLDT_UINT16, fireDelay),
 	SLD_ENTRY (Unit, SLDT_UINT8,  deviatedHouse),
 	SLD_EMPTY (      SLDT_UINT8),
@@ -78,9 +78,9 @@ bool Unit_Load(FILE *fp, uint32 length)
 		memset(&ul, 0, sizeof(ul));
 
 		/* Read the next Structure from disk */
-		if (!SaveLoad_Load(s_saveUnit, fp, &ul)) return false;
+		if (!SaveLoad_Load(g_saveUnit, fp, &ul)) return false;
 
-		length -= SaveLoad_GetLength(s_saveUnit);
+		length -= SaveLoad_GetLength(g_saveUnit);
 
 		ul.o.script.scriptInfo = g_scriptUnit;
 		ul.o.script.script = g_scriptUnit->start + (size_t)ul.o.script.script;
@@ -131,7 +131,7 @@ bool Unit_Save(FILE *fp)
 		if (u == NULL) break;
 		su = *u;
 
-		if (!SaveLoad_Save(s_saveUnit, fp, &su)) return false;
+		if (!SaveLoad_Save(g_saveUnit, fp, &su)) return false;
 	}
 
 	return true;
@@ -159,9 +159,9 @@ bool UnitNew_Load(FILE *fp, uint32 length)
 		if (u == NULL) return false;
 
 		/* Read the "new" information for this unit */
-		if (!SaveLoad_Load(s_saveUnitNew, fp, u)) return false;
+		if (!SaveLoad_Load(g_saveUnitNew, fp, u)) return false;
 
-		length -= SaveLoad_GetLength(s_saveUnitNew);
+		length -= SaveLoad_GetLength(g_saveUnitNew);
 	}
 	if (length != 0) return false;
 
@@ -191,7 +191,7 @@ bool UnitNew_Save(FILE *fp)
 		su = *u;
 
 		if (!SaveLoad_Save(s_saveUnitNewIndex, fp, &su.o)) return false;
-		if (!SaveLoad_Save(s_saveUnitNew, fp, &su)) return false;
+		if (!SaveLoad_Save(g_saveUnitNew, fp, &su)) return false;
 	}
 
 	return true;
@@ -18,6 +18,7 @@
 #include "pool/structure.h"
 #include "pool/unit.h"
 #include "sprites.h"
+#include "state.h"
 #include "structure.h"
 #include "team.h"
 #include "tile.h"
@@ -25,7 +26,6 @@
 #include "unit.h"
 #include "gui/gui.h"
 
-Scenario g_scenario;
 
 static void *s_scenarioBuffer = NULL;
 
@@ -182,6 +182,7 @@ static void Scenario_Load_Unit(const char *key, char *settings)
 	u->orientation[0].current = orientation;
 	u->actionID     = actionType;
 	u->nextActionID = ACTION_INVALID;
+	Unit_Grid_Update(u);
 
 	/* In case the above function failed and we are passed campaign 2, don't add the unit */
 	if (!Map_IsValidPosition(Tile_PackTile(u->o.position)) && g_campaignID > 2) {
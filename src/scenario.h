@@ -36,7 +36,6 @@ typedef struct Scenario {
 	Reinforcement reinforcement[16];                        /*!< Reinforcement information. */
 } Scenario;
 
-extern Scenario g_scenario;
 
 extern bool Scenario_Load(uint16 scenarioID, uint8 houseID);
 
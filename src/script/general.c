@@ -12,6 +12,7 @@
 #include "../pool/pool.h"
 #include "../pool/structure.h"
 #include "../pool/unit.h"
+#include "../state.h"
 #include "../structure.h"
 #include "../tile.h"
 #include "../tools.h"
@@ -0,0 +1,418 @@
+/** @file src/script/profile.c Script profiler routines. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "../os/common.h"
+
+#include "profile.h"
+
+#include "script.h"
+#include "../structure.h"
+#include "../team.h"
+#include "../timer.h"
+#include "../unit.h"
+
+enum {
+	SCRIPT_PROFILE_CATEGORY_MAX = 3,                        /*!< The amount of script files being profiled. */
+	SCRIPT_PROFILE_ENTRY_MAX    = 64                        /*!< The maximum amount of entries reported per script file. */
+};
+
+/**
+ * Profile information for a single script file.
+ */
+typedef struct ScriptProfileCategory {
+	uint16  size;                                           /*!< The amount of locations in opcodes and time. */
+	uint32 *opcodes;                                        /*!< Per location, the amount of times the opcode there was executed. */
+	double *time;                                           /*!< Per location, the time spent in a function called from there, in microseconds. */
+	uint32  functionCalls[SCRIPT_FUNCTIONS_COUNT];          /*!< Per function, the amount of times it was called. */
+	double  functionTime[SCRIPT_FUNCTIONS_COUNT];           /*!< Per function, the time spent in it, in microseconds. */
+} ScriptProfileCategory;
+
+/**
+ * A single line of a report.
+ */
+typedef struct ScriptProfileLine {
+	const char *name;                                       /*!< The name of what is reported on. */
+	uint16 index;                                           /*!< The index (opcode, function or typeID) of what is reported on. */
+	uint8  category;                                        /*!< The script file it belongs to. */
+	uint32 count;                                           /*!< The amount of opcodes executed or calls made. */
+	double time;                                            /*!< The time spent, in microseconds. */
+} ScriptProfileLine;
+
+bool g_scriptProfile = false;                               /*!< When true, the scripts are being profiled. */
+
+static ScriptProfileCategory s_scriptProfile[SCRIPT_PROFILE_CATEGORY_MAX]; /*!< Profile information per script file. */
+static uint32 s_scriptProfileOpcodes[32];                   /*!< Per opcode, the amount of times it was executed. */
+
+static const char * const s_scriptProfileCategoryName[SCRIPT_PROFILE_CATEGORY_MAX] = { "UNIT.EMC", "BUILD.EMC", "TEAM.EMC" };
+
+static const char * const s_scriptProfileOpcodeName[] = {
+	"JUMP", "SETRETURNVALUE", "PUSH_RETURN_OR_LOCATION", "PUSH", "PUSH2", "PUSH_VARIABLE", "PUSH_LOCAL_VARIABLE",
+	"PUSH_PARAMETER", "POP_RETURN_OR_LOCATION", "POP_VARIABLE", "POP_LOCAL_VARIABLE", "POP_PARAMETER",
+	"STACK_REWIND", "STACK_FORWARD", "FUNCTION", "JUMP_NE", "UNARY", "BINARY", "RETURN"
+};
+
+/**
+ * The names of the functions in g_scriptFunctionsUnit, g_scriptFunctionsStructure
+ *  and g_scriptFunctionsTeam.
+ */
+static const char * const s_scriptProfileFunctionName[SCRIPT_PROFILE_CATEGORY_MAX][SCRIPT_FUNCTIONS_COUNT] = {
+	{
+		/* 00 */ "Script_Unit_GetInfo",
+		/* 01 */ "Script_Unit_SetAction",
+		/* 02 */ "Script_General_DisplayText",
+		/* 03 */ "Script_General_GetDistanceToTile",
+		/* 04 */ "Script_Unit_StartAnimation",
+		/* 05 */ "Script_Unit_SetDestination",
+		/* 06 */ "Script_Unit_GetOrientation",
+		/* 07 */ "Script_Unit_SetOrientation",
+		/* 08 */ "Script_Unit_Fire",
+		/* 09 */ "Script_Unit_MCVDeploy",
+		/* 0A */ "Script_Unit_SetActionDefault",
+		/* 0B */ "Script_Unit_Blink",
+		/* 0C */ "Script_Unit_CalculateRoute",
+		/* 0D */ "Script_General_IsEnemy",
+		/* 0E */ "Script_Unit_ExplosionSingle",
+		/* 0F */ "Script_Unit_Die",
+		/* 10 */ "Script_General_Delay",
+		/* 11 */ "Script_General_IsFriendly",
+		/* 12 */ "Script_Unit_ExplosionMultiple",
+		/* 13 */ "Script_Unit_SetSprite",
+		/* 14 */ "Script_Unit_TransportDeliver",
+		/* 15 */ "Script_General_NoOperation",
+		/* 16 */ "Script_Unit_MoveToTarget",
+		/* 17 */ "Script_General_RandomRange",
+		/* 18 */ "Script_General_FindIdle",
+		/* 19 */ "Script_Unit_SetDestinationDirect",
+		/* 1A */ "Script_Unit_Stop",
+		/* 1B */ "Script_Unit_SetSpeed",
+		/* 1C */ "Script_Unit_FindBestTarget",
+		/* 1D */ "Script_Unit_GetTargetPriority",
+		/* 1E */ "Script_Unit_MoveToStructure",
+		/* 1F */ "Script_Unit_IsInTransport",
+		/* 20 */ "Script_Unit_GetAmount",
+		/* 21 */ "Script_Unit_RandomSoldier",
+		/* 22 */ "Script_Unit_Pickup",
+		/* 23 */ "Script_Unit_CallUnitByType",
+		/* 24 */ "Script_Unit_Unknown2552",
+		/* 25 */ "Script_Unit_FindStructure",
+		/* 26 */ "Script_General_VoicePlay",
+		/* 27 */ "Script_Unit_DisplayDestroyedText",
+		/* 28 */ "Script_Unit_RemoveFog",
+		/* 29 */ "Script_General_SearchSpice",
+		/* 2A */ "Script_Unit_Harvest",
+		/* 2B */ "Script_General_NoOperation",
+		/* 2C */ "Script_General_GetLinkedUnitType",
+		/* 2D */ "Script_General_GetIndexType",
+		/* 2E */ "Script_General_DecodeIndex",
+		/* 2F */ "Script_Unit_IsValidDestination",
+		/* 30 */ "Script_Unit_GetRandomTile",
+		/* 31 */ "Script_Unit_IdleAction",
+		/* 32 */ "Script_General_UnitCount",
+		/* 33 */ "Script_Unit_GoToClosestStructure",
+		/* 34 */ "Script_General_NoOperation",
+		/* 35 */ "Script_General_NoOperation",
+		/* 36 */ "Script_Unit_Sandworm_GetBestTarget",
+		/* 37 */ "Script_Unit_Unknown2BD5",
+		/* 38 */ "Script_General_GetOrientation",
+		/* 39 */ "Script_General_NoOperation",
+		/* 3A */ "Script_Unit_SetTarget",
+		/* 3B */ "Script_General_Unknown0288",
+		/* 3C */ "Script_General_DelayRandom",
+		/* 3D */ "Script_Unit_Rotate",
+		/* 3E */ "Script_General_GetDistanceToObject",
+		/* 3F */ "Script_General_NoOperation",
+	}, {
+		/* 00 */ "Script_General_Delay",
+		/* 01 */ "Script_General_NoOperation",
+		/* 02 */ "Script_Structure_Unknown0A81",
+		/* 03 */ "Script_Structure_FindUnitByType",
+		/* 04 */ "Script_Structure_SetState",
+		/* 05 */ "Script_General_DisplayText",
+		/* 06 */ "Script_Structure_Unknown11B9",
+		/* 07 */ "Script_Structure_Unknown0C5A",
+		/* 08 */ "Script_Structure_FindTargetUnit",
+		/* 09 */ "Script_Structure_RotateTurret",
+		/* 0A */ "Script_Structure_GetDirection",
+		/* 0B */ "Script_Structure_Fire",
+		/* 0C */ "Script_General_NoOperation",
+		/* 0D */ "Script_Structure_GetState",
+		/* 0E */ "Script_Structure_VoicePlay",
+		/* 0F */ "Script_Structure_RemoveFogAroundTile",
+		/* 10 */ "Script_General_NoOperation",
+		/* 11 */ "Script_General_NoOperation",
+		/* 12 */ "Script_General_NoOperation",
+		/* 13 */ "Script_General_NoOperation",
+		/* 14 */ "Script_General_NoOperation",
+		/* 15 */ "Script_Structure_RefineSpice",
+		/* 16 */ "Script_Structure_Explode",
+		/* 17 */ "Script_Structure_Destroy",
+		/* 18 */ "Script_General_NoOperation",
+	}, {
+		/* 00 */ "Script_General_Delay",
+		/* 01 */ "Script_Team_DisplayText",
+		/* 02 */ "Script_Team_GetMembers",
+		/* 03 */ "Script_Team_AddClosestUnit",
+		/* 04 */ "Script_Team_GetAverageDistance",
+		/* 05 */ "Script_Team_Unknown0543",
+		/* 06 */ "Script_Team_FindBestTarget",
+		/* 07 */ "Script_Team_Unknown0788",
+		/* 08 */ "Script_Team_Load",
+		/* 09 */ "Script_Team_Load2",
+		/* 0A */ "Script_General_DelayRandom",
+		/* 0B */ "Script_General_DisplayModalMessage",
+		/* 0C */ "Script_Team_GetVariable6",
+		/* 0D */ "Script_Team_GetTarget",
+		/* 0E */ "Script_General_NoOperation",
+	}
+};
+
+/**
+ * Get the profile information for the script file of a scriptInfo.
+ * @param scriptInfo The scriptInfo to get the information for.
+ * @return The index in s_scriptProfile, or SCRIPT_PROFILE_CATEGORY_MAX if it is not profiled.
+ */
+static uint8 ScriptProfile_GetCategory(const ScriptInfo *scriptInfo)
+{
+	if (scriptInfo == g_scriptUnit) return 0;
+	if (scriptInfo == g_scriptStructure) return 1;
+	if (scriptInfo == g_scriptTeam) return 2;
+	return SCRIPT_PROFILE_CATEGORY_MAX;
+}
+
+/**
+ * Count the execution of an opcode.
+ * @param scriptInfo The scriptInfo of the script being executed.
+ * @param location The location of the opcode, in words from the start.
+ * @param opcode The opcode executed.
+ */
+void ScriptProfile_Opcode(const ScriptInfo *scriptInfo, uint16 location, uint8 opcode)
+{
+	ScriptProfileCategory *c;
+	uint8 category;
+
+	s_scriptProfileOpcodes[opcode & 0x1F]++;
+
+	category = ScriptProfile_GetCategory(scriptInfo);
+	if (category == SCRIPT_PROFILE_CATEGORY_MAX) return;
+	c = &s_scriptProfile[category];
+
+	/* The script file is (re)loaded; start counting per location again */
+	if (c->size != scriptInfo->startCount) {
+		free(c->opcodes);
+		free(c->time);
+
+		c->size    = scriptInfo->startCount;
+		c->opcodes = calloc(c->size, sizeof(uint32));
+		c->time    = calloc(c->size, sizeof(double));
+
+		if (c->opcodes == NULL || c->time == NULL) {
+			free(c->opcodes); c->opcodes = NULL;
+			free(c->time); c->time = NULL;
+			c->size = 0;
+			return;
+		}
+	}
+
+	c->opcodes[location]++;
+}
+
+/**
+ * Count a call to a script function.
+ * @param scriptInfo The scriptInfo of the script being executed.
+ * @param location The location of the opcode calling the function, in words from the start.
+ * @param function The function called.
+ * @param start The value of Timer_GetTimeMicro before the function was called.
+ */
+void ScriptProfile_Function(const ScriptInfo *scriptInfo, uint16 location, uint8 function, uint32 start)
+{
+	ScriptProfileCategory *c;
+	uint32 time;
+	uint8 category;
+
+	time = Timer_GetTimeMicro() - start;
+
+	category = ScriptProfile_GetCategory(scriptInfo);
+	if (category == SCRIPT_PROFILE_CATEGORY_MAX) return;
+	c = &s_scriptProfile[category];
+
+	c->functionCalls[function]++;
+	c->functionTime[function] += time;
+
+	if (location < c->size) c->time[location] += time;
+}
+
+/**
+ * Sort report lines on time spent, and on count if no time is known.
+ */
+static int ScriptProfile_Sorter(const void *a, const void *b)
+{
+	const ScriptProfileLine *pa = a;
+	const ScriptProfileLine *pb = b;
+
+	if (pa->time != pb->time) return (pa->time < pb->time) ? 1 : -1;
+	if (pa->count != pb->count) return (pa->count < pb->count) ? 1 : -1;
+	return 0;
+}
+
+/**
+ * Get the name of the type a script entry is for.
+ * @param category The script file.
+ * @param typeID The typeID of the entry.
+ * @return The name of the type.
+ */
+static const char *ScriptProfile_GetEntryName(uint8 category, uint16 typeID)
+{
+	switch (category) {
+		case 0: return (typeID < UNIT_MAX) ? g_table_unitInfo[typeID].o.name : "?";
+		case 1: return (typeID < STRUCTURE_MAX) ? g_table_structureInfo[typeID].o.name : "?";
+		case 2: return (typeID < TEAM_ACTION_MAX) ? g_table_teamActionName[typeID] : "?";
+		default: return "?";
+	}
+}
+
+/**
+ * Collect the lines for the report per script entry. The opcodes between an
+ *  offset in ScriptInfo->offsets and the next higher offset are attributed to
+ *  the types using that offset.
+ *
+ * @param category The script file.
+ * @param lines Where to store the lines.
+ * @return The amount of lines stored.
+ */
+static uint16 ScriptProfile_CollectEntries(uint8 category, ScriptProfileLine *lines)
+{
+	const ScriptProfileCategory *c = &s_scriptProfile[category];
+	const ScriptInfo *scriptInfo;
+	uint16 count = 0;
+	uint16 i;
+
+	switch (category) {
+		case 0:  scriptInfo = g_scriptUnit; break;
+		case 1:  scriptInfo = g_scriptStructure; break;
+		default: scriptInfo = g_scriptTeam; break;
+	}
+
+	if (scriptInfo->offsets == NULL || c->size != scriptInfo->startCount) return 0;
+
+	for (i = 0; i < scriptInfo->offsetsCount && count < SCRIPT_PROFILE_ENTRY_MAX; i++) {
+		ScriptProfileLine *line;
+		uint16 start = scriptInfo->offsets[i];
+		uint16 end = c->size;
+		uint16 j;
+
+		if (start >= c->size) continue;
+
+		/* Types sharing a script are reported once, under the first of them */
+		for (j = 0; j < i; j++) {
+			if (scriptInfo->offsets[j] == start) break;
+		}
+		if (j != i) continue;
+
+		for (j = 0; j < scriptInfo->offsetsCount; j++) {
+			if (scriptInfo->offsets[j] > start && scriptInfo->offsets[j] < end) end = scriptInfo->offsets[j];
+		}
+
+		line = &lines[count++];
+		line->name     = ScriptProfile_GetEntryName(category, i);
+		line->index    = i;
+		line->category = category;
+		line->count    = 0;
+		line->time     = 0;
+
+		for (j = start; j < end; j++) {
+			line->count += c->opcodes[j];
+			line->time  += c->time[j];
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Write the collected profile information to stdout, sorted so the most
+ *  expensive functions and scripts come first.
+ */
+void ScriptProfile_Report(void)
+{
+	static ScriptProfileLine lines[SCRIPT_PROFILE_CATEGORY_MAX * SCRIPT_FUNCTIONS_COUNT];
+	uint16 count;
+	uint16 i;
+	uint8 category;
+
+	printf("Script profile\n");
+
+	printf("\nOpcodes:\n");
+	count = 0;
+	for (i = 0; i < lengthof(s_scriptProfileOpcodes); i++) {
+		if (s_scriptProfileOpcodes[i] == 0) continue;
+
+		lines[count].name  = (i < lengthof(s_scriptProfileOpcodeName)) ? s_scriptProfileOpcodeName[i] : "(invalid)";
+		lines[count].index = i;
+		lines[count].count = s_scriptProfileOpcodes[i];
+		lines[count].time  = 0;
+		count++;
+	}
+	qsort(lines, count, sizeof(ScriptProfileLine), ScriptProfile_Sorter);
+	for (i = 0; i < count; i++) {
+		printf("  %2d %-24s %10lu\n", lines[i].index, lines[i].name, (unsigned long)lines[i].count);
+	}
+
+	printf("\nFunctions:\n");
+	count = 0;
+	for (category = 0; category < SCRIPT_PROFILE_CATEGORY_MAX; category++) {
+		const ScriptProfileCategory *c = &s_scriptProfile[category];
+
+		for (i = 0; i < SCRIPT_FUNCTIONS_COUNT; i++) {
+			if (c->functionCalls[i] == 0) continue;
+
+			lines[count].name     = (s_scriptProfileFunctionName[category][i] != NULL) ? s_scriptProfileFunctionName[category][i] : "?";
+			lines[count].index    = i;
+			lines[count].category = category;
+			lines[count].count    = c->functionCalls[i];
+			lines[count].time     = c->functionTime[i];
+			count++;
+		}
+	}
+	qsort(lines, count, sizeof(ScriptProfileLine), ScriptProfile_Sorter);
+	for (i = 0; i < count; i++) {
+		printf("  %-9s %02X %-36s %10lu calls %12.3f ms %10.3f us/call\n", s_scriptProfileCategoryName[lines[i].category], lines[i].index, lines[i].name,
+			(unsigned long)lines[i].count, lines[i].time / 1000.0, lines[i].time / lines[i].count);
+	}
+
+	printf("\nScripts:\n");
+	count = 0;
+	for (category = 0; category < SCRIPT_PROFILE_CATEGORY_MAX; category++) {
+		count += ScriptProfile_CollectEntries(category, &lines[count]);
+	}
+	qsort(lines, count, sizeof(ScriptProfileLine), ScriptProfile_Sorter);
+	for (i = 0; i < count; i++) {
+		if (lines[i].count == 0) continue;
+
+		printf("  %-9s %2d %-24s %10lu opcodes %12.3f ms in functions\n", s_scriptProfileCategoryName[lines[i].category], lines[i].index, lines[i].name,
+			(unsigned long)lines[i].count, lines[i].time / 1000.0);
+	}
+
+	fflush(stdout);
+}
+
+/**
+ * Report the collected profile information, if profiling is enabled, and free
+ *  all memory used by the profiler.
+ */
+void ScriptProfile_Uninit(void)
+{
+	uint8 category;
+
+	if (g_scriptProfile) ScriptProfile_Report();
+
+	for (category = 0; category < SCRIPT_PROFILE_CATEGORY_MAX; category++) {
+		ScriptProfileCategory *c = &s_scriptProfile[category];
+
+		free(c->opcodes); c->opcodes = NULL;
+		free(c->time); c->time = NULL;
+		c->size = 0;
+	}
+}
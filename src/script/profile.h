@@ -0,0 +1,15 @@
+/** @file src/script/profile.h Script profiler definitions. */
+
+#ifndef SCRIPT_PROFILE_H
+#define SCRIPT_PROFILE_H
+
+struct ScriptInfo;
+
+extern bool g_scriptProfile;
+
+extern void ScriptProfile_Opcode(const struct ScriptInfo *scriptInfo, uint16 location, uint8 opcode);
+extern void ScriptProfile_Function(const struct ScriptInfo *scriptInfo, uint16 location, uint8 function, uint32 start);
+extern void ScriptProfile_Report(void);
+extern void ScriptProfile_Uninit(void);
+
+#endif /* SCRIPT_PROFILE_H */
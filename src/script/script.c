@@ -11,14 +11,12 @@
 #include "../os/strings.h"
 
 #include "script.h"
+#include "profile.h"
 
 #include "../file.h"
 #include "../object.h"
-
-struct Object *g_scriptCurrentObject;
-struct Structure *g_scriptCurrentStructure;
-struct Unit *g_scriptCurrentUnit;
-struct Team *g_scriptCurrentTeam;
+#include "../state.h"
+#include "../timer.h"
 
 static ScriptInfo s_scriptStructure;
 static ScriptInfo s_scriptTeam;
@@ -305,263 +303,365 @@ bool Script_IsLoaded(ScriptEngine *script)
 }
 
 /**
- * Run the next opcode of a script.
+ * Decode the instruction at a location of a script, so it doesn't have to be
+ *  decoded every time it is executed.
  *
- * @param script The script engine to run.
- * @return Returns false if and only if there was an scripting error, like
- *   invalid opcode.
+ * @param scriptInfo The scriptInfo the instruction is in.
+ * @param location The location of the instruction, in words from the start.
+ * @param instruction The decoded instruction.
  */
-bool Script_Run(ScriptEngine *script)
+static void Script_DecodeInstruction(const ScriptInfo *scriptInfo, uint16 location, ScriptInstruction *instruction)
 {
-	ScriptInfo *scriptInfo;
-	uint16 current, parameter;
-	uint8 opcode;
-
-	if (!Script_IsLoaded(script)) return false;
-	scriptInfo = script->scriptInfo;
+	uint16 current;
 
-	current = BETOH16(*script->script);
-	script->script++;
+	current = BETOH16(scriptInfo->start[location]);
 
-	opcode    = (current >> 8) & 0x1F;
-	parameter = 0;
+	instruction->opcode    = (current >> 8) & 0x1F;
+	instruction->parameter = 0;
+	instruction->length    = 1;
 
 	if ((current & 0x8000) != 0) {
 		/* When this flag is set, the instruction is a GOTO with a 13bit address */
-		opcode = 0;
-		parameter = current & 0x7FFF;
+		instruction->opcode = SCRIPT_JUMP;
+		instruction->parameter = current & 0x7FFF;
 	} else if ((current & 0x4000) != 0) {
 		/* When this flag is set, the parameter is part of the instruction */
-		parameter = (int16)(int8)(current & 0xFF);
+		instruction->parameter = (int16)(int8)(current & 0xFF);
 	} else if ((current & 0x2000) != 0) {
 		/* When this flag is set, the parameter is in the next opcode */
-		parameter = BETOH16(*script->script);
-		script->script++;
+		if (location + 1 < scriptInfo->startCount) instruction->parameter = BETOH16(scriptInfo->start[location + 1]);
+		instruction->length = 2;
 	}
 
-	switch (opcode) {
-		case SCRIPT_JUMP: {
-			script->script = scriptInfo->start + parameter;
-			return true;
-		}
+	/* Resolve the parameters which are only partially used */
+	if (instruction->opcode == SCRIPT_JUMP_NE) instruction->parameter &= 0x7FFF;
+	if (instruction->opcode == SCRIPT_FUNCTION) instruction->parameter &= 0xFF;
+}
 
-		case SCRIPT_SETRETURNVALUE: {
-			script->returnValue = parameter;
-			return true;
-		}
+#if defined(__GNUC__)
+/* Jump directly from one opcode to the next, instead of going through a switch */
+#define SCRIPT_DISPATCH(opcode) __extension__ ({ goto *l_dispatch[opcode]; });
+#define SCRIPT_OPCODE(opcode) label_##opcode
+#define SCRIPT_OPCODE_INVALID label_invalid
+#else
+#define SCRIPT_DISPATCH(opcode) switch (opcode)
+#define SCRIPT_OPCODE(opcode) case opcode
+#define SCRIPT_OPCODE_INVALID default
+#endif
 
-		case SCRIPT_PUSH_RETURN_OR_LOCATION: {
-			if (parameter == 0) { /* PUSH RETURNVALUE */
-				STACK_PUSH(script->returnValue);
-				return true;
-			}
+/**
+ * Run a number of opcodes of a script.
+ *
+ * @param script The script engine to run.
+ * @param count The maximum amount of opcodes to run.
+ * @param untilDelay If true, stop as soon as the script gets delayed.
+ * @return Returns false if and only if there was an scripting error, like
+ *   invalid opcode.
+ */
+bool Script_RunOpcodes(ScriptEngine *script, uint16 count, bool untilDelay)
+{
+#if defined(__GNUC__)
+	static const void * const l_dispatch[32] = {
+		__extension__ &&label_SCRIPT_JUMP,
+		__extension__ &&label_SCRIPT_SETRETURNVALUE,
+		__extension__ &&label_SCRIPT_PUSH_RETURN_OR_LOCATION,
+		__extension__ &&label_SCRIPT_PUSH,
+		__extension__ &&label_SCRIPT_PUSH2,
+		__extension__ &&label_SCRIPT_PUSH_VARIABLE,
+		__extension__ &&label_SCRIPT_PUSH_LOCAL_VARIABLE,
+		__extension__ &&label_SCRIPT_PUSH_PARAMETER,
+		__extension__ &&label_SCRIPT_POP_RETURN_OR_LOCATION,
+		__extension__ &&label_SCRIPT_POP_VARIABLE,
+		__extension__ &&label_SCRIPT_POP_LOCAL_VARIABLE,
+		__extension__ &&label_SCRIPT_POP_PARAMETER,
+		__extension__ &&label_SCRIPT_STACK_REWIND,
+		__extension__ &&label_SCRIPT_STACK_FORWARD,
+		__extension__ &&label_SCRIPT_FUNCTION,
+		__extension__ &&label_SCRIPT_JUMP_NE,
+		__extension__ &&label_SCRIPT_UNARY,
+		__extension__ &&label_SCRIPT_BINARY,
+		__extension__ &&label_SCRIPT_RETURN,
+		__extension__ &&label_invalid, __extension__ &&label_invalid, __extension__ &&label_invalid, __extension__ &&label_invalid,
+		__extension__ &&label_invalid, __extension__ &&label_invalid, __extension__ &&label_invalid, __extension__ &&label_invalid,
+		__extension__ &&label_invalid, __extension__ &&label_invalid, __extension__ &&label_invalid, __extension__ &&label_invalid,
+		__extension__ &&label_invalid
+	};
+#endif
 
-			if (parameter == 1) { /* PUSH NEXT LOCATION + FRAMEPOINTER */
-				uint32 location;
-				location = (uint32)(script->script - scriptInfo->start) + 1;
+	for (; count > 0; count--) {
+		ScriptInfo *scriptInfo;
+		const ScriptInstruction *instruction;
+		uint16 location;
+		uint16 parameter;
 
-				STACK_PUSH(location);
-				STACK_PUSH(script->framePointer);
-				script->framePointer = script->stackPointer + 2;
+		if (untilDelay && script->delay != 0) return true;
 
-				return true;
-			}
+		if (!Script_IsLoaded(script)) return false;
+		scriptInfo = script->scriptInfo;
 
-			Script_Error("Unknown parameter %d for opcode 2", parameter);
+		location = (uint16)(script->script - scriptInfo->start);
+		if (scriptInfo->instructions == NULL || location >= scriptInfo->startCount) {
+			Script_Error("Invalid location %d", location);
 			script->script = NULL;
 			return false;
 		}
 
-		case SCRIPT_PUSH: case SCRIPT_PUSH2: {
-			STACK_PUSH(parameter);
-			return true;
-		}
+		instruction = &scriptInfo->instructions[location];
+		parameter = instruction->parameter;
 
-		case SCRIPT_PUSH_VARIABLE: {
-			STACK_PUSH(script->variables[parameter]);
-			return true;
-		}
+		if (g_scriptProfile) ScriptProfile_Opcode(scriptInfo, location, instruction->opcode);
+		script->script += instruction->length;
 
-		case SCRIPT_PUSH_LOCAL_VARIABLE: {
-			if (script->framePointer - parameter - 2 >= 15) {
-#ifdef _DEBUG
-				Script_Error("Stack Overflow at %s:%d", __FILE__, __LINE__);
-#else
-				Script_Error("Stack Overflow");
-#endif
-				script->script = NULL;
-				return false;
+		SCRIPT_DISPATCH(instruction->opcode) {
+			SCRIPT_OPCODE(SCRIPT_JUMP): {
+				script->script = scriptInfo->start + parameter;
+				continue;
 			}
 
-			STACK_PUSH(script->stack[script->framePointer - parameter - 2]);
-			return true;
-		}
+			SCRIPT_OPCODE(SCRIPT_SETRETURNVALUE): {
+				script->returnValue = parameter;
+				continue;
+			}
 
-		case SCRIPT_PUSH_PARAMETER: {
-			if (script->framePointer + parameter - 1 >= 15) {
-#ifdef _DEBUG
-				Script_Error("Stack Overflow at %s:%d", __FILE__, __LINE__);
-#else
-				Script_Error("Stack Overflow");
-#endif
+			SCRIPT_OPCODE(SCRIPT_PUSH_RETURN_OR_LOCATION): {
+				if (parameter == 0) { /* PUSH RETURNVALUE */
+					STACK_PUSH(script->returnValue);
+					continue;
+				}
+
+				if (parameter == 1) { /* PUSH NEXT LOCATION + FRAMEPOINTER */
+					uint32 next;
+					next = (uint32)(script->script - scriptInfo->start) + 1;
+
+					STACK_PUSH(next);
+					STACK_PUSH(script->framePointer);
+					script->framePointer = script->stackPointer + 2;
+
+					continue;
+				}
+
+				Script_Error("Unknown parameter %d for opcode 2", parameter);
 				script->script = NULL;
 				return false;
 			}
 
-			STACK_PUSH(script->stack[script->framePointer + parameter - 1]);
-			return true;
-		}
-
-		case SCRIPT_POP_RETURN_OR_LOCATION: {
-			if (parameter == 0) { /* POP RETURNVALUE */
-				script->returnValue = STACK_POP();
-				return true;
+			SCRIPT_OPCODE(SCRIPT_PUSH):
+			SCRIPT_OPCODE(SCRIPT_PUSH2): {
+				STACK_PUSH(parameter);
+				continue;
 			}
-			if (parameter == 1) { /* POP FRAMEPOINTER + LOCATION */
-				STACK_PEEK(2); if (script->script == NULL) return false;
 
-				script->framePointer = (uint8)STACK_POP();
-				script->script = scriptInfo->start + STACK_POP();
-				return true;
+			SCRIPT_OPCODE(SCRIPT_PUSH_VARIABLE): {
+				STACK_PUSH(script->variables[parameter]);
+				continue;
 			}
 
-			Script_Error("Unknown parameter %d for opcode 8", parameter);
-			script->script = NULL;
-			return false;
-		}
+			SCRIPT_OPCODE(SCRIPT_PUSH_LOCAL_VARIABLE): {
+				if (script->framePointer - parameter - 2 >= 15) {
+#ifdef _DEBUG
+					Script_Error("Stack Overflow at %s:%d", __FILE__, __LINE__);
+#else
+					Script_Error("Stack Overflow");
+#endif
+					script->script = NULL;
+					return false;
+				}
 
-		case SCRIPT_POP_VARIABLE: {
-			script->variables[parameter] = STACK_POP();
-			return true;
-		}
+				STACK_PUSH(script->stack[script->framePointer - parameter - 2]);
+				continue;
+			}
 
-		case SCRIPT_POP_LOCAL_VARIABLE: {
-			if (script->framePointer - parameter - 2 >= 15) {
+			SCRIPT_OPCODE(SCRIPT_PUSH_PARAMETER): {
+				if (script->framePointer + parameter - 1 >= 15) {
 #ifdef _DEBUG
-				Script_Error("Stack Overflow at %s:%d", __FILE__, __LINE__);
+					Script_Error("Stack Overflow at %s:%d", __FILE__, __LINE__);
 #else
-				Script_Error("Stack Overflow");
+					Script_Error("Stack Overflow");
 #endif
+					script->script = NULL;
+					return false;
+				}
+
+				STACK_PUSH(script->stack[script->framePointer + parameter - 1]);
+				continue;
+			}
+
+			SCRIPT_OPCODE(SCRIPT_POP_RETURN_OR_LOCATION): {
+				if (parameter == 0) { /* POP RETURNVALUE */
+					script->returnValue = STACK_POP();
+					continue;
+				}
+				if (parameter == 1) { /* POP FRAMEPOINTER + LOCATION */
+					STACK_PEEK(2); if (script->script == NULL) return false;
+
+					script->framePointer = (uint8)STACK_POP();
+					script->script = scriptInfo->start + STACK_POP();
+					continue;
+				}
+
+				Script_Error("Unknown parameter %d for opcode 8", parameter);
 				script->script = NULL;
 				return false;
 			}
 
-			script->stack[script->framePointer - parameter - 2] = STACK_POP();
-			return true;
-		}
+			SCRIPT_OPCODE(SCRIPT_POP_VARIABLE): {
+				script->variables[parameter] = STACK_POP();
+				continue;
+			}
 
-		case SCRIPT_POP_PARAMETER: {
-			if (script->framePointer + parameter - 1 >= 15) {
+			SCRIPT_OPCODE(SCRIPT_POP_LOCAL_VARIABLE): {
+				if (script->framePointer - parameter - 2 >= 15) {
 #ifdef _DEBUG
-				Script_Error("Stack Overflow at %s:%d", __FILE__, __LINE__);
+					Script_Error("Stack Overflow at %s:%d", __FILE__, __LINE__);
 #else
-				Script_Error("Stack Overflow");
+					Script_Error("Stack Overflow");
 #endif
-				script->script = NULL;
-				return false;
-			}
+					script->script = NULL;
+					return false;
+				}
 
-			script->stack[script->framePointer + parameter - 1] =STACK_POP();
-			return true;
-		}
+				script->stack[script->framePointer - parameter - 2] = STACK_POP();
+				continue;
+			}
 
-		case SCRIPT_STACK_REWIND: {
-			script->stackPointer += parameter;
-			return true;
-		}
+			SCRIPT_OPCODE(SCRIPT_POP_PARAMETER): {
+				if (script->framePointer + parameter - 1 >= 15) {
+#ifdef _DEBUG
+					Script_Error("Stack Overflow at %s:%d", __FILE__, __LINE__);
+#else
+					Script_Error("Stack Overflow");
+#endif
+					script->script = NULL;
+					return false;
+				}
 
-		case SCRIPT_STACK_FORWARD: {
-			script->stackPointer -= parameter;
-			return true;
-		}
+				script->stack[script->framePointer + parameter - 1] =STACK_POP();
+				continue;
+			}
 
-		case SCRIPT_FUNCTION: {
-			parameter &= 0xFF;
+			SCRIPT_OPCODE(SCRIPT_STACK_REWIND): {
+				script->stackPointer += parameter;
+				continue;
+			}
 
-			if (parameter >= SCRIPT_FUNCTIONS_COUNT || scriptInfo->functions[parameter] == NULL) {
-				Script_Error("Unknown function %d for opcode 14", parameter);
-				return false;
+			SCRIPT_OPCODE(SCRIPT_STACK_FORWARD): {
+				script->stackPointer -= parameter;
+				continue;
 			}
 
-			script->returnValue = scriptInfo->functions[parameter](script);
-			return true;
-		}
+			SCRIPT_OPCODE(SCRIPT_FUNCTION): {
+				if (parameter >= SCRIPT_FUNCTIONS_COUNT || scriptInfo->functions[parameter] == NULL) {
+					Script_Error("Unknown function %d for opcode 14", parameter);
+					return false;
+				}
 
-		case SCRIPT_JUMP_NE: {
-			STACK_PEEK(1); if (script->script == NULL) return false;
+				if (g_scriptProfile) {
+					uint32 start = Timer_GetTimeMicro();
 
-			if (STACK_POP() != 0) return true;
+					script->returnValue = scriptInfo->functions[parameter](script);
+					ScriptProfile_Function(scriptInfo, location, (uint8)parameter, start);
+					continue;
+				}
 
-			script->script = scriptInfo->start + (parameter & 0x7FFF);
-			return true;
-		}
+				script->returnValue = scriptInfo->functions[parameter](script);
+				continue;
+			}
+
+			SCRIPT_OPCODE(SCRIPT_JUMP_NE): {
+				STACK_PEEK(1); if (script->script == NULL) return false;
 
-		case SCRIPT_UNARY: {
-			if (parameter == 0) { /* STACK = !STACK */
-				STACK_PUSH((STACK_POP() == 0) ? 1 : 0);
-				return true;
+				if (STACK_POP() != 0) continue;
+
+				script->script = scriptInfo->start + parameter;
+				continue;
 			}
-			if (parameter == 1) { /* STACK = -STACK */
-				STACK_PUSH(-STACK_POP());
-				return true;
+
+			SCRIPT_OPCODE(SCRIPT_UNARY): {
+				if (parameter == 0) { /* STACK = !STACK */
+					STACK_PUSH((STACK_POP() == 0) ? 1 : 0);
+					continue;
+				}
+				if (parameter == 1) { /* STACK = -STACK */
+					STACK_PUSH(-STACK_POP());
+					continue;
+				}
+				if (parameter == 2) { /* STACK = ~STACK */
+					STACK_PUSH(~STACK_POP());
+					continue;
+				}
+
+				Script_Error("Unknown parameter %d for opcode 16", parameter);
+				script->script = NULL;
+				return false;
 			}
-			if (parameter == 2) { /* STACK = ~STACK */
-				STACK_PUSH(~STACK_POP());
-				return true;
+
+			SCRIPT_OPCODE(SCRIPT_BINARY): {
+				int16 right = STACK_POP();
+				int16 left  = STACK_POP();
+
+				switch (parameter) {
+					case 0:  STACK_PUSH((left && right) ? 1 : 0); break; /* left && right */
+					case 1:  STACK_PUSH((left || right) ? 1 : 0); break; /* left || right */
+					case 2:  STACK_PUSH((left == right) ? 1 : 0); break; /* left == right */
+					case 3:  STACK_PUSH((left != right) ? 1 : 0); break; /* left != right */
+					case 4:  STACK_PUSH((left <  right) ? 1 : 0); break; /* left <  right */
+					case 5:  STACK_PUSH((left <= right) ? 1 : 0); break; /* left <= right */
+					case 6:  STACK_PUSH((left >  right) ? 1 : 0); break; /* left >  right */
+					case 7:  STACK_PUSH((left >= right) ? 1 : 0); break; /* left >= right */
+					case 8:  STACK_PUSH( left +  right         ); break; /* left +  right */
+					case 9:  STACK_PUSH( left -  right         ); break; /* left -  right */
+					case 10: STACK_PUSH( left *  right         ); break; /* left *  right */
+					case 11: STACK_PUSH( left /  right         ); break; /* left /  right */
+					case 12: STACK_PUSH( left >> right         ); break; /* left >> right */
+					case 13: STACK_PUSH( left << right         ); break; /* left << right */
+					case 14: STACK_PUSH( left &  right         ); break; /* left &  right */
+					case 15: STACK_PUSH( left |  right         ); break; /* left |  right */
+					case 16: STACK_PUSH( left %  right         ); break; /* left %  right */
+					case 17: STACK_PUSH( left ^  right         ); break; /* left ^  right */
+
+					default:
+						Script_Error("Unknown parameter %d for opcode 17", parameter);
+						script->script = NULL;
+						return false;
+				}
+
+				continue;
 			}
 
-			Script_Error("Unknown parameter %d for opcode 16", parameter);
-			script->script = NULL;
-			return false;
-		}
+			SCRIPT_OPCODE(SCRIPT_RETURN): {
+				STACK_PEEK(2); if (script->script == NULL) return false;
 
-		case SCRIPT_BINARY: {
-			int16 right = STACK_POP();
-			int16 left  = STACK_POP();
-
-			switch (parameter) {
-				case 0:  STACK_PUSH((left && right) ? 1 : 0); break; /* left && right */
-				case 1:  STACK_PUSH((left || right) ? 1 : 0); break; /* left || right */
-				case 2:  STACK_PUSH((left == right) ? 1 : 0); break; /* left == right */
-				case 3:  STACK_PUSH((left != right) ? 1 : 0); break; /* left != right */
-				case 4:  STACK_PUSH((left <  right) ? 1 : 0); break; /* left <  right */
-				case 5:  STACK_PUSH((left <= right) ? 1 : 0); break; /* left <= right */
-				case 6:  STACK_PUSH((left >  right) ? 1 : 0); break; /* left >  right */
-				case 7:  STACK_PUSH((left >= right) ? 1 : 0); break; /* left >= right */
-				case 8:  STACK_PUSH( left +  right         ); break; /* left +  right */
-				case 9:  STACK_PUSH( left -  right         ); break; /* left -  right */
-				case 10: STACK_PUSH( left *  right         ); break; /* left *  right */
-				case 11: STACK_PUSH( left /  right         ); break; /* left /  right */
-				case 12: STACK_PUSH( left >> right         ); break; /* left >> right */
-				case 13: STACK_PUSH( left << right         ); break; /* left << right */
-				case 14: STACK_PUSH( left &  right         ); break; /* left &  right */
-				case 15: STACK_PUSH( left |  right         ); break; /* left |  right */
-				case 16: STACK_PUSH( left %  right         ); break; /* left %  right */
-				case 17: STACK_PUSH( left ^  right         ); break; /* left ^  right */
-
-				default:
-					Script_Error("Unknown parameter %d for opcode 17", parameter);
-					script->script = NULL;
-					return false;
+				script->returnValue = STACK_POP();
+				script->script = scriptInfo->start + STACK_POP();
+
+				script->isSubroutine = 0;
+				continue;
 			}
 
-			return true;
+			SCRIPT_OPCODE_INVALID:
+				Script_Error("Unknown opcode %d", instruction->opcode);
+				script->script = NULL;
+				return false;
 		}
-		case SCRIPT_RETURN: {
-			STACK_PEEK(2); if (script->script == NULL) return false;
+	}
 
-			script->returnValue = STACK_POP();
-			script->script = scriptInfo->start + STACK_POP();
+	return true;
+}
 
-			script->isSubroutine = 0;
-			return true;
-		}
+#undef SCRIPT_DISPATCH
+#undef SCRIPT_OPCODE
+#undef SCRIPT_OPCODE_INVALID
 
-		default:
-			Script_Error("Unknown opcode %d", opcode);
-			script->script = NULL;
-			return false;
-	}
+/**
+ * Run the next opcode of a script.
+ *
+ * @param script The script engine to run.
+ * @return Returns false if and only if there was an scripting error, like
+ *   invalid opcode.
+ */
+bool Script_Run(ScriptEngine *script)
+{
+	return Script_RunOpcodes(script, 1, false);
 }
 
 /**
@@ -601,9 +701,12 @@ void Script_ClearInfo(ScriptInfo *scriptInfo)
 		free(scriptInfo->start);
 	}
 
+	free(scriptInfo->instructions);
+
 	scriptInfo->text = NULL;
 	scriptInfo->offsets = NULL;
 	scriptInfo->start = NULL;
+	scriptInfo->instructions = NULL;
 }
 
 /**
@@ -692,5 +795,11 @@ uint16 Script_LoadFromFile(const char *filename, ScriptInfo *scriptInfo, const S
 
 	ChunkFile_Close(index);
 
+	/* Decode all instructions once; any word can be jumped to, so decode from every location */
+	scriptInfo->instructions = malloc(scriptInfo->startCount * sizeof(ScriptInstruction));
+	for (i = 0; i < (int16)scriptInfo->startCount; i++) {
+		Script_DecodeInstruction(scriptInfo, (uint16)i, &scriptInfo->instructions[i]);
+	}
+
 	return total & 0xFFFF;
 }
@@ -51,6 +51,15 @@ typedef struct ScriptEngine {
 
 typedef uint16 (*ScriptFunction)(ScriptEngine *script);
 
+/**
+ * A script instruction, decoded from the big-endian words in ScriptInfo->start.
+ */
+typedef struct ScriptInstruction {
+	uint16 parameter;                                       /*!< The parameter of the instruction. */
+	uint8  opcode;                                          /*!< The opcode of the instruction, one of ScriptCommand. */
+	uint8  length;                                          /*!< The length of the instruction, in words. */
+} ScriptInstruction;
+
 /**
  * A ScriptInfo as stored in the memory.
  */
@@ -62,6 +71,7 @@ typedef struct ScriptInfo {
 	uint16 startCount;                                      /*!< Number of words in start. */
 	const ScriptFunction *functions;                        /*!< Pointer to an array of functions pointers which scripts with this scriptInfo can call. */
 	uint16 isAllocated;                                     /*!< Memory has been allocated on load. */
+	ScriptInstruction *instructions;                        /*!< Per word in start, the instruction when starting at that word. */
 } ScriptInfo;
 
 #ifdef _DEBUG
@@ -74,11 +84,6 @@ typedef struct ScriptInfo {
 #define STACK_PEEK(position) Script_Stack_Peek(script, position)
 #endif
 
-extern struct Object *g_scriptCurrentObject;
-extern struct Structure *g_scriptCurrentStructure;
-extern struct Unit *g_scriptCurrentUnit;
-extern struct Team *g_scriptCurrentTeam;
-
 extern ScriptInfo *g_scriptStructure;
 extern ScriptInfo *g_scriptTeam;
 extern ScriptInfo *g_scriptUnit;
@@ -91,6 +96,7 @@ extern void Script_Reset(ScriptEngine *script, ScriptInfo *scriptInfo);
 extern void Script_Load(ScriptEngine *script, uint8 typeID);
 extern bool Script_IsLoaded(ScriptEngine *script);
 extern bool Script_Run(ScriptEngine *script);
+extern bool Script_RunOpcodes(ScriptEngine *script, uint16 count, bool untilDelay);
 extern void Script_LoadAsSubroutine(ScriptEngine *script, uint8 typeID);
 extern void Script_ClearInfo(ScriptInfo *scriptInfo);
 extern uint16 Script_LoadFromFile(const char *filename, ScriptInfo *scriptInfo, const ScriptFunction *functions, uint8 *data);
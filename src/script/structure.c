@@ -2,6 +2,7 @@
 
 #include <stdio.h>
 #include "types.h"
+#include "../os/math.h"
 
 #include "script.h"
 
@@ -17,6 +18,7 @@
 #include "../pool/unit.h"
 #include "../scenario.h"
 #include "../sprites.h"
+#include "../state.h"
 #include "../string.h"
 #include "../structure.h"
 #include "../table/strings.h"
@@ -325,6 +327,41 @@ uint16 Script_Structure_FindTargetUnit(ScriptEngine *script)
 		position = s->o.position;
 	}
 
+	/* ENHANCEMENT -- Only look at the Units within range, instead of at all Units on the map. */
+	if (g_dune2_enhanced) {
+		Unit *units[UNIT_INDEX_MAX];
+		uint16 count;
+		uint16 i;
+
+		count = Unit_FindInRange(position, (uint16)min(targetRange * 3, 0xFFFF), units);
+
+		for (i = 0; i < count; i++) {
+			uint16 distance;
+			Unit *uf = units[i];
+
+			if (House_AreAllied(s->o.houseID, Unit_GetHouseID(uf))) continue;
+
+			if (uf->o.type != UNIT_ORNITHOPTER) {
+				if ((uf->o.seenByHouses & (1 << s->o.houseID)) == 0) continue;
+			}
+
+			distance = Tile_GetDistance(uf->o.position, position);
+			if (distance >= distanceCurrent) continue;
+
+			if (uf->o.type == UNIT_ORNITHOPTER) {
+				if (distance > targetRange * 3) continue;
+			} else {
+				if (distance > targetRange) continue;
+			}
+
+			distanceCurrent = distance;
+			u = uf;
+		}
+
+		if (u == NULL) return IT_NONE;
+		return Tools_Index_Encode(u->o.index, IT_UNIT);
+	}
+
 	while (true) {
 		uint16 distance;
 		Unit *uf;
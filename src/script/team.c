@@ -11,6 +11,7 @@
 #include "../pool/team.h"
 #include "../pool/pool.h"
 #include "../pool/unit.h"
+#include "../state.h"
 #include "../team.h"
 #include "../tile.h"
 #include "../tools.h"
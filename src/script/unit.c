@@ -13,6 +13,7 @@
 #include "../audio/sound.h"
 #include "../config.h"
 #include "../explosion.h"
+#include "../flowfield.h"
 #include "../gui/gui.h"
 #include "../house.h"
 #include "../map.h"
@@ -21,6 +22,7 @@
 #include "../pool/pool.h"
 #include "../pool/structure.h"
 #include "../scenario.h"
+#include "../state.h"
 #include "../structure.h"
 #include "../table/strings.h"
 #include "../tools.h"
@@ -62,6 +64,7 @@ uint16 Script_Unit_RandomSoldier(ScriptEngine *script)
 	if (nu == NULL) return 0;
 
 	nu->deviated = u->deviated;
+	Unit_UpdateHouseList(nu);
 
 	Unit_SetAction(nu, STACK_PEEK(1));
 
@@ -1171,6 +1174,226 @@ static bool Script_Unit_Pathfinder_Connect(uint16 packedDst, Pathfinder_Data *da
 	return false;
 }
 
+/* The scratch space of a search is per thread, as games can run side by side */
+static THREAD_LOCAL uint16 s_pathfinderGeneration = 0;      /*!< Stamp of the current A* search; tiles with another stamp are unvisited. */
+static THREAD_LOCAL uint16 s_pathfinderVisited[64 * 64];          /*!< Per tile, the search stamp it was last visited in. */
+static THREAD_LOCAL uint32 s_pathfinderCost[64 * 64];             /*!< Per tile, the cost of the best route found to it. */
+static THREAD_LOCAL uint32 s_pathfinderEstimate[64 * 64];         /*!< Per tile, the cost plus the heuristic to the destination. */
+static THREAD_LOCAL uint8  s_pathfinderDirection[64 * 64];        /*!< Per tile, the direction we entered it from. */
+static THREAD_LOCAL uint16 s_pathfinderHeapIndex[64 * 64];        /*!< Per tile, the index in the open list, or 0xFFFF if closed. */
+static THREAD_LOCAL uint16 s_pathfinderHeap[64 * 64];             /*!< The open list, as binary heap on the estimate. */
+static THREAD_LOCAL uint16 s_pathfinderHeapSize;                  /*!< Amount of tiles in the open list. */
+static THREAD_LOCAL uint8  s_pathfinderRoute[64 * 64];            /*!< Scratch buffer to reverse the found route in. */
+
+/**
+ * Move a tile in the open list up until the heap is valid again.
+ * @param index The index in the open list to move up.
+ */
+static void Script_Unit_Pathfinder_HeapUp(uint16 index)
+{
+	uint16 packed = s_pathfinderHeap[index];
+
+	while (index != 0) {
+		uint16 parent = (index - 1) / 2;
+
+		if (s_pathfinderEstimate[s_pathfinderHeap[parent]] <= s_pathfinderEstimate[packed]) break;
+
+		s_pathfinderHeap[index] = s_pathfinderHeap[parent];
+		s_pathfinderHeapIndex[s_pathfinderHeap[index]] = index;
+		index = parent;
+	}
+
+	s_pathfinderHeap[index] = packed;
+	s_pathfinderHeapIndex[packed] = index;
+}
+
+/**
+ * Remove the tile with the lowest estimate from the open list.
+ * @return The packed tile removed from the open list.
+ */
+static uint16 Script_Unit_Pathfinder_HeapPop(void)
+{
+	uint16 res = s_pathfinderHeap[0];
+	uint16 packed;
+	uint16 index = 0;
+
+	s_pathfinderHeapIndex[res] = 0xFFFF;
+	if (--s_pathfinderHeapSize == 0) return res;
+
+	packed = s_pathfinderHeap[s_pathfinderHeapSize];
+
+	while (true) {
+		uint16 child = index * 2 + 1;
+
+		if (child >= s_pathfinderHeapSize) break;
+		if (child + 1 < s_pathfinderHeapSize && s_pathfinderEstimate[s_pathfinderHeap[child + 1]] < s_pathfinderEstimate[s_pathfinderHeap[child]]) child++;
+		if (s_pathfinderEstimate[packed] <= s_pathfinderEstimate[s_pathfinderHeap[child]]) break;
+
+		s_pathfinderHeap[index] = s_pathfinderHeap[child];
+		s_pathfinderHeapIndex[s_pathfinderHeap[index]] = index;
+		index = child;
+	}
+
+	s_pathfinderHeap[index] = packed;
+	s_pathfinderHeapIndex[packed] = index;
+
+	return res;
+}
+
+/**
+ * Get the lowest score the current unit can have for entering any tile. This
+ *  is used to keep the A* heuristic admissible.
+ * @return The lowest score, at least 1.
+ */
+static uint16 Script_Unit_Pathfinder_GetMinimalScore(void)
+{
+	const UnitInfo *ui;
+	uint16 res = 0;
+	uint8 i;
+
+	if (g_scriptCurrentUnit == NULL) return 1;
+
+	ui = &g_table_unitInfo[g_scriptCurrentUnit->o.type];
+
+	for (i = 0; i < LST_MAX; i++) {
+		uint16 speed = g_table_landscapeInfo[i].movementSpeed[ui->movementType] * ui->movingSpeedFactor / 256;
+		if (speed > res) res = speed;
+	}
+
+	res = (res > 255) ? 0 : (res ^ 0xFF);
+	return max(res, 1);
+}
+
+/**
+ * Get the amount of steps needed between two tiles if every tile could be
+ *  entered. Multiplied by the minimal score, this never overestimates.
+ * @param packedFrom The tile to start from.
+ * @param packedTo The tile to go to.
+ * @return The longest distance between the X or Y coordinates.
+ */
+static uint16 Script_Unit_Pathfinder_GetSteps(uint16 packedFrom, uint16 packedTo)
+{
+	uint16 dx = abs(Tile_GetPackedX(packedFrom) - Tile_GetPackedX(packedTo));
+	uint16 dy = abs(Tile_GetPackedY(packedFrom) - Tile_GetPackedY(packedTo));
+
+	return max(dx, dy);
+}
+
+/**
+ * Find the cheapest path between two points, with an A* search over the
+ *  whole map. The scores are the same as the original pathfinder uses. If the
+ *  destination can't be reached, the route goes to the tile closest to it.
+ *
+ * @param packedSrc The start point.
+ * @param packedDst The end point.
+ * @param buffer The buffer to store the route in.
+ * @param bufferSize The size of the buffer.
+ * @return A struct with information about the found route.
+ */
+static Pathfinder_Data Script_Unit_Pathfinder_AStar(uint16 packedSrc, uint16 packedDst, void *buffer, int16 bufferSize)
+{
+	Pathfinder_Data res;
+	uint16 minimalScore;
+	uint16 packedBest;
+	uint16 distanceBest;
+	uint16 packed;
+	uint16 routeSize;
+	uint16 i;
+
+	res.packed    = packedSrc;
+	res.score     = 0;
+	res.routeSize = 0;
+	res.buffer    = buffer;
+
+	bufferSize--;
+
+	if (++s_pathfinderGeneration == 0) {
+		memset(s_pathfinderVisited, 0, sizeof(s_pathfinderVisited));
+		s_pathfinderGeneration = 1;
+	}
+
+	minimalScore = Script_Unit_Pathfinder_GetMinimalScore();
+
+	s_pathfinderVisited[packedSrc]   = s_pathfinderGeneration;
+	s_pathfinderCost[packedSrc]      = 0;
+	s_pathfinderEstimate[packedSrc]  = Script_Unit_Pathfinder_GetSteps(packedSrc, packedDst) * minimalScore;
+	s_pathfinderHeap[0]              = packedSrc;
+	s_pathfinderHeapIndex[packedSrc] = 0;
+	s_pathfinderHeapSize             = 1;
+
+	packedBest   = packedSrc;
+	distanceBest = Script_Unit_Pathfinder_GetSteps(packedSrc, packedDst);
+
+	while (s_pathfinderHeapSize != 0) {
+		uint16 packedCur;
+		uint16 distance;
+		uint8 direction;
+
+		packedCur = Script_Unit_Pathfinder_HeapPop();
+
+		distance = Script_Unit_Pathfinder_GetSteps(packedCur, packedDst);
+		if (distance < distanceBest || (distance == distanceBest && s_pathfinderCost[packedCur] < s_pathfinderCost[packedBest])) {
+			packedBest   = packedCur;
+			distanceBest = distance;
+		}
+		if (packedCur == packedDst) break;
+
+		for (direction = 0; direction < 8; direction++) {
+			uint16 packedNext;
+			uint16 x, y;
+			int16 score;
+			uint32 cost;
+
+			x = Tile_GetPackedX(packedCur);
+			y = Tile_GetPackedY(packedCur);
+			if ((x == 0 && direction >= 5) || (x == 63 && direction >= 1 && direction <= 3)) continue;
+			if ((y == 0 && (direction <= 1 || direction == 7)) || (y == 63 && direction >= 3 && direction <= 5)) continue;
+
+			packedNext = packedCur + s_mapDirection[direction];
+
+			if (s_pathfinderVisited[packedNext] == s_pathfinderGeneration && s_pathfinderHeapIndex[packedNext] == 0xFFFF) continue;
+
+			/* Like the original pathfinder, always allow stepping on the destination itself */
+			score = Script_Unit_Pathfind_GetScore(packedNext, direction);
+			if (score > 255 && packedNext != packedDst) continue;
+			if (score > 255 || score < (int16)minimalScore) score = minimalScore;
+
+			cost = s_pathfinderCost[packedCur] + score;
+
+			if (s_pathfinderVisited[packedNext] == s_pathfinderGeneration) {
+				if (cost >= s_pathfinderCost[packedNext]) continue;
+			} else {
+				s_pathfinderVisited[packedNext]   = s_pathfinderGeneration;
+				s_pathfinderHeapIndex[packedNext] = s_pathfinderHeapSize;
+				s_pathfinderHeap[s_pathfinderHeapSize++] = packedNext;
+			}
+
+			s_pathfinderCost[packedNext]      = cost;
+			s_pathfinderEstimate[packedNext]  = cost + Script_Unit_Pathfinder_GetSteps(packedNext, packedDst) * minimalScore;
+			s_pathfinderDirection[packedNext] = direction;
+			Script_Unit_Pathfinder_HeapUp(s_pathfinderHeapIndex[packedNext]);
+		}
+	}
+
+	/* Walk back from the best tile to build the route in reverse */
+	routeSize = 0;
+	for (packed = packedBest; packed != packedSrc; packed -= s_mapDirection[s_pathfinderDirection[packed]]) {
+		s_pathfinderRoute[routeSize++] = s_pathfinderDirection[packed];
+	}
+
+	/* Only keep as much of the start of the route as fits in the buffer */
+	packed = packedSrc;
+	for (i = 0; i < routeSize && i < bufferSize; i++) {
+		res.buffer[i] = s_pathfinderRoute[routeSize - i - 1];
+		packed += s_mapDirection[res.buffer[i]];
+	}
+	res.routeSize = i;
+	res.buffer[res.routeSize++] = 0xFF;
+	res.score = (int16)min(s_pathfinderCost[packed], 0x7FFF);
+
+	return res;
+}
+
 /**
  * Try to find a path between two points.
  *
@@ -1185,6 +1408,10 @@ static Pathfinder_Data Script_Unit_Pathfinder(uint16 packedSrc, uint16 packedDst
 	uint16 packedCur;
 	Pathfinder_Data res;
 
+	/* ENHANCEMENT -- The original pathfinder walks straight to the destination and follows walls
+	 *  for at most 100 tiles when blocked, which often fails around concave rock. */
+	if (g_dune2_enhanced) return Script_Unit_Pathfinder_AStar(packedSrc, packedDst, buffer, bufferSize);
+
 	res.packed    = packedSrc;
 	res.score     = 0;
 	res.routeSize = 0;
@@ -1285,6 +1512,46 @@ static Pathfinder_Data Script_Unit_Pathfinder(uint16 packedSrc, uint16 packedDst
 	return res;
 }
 
+/**
+ * Build the start of a route by following the flow field towards the
+ *  destination, as long as the current unit can enter the tiles on it.
+ *
+ * @param packedSrc The start point.
+ * @param packedDst The end point.
+ * @param route The route to fill.
+ * @param routeSize The size of the route.
+ * @return True if a route was found.
+ */
+static bool Script_Unit_Pathfinder_FlowField(uint16 packedSrc, uint16 packedDst, uint8 *route, uint8 routeSize)
+{
+	const uint8 *field;
+	uint16 packed;
+	uint8 i;
+
+	/* Saboteurs can enter enemy walls, which depends on their House; they search their own route */
+	if (g_scriptCurrentUnit->o.type == UNIT_SABOTEUR) return false;
+
+	field = FlowField_Get(packedDst, g_scriptCurrentUnit->o.type);
+	if (field == NULL) return false;
+
+	packed = packedSrc;
+	for (i = 0; i < routeSize; i++) {
+		uint8 direction = field[packed];
+
+		if (direction == 0xFF) break;
+
+		packed += s_mapDirection[direction];
+		if (packed != packedDst && Script_Unit_Pathfind_GetScore(packed, direction) > 255) break;
+
+		route[i] = direction;
+	}
+
+	if (i == 0) return false;
+	if (i < routeSize) route[i] = 0xFF;
+
+	return true;
+}
+
 /**
  * Calculate the route to a tile.
  *
@@ -1318,9 +1585,12 @@ uint16 Script_Unit_CalculateRoute(ScriptEngine *script)
 		Pathfinder_Data res;
 		uint8 buffer[42];
 
-		res = Script_Unit_Pathfinder(packedSrc, packedDst, buffer, 40);
+		/* ENHANCEMENT -- Units moving to the same tile share a flow field, instead of each searching a route. */
+		if (!g_dune2_enhanced || !Script_Unit_Pathfinder_FlowField(packedSrc, packedDst, u->route, 14)) {
+			res = Script_Unit_Pathfinder(packedSrc, packedDst, buffer, 40);
 
-		memcpy(u->route, res.buffer, min(res.routeSize, 14));
+			memcpy(u->route, res.buffer, min(res.routeSize, 14));
+		}
 
 		if (u->route[0] == 0xFF) {
 			u->targetMove = 0;
@@ -1696,9 +1966,11 @@ uint16 Script_Unit_IsValidDestination(ScriptEngine *script)
 			if (u->o.linkedID == 0xFF) return 1;
 			u2 = Unit_Get_ByIndex(u->o.linkedID);
 			u2->o.position = Tools_Index_GetTile(encoded);
+			Unit_Grid_Update(u2);
 			if (!Unit_IsTileOccupied(u2)) return 0;
 			u2->o.position.x = 0xFFFF;
 			u2->o.position.y = 0xFFFF;
+			Unit_Grid_Update(u2);
 			return 1;
 
 		case IT_STRUCTURE: {
@@ -22,6 +22,7 @@
 #include "input/mouse.h"
 #include "gui/gui.h"
 #include "script/script.h"
+#include "state.h"
 #include "string.h"
 #include "tile.h"
 
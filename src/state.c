@@ -0,0 +1,169 @@
+/** @file src/state.c Game state routines. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+
+#include "state.h"
+
+static GameState s_gameState;                               /*!< The GameState used when nothing else is activated. */
+THREAD_LOCAL GameState *g_gameState = &s_gameState;         /*!< The active GameState (per thread). */
+
+/**
+ * Allocate a new GameState, in the same state as at startup.
+ *
+ * @return The new GameState, or NULL if there was no memory for it.
+ */
+GameState *GameState_Allocate(void)
+{
+	GameState *state;
+
+	state = malloc(sizeof(GameState));
+	if (state == NULL) return NULL;
+
+	GameState_Reset(state);
+
+	return state;
+}
+
+/**
+ * Free a GameState allocated with GameState_Allocate. If it is the active
+ *  GameState, the startup GameState is activated instead.
+ *
+ * @param state The GameState to free.
+ */
+void GameState_Free(GameState *state)
+{
+	if (state == NULL || state == &s_gameState) return;
+
+	if (state == g_gameState) GameState_Activate(&s_gameState);
+
+	free(state);
+}
+
+/**
+ * Reset a GameState to the state at startup, with empty pools.
+ *
+ * @param state The GameState to reset.
+ */
+void GameState_Reset(GameState *state)
+{
+	GameState *old = g_gameState;
+
+	memset(state, 0, sizeof(GameState));
+
+	state->scenarioID    = 1;
+	state->playerHouseID = HOUSE_INVALID;
+	state->activeAction  = 0xFFFF;
+
+	/* The pools are initialized by their own routines, which work on the active GameState */
+	g_gameState = state;
+
+	House_Init();
+	Structure_Init();
+	Team_Init();
+	Unit_Init();
+
+	g_gameState = old;
+}
+
+/**
+ * Move a pointer into one GameState to the same place in another GameState.
+ *  Pointers to anything outside the source GameState are left alone.
+ *
+ * @param dst The GameState to point into.
+ * @param src The GameState the pointer points into.
+ * @param ptr The pointer to move.
+ * @return The moved pointer.
+ */
+static void *GameState_Relocate(GameState *dst, const GameState *src, const void *ptr)
+{
+	const uint8 *p = (const uint8 *)ptr;
+
+	if (p < (const uint8 *)src || p >= (const uint8 *)(src + 1)) return (void *)ptr;
+
+	return (uint8 *)dst + (p - (const uint8 *)src);
+}
+
+/**
+ * Copy a GameState into another one. Everything is copied in one go; only
+ *  the pointers inside the GameState (find arrays, player House, active
+ *  Unit, ..) are moved afterwards to point into the copy. This makes it cheap
+ *  enough to snapshot the game every tick.
+ *
+ * @param dst The GameState to copy into.
+ * @param src The GameState to copy.
+ */
+void GameState_Copy(GameState *dst, const GameState *src)
+{
+	uint16 i;
+
+	if (dst == src) return;
+
+	memcpy(dst, src, sizeof(GameState));
+
+	for (i = 0; i < HOUSE_INDEX_MAX; i++) dst->houseFindArray[i] = GameState_Relocate(dst, src, dst->houseFindArray[i]);
+	for (i = 0; i < STRUCTURE_INDEX_MAX_SOFT; i++) dst->structureFindArray[i] = GameState_Relocate(dst, src, dst->structureFindArray[i]);
+	for (i = 0; i < TEAM_INDEX_MAX; i++) dst->teamFindArray[i] = GameState_Relocate(dst, src, dst->teamFindArray[i]);
+	for (i = 0; i < UNIT_INDEX_MAX; i++) dst->unitFindArray[i] = GameState_Relocate(dst, src, dst->unitFindArray[i]);
+
+	dst->playerHouse            = GameState_Relocate(dst, src, dst->playerHouse);
+	dst->unitActive             = GameState_Relocate(dst, src, dst->unitActive);
+	dst->unitHouseMissile       = GameState_Relocate(dst, src, dst->unitHouseMissile);
+	dst->unitSelected           = GameState_Relocate(dst, src, dst->unitSelected);
+	dst->structureActive        = GameState_Relocate(dst, src, dst->structureActive);
+	dst->scriptCurrentObject    = GameState_Relocate(dst, src, dst->scriptCurrentObject);
+	dst->scriptCurrentStructure = GameState_Relocate(dst, src, dst->scriptCurrentStructure);
+	dst->scriptCurrentUnit      = GameState_Relocate(dst, src, dst->scriptCurrentUnit);
+	dst->scriptCurrentTeam      = GameState_Relocate(dst, src, dst->scriptCurrentTeam);
+}
+
+/**
+ * Take a snapshot of the active GameState.
+ *
+ * @param snapshot The GameState to store the snapshot in, or NULL to allocate a new one.
+ * @return The snapshot, or NULL if there was no memory for it.
+ */
+GameState *GameState_Snapshot(GameState *snapshot)
+{
+	if (snapshot == NULL) snapshot = malloc(sizeof(GameState));
+	if (snapshot == NULL) return NULL;
+
+	GameState_Copy(snapshot, g_gameState);
+
+	return snapshot;
+}
+
+/**
+ * Restore the active GameState from a snapshot. The snapshot is left
+ *  untouched, so it can be restored again.
+ *
+ * @param snapshot The snapshot to restore.
+ */
+void GameState_Restore(const GameState *snapshot)
+{
+	GameState_Copy(g_gameState, snapshot);
+
+	/* The flow-field cache is part of the snapshot, so the routes continue
+	 *  exactly as they did after the snapshot was taken */
+
+	/* The selection might be of something that does not exist in the snapshot */
+	if (g_unitSelected != NULL && !g_unitSelected->o.flags.s.used) g_unitSelected = NULL;
+	if (g_structureActive != NULL && !g_structureActive->o.flags.s.used) {
+		g_structureActive     = NULL;
+		g_structureActiveType = 0xFFFF;
+	}
+}
+
+/**
+ * Make a GameState the one all routines work on.
+ *
+ * @param state The GameState to activate.
+ */
+void GameState_Activate(GameState *state)
+{
+	if (state == NULL || state == g_gameState) return;
+
+	g_gameState = state;
+}
@@ -0,0 +1,216 @@
+/** @file src/state.h Game state definitions. */
+
+#ifndef STATE_H
+#define STATE_H
+
+#include "animation.h"
+#include "explosion.h"
+#include "flowfield.h"
+#include "house.h"
+#include "map.h"
+#include "scenario.h"
+#include "structure.h"
+#include "team.h"
+#include "timerwheel.h"
+#include "unit.h"
+#include "pool/house.h"
+#include "pool/pool.h"
+#include "pool/structure.h"
+#include "pool/team.h"
+#include "pool/unit.h"
+
+/**
+ * All the state of a single game (map, pools, houses, scripts, random
+ *  generators and timers). Only the GameState g_gameState points to is used;
+ *  by pointing it to another GameState several games can be run alternately
+ *  in the same process.
+ *
+ * The variables the rest of the code uses (g_map, g_unitFindArray, ..) are
+ *  defined to the fields of the active GameState, so they can still be used
+ *  as before.
+ */
+typedef struct GameState {
+	/* Map */
+	Tile   map[64 * 64];                                    /*!< All map data. */
+	uint16 mapTileID[64 * 64];                              /*!< Per tile, the tileID of the ground. */
+	uint8  dirtyMinimap[512];                               /*!< Dirty tiles of the minimap (must be rendered again). */
+	uint8  dirtyViewport[512];                              /*!< Dirty tiles of the viewport (must be rendered again). */
+	uint16 changedTilesCount;                               /*!< Number of changed tiles in changedTiles. */
+	uint16 changedTiles[200];                               /*!< Array of positions of changed tiles. */
+	uint8  changedTilesMap[512];                            /*!< Bit array of changed tiles, in order not to loose changes. */
+
+	/* House pool */
+	House  houseArray[HOUSE_INDEX_MAX];                     /*!< All Houses. */
+	House *houseFindArray[HOUSE_INDEX_MAX];                 /*!< The allocated Houses. */
+	uint16 houseFindCount;                                  /*!< The amount of allocated Houses. */
+
+	/* Structure pool */
+	Structure  structureArray[STRUCTURE_INDEX_MAX_HARD];    /*!< All Structures. */
+	Structure *structureFindArray[STRUCTURE_INDEX_MAX_SOFT]; /*!< The allocated Structures. */
+	uint16     structureFindCount;                          /*!< The amount of allocated Structures. */
+	uint8      structureFree[(STRUCTURE_INDEX_MAX_SOFT + 7) / 8]; /*!< Per Structure, a bit which is set if the index is not in use. */
+	uint16     structureFindPosition[STRUCTURE_INDEX_MAX_SOFT]; /*!< Per Structure, its position in structureFindArray. */
+	uint8      structureHouseList[STRUCTURE_INDEX_MAX_SOFT]; /*!< Per Structure, the House list it is in. */
+	PoolList   structureHouses[HOUSE_MAX];                  /*!< Per House, the Structures of that House. */
+	PoolLink   structureHouseLinks[STRUCTURE_INDEX_MAX_SOFT]; /*!< Per Structure, the links in its House list. */
+	PoolList   structureTypes[STRUCTURE_MAX];               /*!< Per StructureType, the Structures of that type. */
+	PoolLink   structureTypeLinks[STRUCTURE_INDEX_MAX_SOFT]; /*!< Per Structure, the links in its type list. */
+
+	/* Team pool */
+	Team     teamArray[TEAM_INDEX_MAX];                     /*!< All Teams. */
+	Team    *teamFindArray[TEAM_INDEX_MAX];                 /*!< The allocated Teams. */
+	uint16   teamFindCount;                                 /*!< The amount of allocated Teams. */
+	uint16   teamFindPosition[TEAM_INDEX_MAX];              /*!< Per Team, its position in teamFindArray. */
+	PoolList teamHouses[HOUSE_MAX];                         /*!< Per House, the Teams of that House. */
+	PoolLink teamHouseLinks[TEAM_INDEX_MAX];                /*!< Per Team, the links in its House list. */
+
+	/* Unit pool */
+	Unit     unitArray[UNIT_INDEX_MAX];                     /*!< All Units. */
+	Unit    *unitFindArray[UNIT_INDEX_MAX];                 /*!< The allocated Units. */
+	uint16   unitFindCount;                                 /*!< The amount of allocated Units. */
+	uint8    unitFree[(UNIT_INDEX_MAX + 7) / 8];            /*!< Per Unit, a bit which is set if the index is not in use. */
+	uint16   unitFindPosition[UNIT_INDEX_MAX];              /*!< Per Unit, its position in unitFindArray. */
+	uint8    unitHouseList[UNIT_INDEX_MAX];                 /*!< Per Unit, the House list it is in. */
+	PoolList unitHouses[HOUSE_MAX];                         /*!< Per House, the Units of that House (as in Unit_GetHouseID). */
+	PoolLink unitHouseLinks[UNIT_INDEX_MAX];                /*!< Per Unit, the links in its House list. */
+	PoolList unitTypes[UNIT_MAX];                           /*!< Per UnitType, the Units of that type. */
+	PoolLink unitTypeLinks[UNIT_INDEX_MAX];                 /*!< Per Unit, the links in its type list. */
+	uint16   unitGridHead[UNIT_GRID_SIZE * UNIT_GRID_SIZE]; /*!< Per grid cell, the index of the first Unit in it. */
+	uint16   unitGridNext[UNIT_INDEX_MAX];                  /*!< Per Unit, the index of the next Unit in the same cell. */
+	uint16   unitGridPrev[UNIT_INDEX_MAX];                  /*!< Per Unit, the index of the previous Unit in the same cell. */
+	uint16   unitGridCell[UNIT_INDEX_MAX];                  /*!< Per Unit, the cell it is in, or 0xFFFF if none. */
+	tile32   unitHotPosition[UNIT_INDEX_MAX];               /*!< Per Unit, a copy of its position, so scans don't have to touch the Unit. */
+	uint8    unitHotType[UNIT_INDEX_MAX];                   /*!< Per Unit, a copy of its type, so scans don't have to touch the Unit. */
+	uint8    unitHotNotOnMap[(UNIT_INDEX_MAX + 7) / 8];     /*!< Per Unit, a bit which is set if it is not used or not on the map. */
+
+	/* Explosions and animations */
+	Explosion explosions[EXPLOSION_MAX];                    /*!< Explosions. */
+	TimerWheel explosionWheel;                              /*!< When each Explosion has its next activity. */
+	Animation animations[ANIMATION_MAX];                    /*!< Animations. */
+	TimerWheel animationWheel;                              /*!< When each Animation has its next activity. */
+
+	/* Pathfinding */
+	FlowFieldCache flowFieldCache;                          /*!< The cached flow fields for this map. */
+
+	/* Game */
+	Scenario  scenario;                                     /*!< The scenario being played. */
+	uint16    campaignID;                                   /*!< The campaign being played. */
+	uint16    scenarioID;                                   /*!< The scenario being played. */
+	uint32    tickScenarioStart;                            /*!< The tick the scenario started in. */
+	uint32    tickGameTimeout;                              /*!< The tick the game will timeout. */
+	volatile uint32 timerGame;                              /*!< Tick counter. Increases with 1 every tick when Timer 2 is enabled. Used for game timing (units, ..). */
+	uint8     randomSeed[4];                                /*!< State of Tools_Random_256. */
+	uint32    randomLCG;                                    /*!< State of Tools_RandomLCG_Range. */
+	uint32    hintsShown1;                                  /*!< A bit-array to indicate which hints has been show already (0-31). */
+	uint32    hintsShown2;                                  /*!< A bit-array to indicate which hints has been show already (32-63). */
+	uint16    activeAction;                                 /*!< Action the controlled unit will do. */
+	uint16    selectionType;                                /*!< The SelectionType of the player. */
+	int16     musicInBattle;                                /*!< 0 = no battle, 1 = fight is going on, -1 = music of fight is going on is active. */
+
+	/* Houses */
+	House    *playerHouse;                                  /*!< The House of the player. */
+	HouseType playerHouseID;                                /*!< The HouseID of the player. */
+	uint16    houseMissileCountdown;                        /*!< Countdown of the missile launched by the player. */
+	uint16    playerCredits;                                /*!< Credits shown to player as 'current'. */
+	uint16    playerCreditsNoSilo;                          /*!< Credits of the player which are not stored in a silo. */
+	uint32    tickHousePowerMaintenance;                    /*!< Indicates next time the PowerMaintenance function is executed. */
+	uint32    tickHouseHouse;                               /*!< Indicates next time the House function is executed. */
+	uint32    tickHouseStarport;                            /*!< Indicates next time the Starport function is executed. */
+	uint32    tickHouseReinforcement;                       /*!< Indicates next time the Reinforcement function is executed. */
+	uint32    tickHouseMissileCountdown;                    /*!< Indicates next time the MissileCountdown function is executed. */
+	uint32    tickHouseStarportAvailability;                /*!< Indicates next time the StarportAvailability function is executed. */
+
+	/* Structures */
+	Structure *structureActive;                             /*!< The Structure the player is placing. */
+	uint16    structureActiveType;                          /*!< The type of the Structure the player is placing, or 0xFFFF if none. */
+	uint16    structureIndex;                               /*!< The Starport the last ordered Units are delivered to. */
+	uint32    tickStructureDegrade;                         /*!< Indicates next time Degrade function is executed. */
+	uint32    tickStructureStructure;                       /*!< Indicates next time Structures function is executed. */
+	uint32    tickStructureScript;                          /*!< Indicates next time Script function is executed. */
+	uint32    tickStructurePalace;                          /*!< Indicates next time Palace function is executed. */
+
+	/* Teams */
+	uint32    tickTeamGameLoop;                             /*!< Indicates next time the GameLoop function is executed. */
+
+	/* Units */
+	Unit     *unitActive;                                   /*!< The Unit being handled. */
+	Unit     *unitHouseMissile;                             /*!< The missile launched by the player. */
+	Unit     *unitSelected;                                 /*!< The Unit selected by the player. */
+	uint16    dirtyUnitCount;                               /*!< Number of Units to redraw on the map. */
+	uint16    dirtyAirUnitCount;                            /*!< Number of air Units to redraw on the map. */
+	int16     starportAvailable[UNIT_MAX];                  /*!< Number of units of each type available at the starport. */
+	uint32    tickUnitMovement;                             /*!< Indicates next time the Movement function is executed. */
+	uint32    tickUnitRotation;                             /*!< Indicates next time the Rotation function is executed. */
+	uint32    tickUnitBlinking;                             /*!< Indicates next time the Blinking function is executed. */
+	uint32    tickUnitUnknown4;                             /*!< Indicates next time the Unknown4 function is executed. */
+	uint32    tickUnitScript;                               /*!< Indicates next time the Script function is executed. */
+	uint32    tickUnitUnknown5;                             /*!< Indicates next time the Unknown5 function is executed. */
+	uint32    tickUnitDeviation;                            /*!< Indicates next time the Deviation function is executed. */
+
+	/* Scripts */
+	Object    *scriptCurrentObject;                         /*!< The Object the running script belongs to. */
+	Structure *scriptCurrentStructure;                      /*!< The Structure the running script belongs to. */
+	Unit      *scriptCurrentUnit;                           /*!< The Unit the running script belongs to. */
+	Team      *scriptCurrentTeam;                           /*!< The Team the running script belongs to. */
+} GameState;
+
+/* The active GameState is per thread, so a worker thread can work on a
+ *  snapshot while the game thread continues. Other threads (like the timer
+ *  thread on win32) use the startup GameState. */
+extern THREAD_LOCAL GameState *g_gameState;
+
+#define g_map                       (g_gameState->map)
+#define g_mapTileID                 (g_gameState->mapTileID)
+#define g_dirtyMinimap              (g_gameState->dirtyMinimap)
+#define g_dirtyViewport             (g_gameState->dirtyViewport)
+#define g_changedTilesCount         (g_gameState->changedTilesCount)
+#define g_changedTiles              (g_gameState->changedTiles)
+#define g_changedTilesMap           (g_gameState->changedTilesMap)
+#define g_unitFindArray             (g_gameState->unitFindArray)
+#define g_unitFindCount             (g_gameState->unitFindCount)
+#define g_unitHotPosition           (g_gameState->unitHotPosition)
+#define g_unitHotType               (g_gameState->unitHotType)
+#define g_unitHotNotOnMap           (g_gameState->unitHotNotOnMap)
+#define g_flowFieldCache            (g_gameState->flowFieldCache)
+#define g_scenario                  (g_gameState->scenario)
+#define g_campaignID                (g_gameState->campaignID)
+#define g_scenarioID                (g_gameState->scenarioID)
+#define g_tickScenarioStart         (g_gameState->tickScenarioStart)
+#define g_timerGame                 (g_gameState->timerGame)
+#define g_hintsShown1               (g_gameState->hintsShown1)
+#define g_hintsShown2               (g_gameState->hintsShown2)
+#define g_activeAction              (g_gameState->activeAction)
+#define g_selectionType             (g_gameState->selectionType)
+#define g_musicInBattle             (g_gameState->musicInBattle)
+#define g_playerHouse               (g_gameState->playerHouse)
+#define g_playerHouseID             (g_gameState->playerHouseID)
+#define g_houseMissileCountdown     (g_gameState->houseMissileCountdown)
+#define g_playerCredits             (g_gameState->playerCredits)
+#define g_playerCreditsNoSilo       (g_gameState->playerCreditsNoSilo)
+#define g_tickHousePowerMaintenance (g_gameState->tickHousePowerMaintenance)
+#define g_structureActive           (g_gameState->structureActive)
+#define g_structureActiveType       (g_gameState->structureActiveType)
+#define g_structureIndex            (g_gameState->structureIndex)
+#define g_unitActive                (g_gameState->unitActive)
+#define g_unitHouseMissile          (g_gameState->unitHouseMissile)
+#define g_unitSelected              (g_gameState->unitSelected)
+#define g_dirtyUnitCount            (g_gameState->dirtyUnitCount)
+#define g_dirtyAirUnitCount         (g_gameState->dirtyAirUnitCount)
+#define g_starportAvailable         (g_gameState->starportAvailable)
+#define g_scriptCurrentObject       (g_gameState->scriptCurrentObject)
+#define g_scriptCurrentStructure    (g_gameState->scriptCurrentStructure)
+#define g_scriptCurrentUnit         (g_gameState->scriptCurrentUnit)
+#define g_scriptCurrentTeam         (g_gameState->scriptCurrentTeam)
+
+/* The index of a Unit in the pool, without reading from the Unit itself */
+#define Unit_Index(u)               ((uint16)((u) - g_gameState->unitArray))
+
+extern GameState *GameState_Allocate(void);
+extern void GameState_Free(GameState *state);
+extern void GameState_Reset(GameState *state);
+extern void GameState_Activate(GameState *state);
+extern void GameState_Copy(GameState *dst, const GameState *src);
+extern GameState *GameState_Snapshot(GameState *snapshot);
+extern void GameState_Restore(const GameState *snapshot);
+
+#endif /* STATE_H */
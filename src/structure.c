@@ -26,6 +26,7 @@
 #include "pool/unit.h"
 #include "scenario.h"
 #include "sprites.h"
+#include "state.h"
 #include "string.h"
 #include "table/strings.h"
 #include "team.h"
@@ -35,17 +36,13 @@
 #include "unit.h"
 
 
-Structure *g_structureActive = NULL;
 uint16 g_structureActivePosition = 0;
-uint16 g_structureActiveType = 0;
 
 static bool s_debugInstantBuild = false; /*!< When non-zero, constructions are almost instant. */
-static uint32 s_tickStructureDegrade   = 0; /*!< Indicates next time Degrade function is executed. */
-static uint32 s_tickStructureStructure = 0; /*!< Indicates next time Structures function is executed. */
-static uint32 s_tickStructureScript    = 0; /*!< Indicates next time Script function is executed. */
-static uint32 s_tickStructurePalace    = 0; /*!< Indicates next time Palace function is executed. */
-
-uint16 g_structureIndex;
+#define g_tickStructureDegrade   (g_gameState->tickStructureDegrade)
+#define g_tickStructureStructure (g_gameState->tickStructureStructure)
+#define g_tickStructureScript    (g_gameState->tickStructureScript)
+#define g_tickStructurePalace    (g_gameState->tickStructurePalace)
 
 /**
  * Loop over all structures, preforming various of tasks.
@@ -58,24 +55,24 @@ void GameLoop_Structure(void)
 	bool tickScript    = false;
 	bool tickPalace    = false;
 
-	if (s_tickStructureDegrade <= g_timerGame && g_campaignID > 1) {
+	if (g_tickStructureDegrade <= g_timerGame && g_campaignID > 1) {
 		tickDegrade = true;
-		s_tickStructureDegrade = g_timerGame + Tools_AdjustToGameSpeed(10800, 5400, 21600, true);
+		g_tickStructureDegrade = g_timerGame + Tools_AdjustToGameSpeed(10800, 5400, 21600, true);
 	}
 
-	if (s_tickStructureStructure <= g_timerGame || s_debugInstantBuild) {
+	if (g_tickStructureStructure <= g_timerGame || s_debugInstantBuild) {
 		tickStructure = true;
-		s_tickStructureStructure = g_timerGame + Tools_AdjustToGameSpeed(30, 15, 60, true);
+		g_tickStructureStructure = g_timerGame + Tools_AdjustToGameSpeed(30, 15, 60, true);
 	}
 
-	if (s_tickStructureScript <= g_timerGame) {
+	if (g_tickStructureScript <= g_timerGame) {
 		tickScript = true;
-		s_tickStructureScript = g_timerGame + 5;
+		g_tickStructureScript = g_timerGame + 5;
 	}
 
-	if (s_tickStructurePalace <= g_timerGame) {
+	if (g_tickStructurePalace <= g_timerGame) {
 		tickPalace = true;
-		s_tickStructurePalace = g_timerGame + 60;
+		g_tickStructurePalace = g_timerGame + 60;
 	}
 
 	find.houseID = HOUSE_INVALID;
@@ -327,15 +324,11 @@ void GameLoop_Structure(void)
 				s->o.script.delay--;
 			} else {
 				if (Script_IsLoaded(&s->o.script)) {
-					uint8 i;
-
 					/* Run the script 3 times in a row */
-					for (i = 0; i < 3; i++) {
-						if (!Script_Run(&s->o.script)) break;
-					}
+					bool success = Script_RunOpcodes(&s->o.script, 3, false);
 
 					/* ENHANCEMENT -- Dune2 aborts all other structures if one gives a script error. This doesn't seem correct */
-					if (!g_dune2_enhanced && i != 3) return;
+					if (!g_dune2_enhanced && !success) return;
 				} else {
 					Script_Reset(&s->o.script, s->o.script.scriptInfo);
 					Script_Load(&s->o.script, s->o.type);
@@ -379,7 +372,7 @@ Structure *Structure_Create(uint16 index, uint8 typeID, uint8 houseID, uint16 po
 	if (typeID >= STRUCTURE_MAX) return NULL;
 
 	si = &g_table_structureInfo[typeID];
-	s = Structure_Allocate(index, typeID);
+	s = Structure_Allocate(index, typeID, houseID);
 	if (s == NULL) return NULL;
 
 	s->o.houseID            = houseID;
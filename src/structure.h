@@ -131,11 +131,8 @@ extern const tile32  g_table_structure_layoutTileDiff[STRUCTURE_LAYOUT_MAX];
 extern const XYSize  g_table_structure_layoutSize[STRUCTURE_LAYOUT_MAX];
 extern const int16   g_table_structure_layoutTilesAround[STRUCTURE_LAYOUT_MAX][16];
 
-extern Structure *g_structureActive;
 extern uint16 g_structureActivePosition;
-extern uint16 g_structureActiveType;
 
-extern uint16 g_structureIndex;
 
 extern void GameLoop_Structure(void);
 extern uint8 Structure_StringToType(const char *name);
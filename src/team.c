@@ -11,10 +11,11 @@
 #include "pool/pool.h"
 #include "pool/team.h"
 #include "pool/house.h"
+#include "state.h"
 #include "timer.h"
 #include "tools.h"
 
-static uint32 s_tickTeamGameLoop = 0; /*!< Indicates next time the GameLoop function is executed. */
+#define g_tickTeamGameLoop (g_gameState->tickTeamGameLoop)
 
 /**
  * Loop over all teams, performing various of tasks.
@@ -23,8 +24,8 @@ void GameLoop_Team(void)
 {
 	PoolFindStruct find;
 
-	if (s_tickTeamGameLoop > g_timerGame) return;
-	s_tickTeamGameLoop = g_timerGame + (Tools_Random_256() & 7) + 5;
+	if (g_tickTeamGameLoop > g_timerGame) return;
+	g_tickTeamGameLoop = g_timerGame + (Tools_Random_256() & 7) + 5;
 
 	find.houseID = HOUSE_INVALID;
 	find.index   = 0xFFFF;
@@ -76,7 +77,7 @@ Team *Team_Create(uint8 houseID, uint8 teamActionType, uint8 movementType, uint1
 {
 	Team *t;
 
-	t = Team_Allocate(0xFFFF);
+	t = Team_Allocate(0xFFFF, houseID);
 
 	if (t == NULL) return NULL;
 	t->flags.used  = true;
@@ -10,6 +10,7 @@
 
 #include "house.h"
 #include "map.h"
+#include "state.h"
 #include "tools.h"
 
 
@@ -1,5 +1,6 @@
 /** @file src/timer.c Timer routines. */
 
+#include <stdio.h>
 #include <stdlib.h>
 #if !defined(_MSC_VER) && !defined(TOS) && !defined(__WATCOMC__)
 	#include <sys/time.h>
@@ -31,16 +32,18 @@
 #include "os/error.h"
 
 #include "timer.h"
+#include "state.h"
+#include "trace.h"
 
 
 
 volatile uint32 g_timerGUI = 0;                                      /*!< Tick counter. Increases with 1 every tick when Timer 1 is enabled. Used for GUI. */
-volatile uint32 g_timerGame = 0;                                     /*!< Tick counter. Increases with 1 every tick when Timer 2 is enabled. Used for game timing (units, ..). */
 volatile uint32 g_timerInput = 0;                                    /*!< Tick counter. Increases with 1 every tick. Used for input timing. */
 volatile uint32 g_timerSleep = 0;                                    /*!< Tick counter. Increases with 1 every tick. Used for sleeping. */
 volatile uint32 g_timerTimeout = 0;                                  /*!< Tick counter. Decreases with 1 every tick when non-zero. Used to timeout. */
 
 static uint16 s_timersActive = 0;
+static bool s_timerManual = false; /*!< If true, time only advances when the game asks for it (headless mode). */
 
 
 typedef struct TimerNode {
@@ -82,6 +85,28 @@ uint32 Timer_GetTime(void)
 #endif /* _MSC_VER */
 }
 
+/**
+ * Get the current time, with a higher precision than Timer_GetTime.
+ * @return The time in microseconds. It wraps, so only use it for differences.
+ */
+uint32 Timer_GetTimeMicro(void)
+{
+#if defined(_WIN32)
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (uint32)(counter.QuadPart * 1000000 / frequency.QuadPart);
+#elif defined(TOS) || defined(__WATCOMC__)
+	return Timer_GetTime() * 1000;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000000 + tv.tv_usec;
+#endif
+}
+
 /**
  * Run the timer interrupt handler.
  */
@@ -96,6 +121,8 @@ static void Timer_InterruptRun(int arg)
 	if (timerLock) return;
 	timerLock = true;
 
+	TRACE_BEGIN("Timer_InterruptRun");
+
 	/* Calculate the time between calls */
 	new_time   = Timer_GetTime();
 	usec_delta = (new_time - s_timerLastTime) * 1000;
@@ -127,12 +154,19 @@ static void Timer_InterruptRun(int arg)
 		node->usec_left -= delta;
 	}
 
+	TRACE_END("Timer_InterruptRun");
+
 	timerLock = false;
 }
 
 #if defined(TOS) || defined(DOS)
 void SleepAndProcessBackgroundTasks(void)
 {
+	if (s_timerManual) {
+		Timer_Tick();
+		return;
+	}
+
 	Timer_InterruptRun(0);
 }
 
@@ -141,6 +175,12 @@ void SleepAndProcessBackgroundTasks(void)
 {
 	static bigtime_t s_nextTrigger = 0;
 	int dontRunCallonce = 0;
+
+	if (s_timerManual) {
+		Timer_Tick();
+		return;
+	}
+
 	if (s_nextTrigger == 0) s_nextTrigger = system_time();
 
 	while (snooze_until(s_nextTrigger, B_SYSTEM_TIMEBASE) != B_OK)
@@ -172,6 +212,11 @@ static void Timer_Handler(int sig)
 
 void SleepAndProcessBackgroundTasks(void)
 {
+	if (s_timerManual) {
+		Timer_Tick();
+		return;
+	}
+
 	while (s_timer_count == 0) {
 #if defined(_WIN32)
 		Sleep(2); /* TODO : use a semaphore */
@@ -392,6 +437,18 @@ bool Timer_SetTimer(TimerType timer, bool set)
 	return ret;
 }
 
+/**
+ * Switch the timer to manual mode. In manual mode there is no timer
+ *  interrupt; time only advances with every call to sleepIdle() or
+ *  Timer_Tick(), which allows the game to run as fast as possible.
+ *
+ * @param manual True to enable manual mode, false to disable it.
+ */
+void Timer_SetManual(bool manual)
+{
+	s_timerManual = manual;
+}
+
 /**
  * Sleep for an amount of ticks.
  * @param ticks The amount of ticks to sleep.
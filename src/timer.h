@@ -9,12 +9,12 @@ typedef enum TimerType {
 } TimerType;
 
 extern volatile uint32 g_timerGUI;
-extern volatile uint32 g_timerGame;
 extern volatile uint32 g_timerInput;
 extern volatile uint32 g_timerSleep;
 extern volatile uint32 g_timerTimeout;
 
 extern uint32 Timer_GetTime(void);
+extern uint32 Timer_GetTimeMicro(void);
 
 extern void Timer_Sleep(uint16 ticks);
 extern bool Timer_SetTimer(TimerType timer, bool set);
@@ -23,6 +23,7 @@ extern void Timer_Init(void);
 extern void Timer_Uninit(void);
 
 extern void Timer_Tick(void);
+extern void Timer_SetManual(bool manual);
 
 extern void Timer_Add(void (*callback)(void), uint32 usec_delay, bool callonce);
 extern void Timer_Change(void (*callback)(void), uint32 usec_delay);
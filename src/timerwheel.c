@@ -0,0 +1,194 @@
+/** @file src/timerwheel.c Timer wheel routines. */
+
+#include <assert.h>
+#include <string.h>
+#include "types.h"
+
+#include "timerwheel.h"
+
+#include "tools.h"
+
+/**
+ * Empty a TimerWheel.
+ *
+ * @param wheel The TimerWheel to empty.
+ * @param now The tick to start at.
+ */
+void TimerWheel_Init(TimerWheel *wheel, uint32 now)
+{
+	memset(wheel, 0, sizeof(TimerWheel));
+	wheel->now = now;
+}
+
+/**
+ * Get the list an entry due at a tick belongs in, as seen from the current
+ *  tick of the wheel.
+ *
+ * @param wheel The TimerWheel.
+ * @param when The tick the entry is due.
+ * @return The list (TIMERWHEEL_LIST_*).
+ */
+static uint8 TimerWheel_GetList(const TimerWheel *wheel, uint32 when)
+{
+	if (when <= wheel->now) return TIMERWHEEL_LIST_DUE;
+	if ((when >> TIMERWHEEL_SLOT_BITS) == (wheel->now >> TIMERWHEEL_SLOT_BITS)) return TIMERWHEEL_LIST_LEVEL0 + (when & (TIMERWHEEL_SLOTS - 1));
+	if ((when >> (2 * TIMERWHEEL_SLOT_BITS)) == (wheel->now >> (2 * TIMERWHEEL_SLOT_BITS))) return TIMERWHEEL_LIST_LEVEL1 + ((when >> TIMERWHEEL_SLOT_BITS) & (TIMERWHEEL_SLOTS - 1));
+	return TIMERWHEEL_LIST_OVERFLOW;
+}
+
+/**
+ * Put an unscheduled entry in the list for the tick it is due.
+ *
+ * @param wheel The TimerWheel.
+ * @param entry The entry to insert.
+ */
+static void TimerWheel_Insert(TimerWheel *wheel, uint16 entry)
+{
+	uint8 list = TimerWheel_GetList(wheel, wheel->when[entry]);
+
+	wheel->list[entry] = list;
+
+	if (list == TIMERWHEEL_LIST_DUE) {
+		BitArray_Set(wheel->due, entry);
+		return;
+	}
+
+	wheel->prev[entry] = 0;
+	wheel->next[entry] = wheel->head[list];
+	if (wheel->head[list] != 0) wheel->prev[wheel->head[list] - 1] = (uint8)(entry + 1);
+	wheel->head[list] = (uint8)(entry + 1);
+	wheel->count++;
+}
+
+/**
+ * Take all entries out of a list and put them in the list they belong in now.
+ *  Called when the wheel moves into the range of ticks the list covers.
+ *
+ * @param wheel The TimerWheel.
+ * @param list The list to empty.
+ */
+static void TimerWheel_Cascade(TimerWheel *wheel, uint8 list)
+{
+	uint8 link = wheel->head[list];
+
+	wheel->head[list] = 0;
+
+	while (link != 0) {
+		uint16 entry = link - 1;
+
+		link = wheel->next[entry];
+		wheel->count--;
+
+		TimerWheel_Insert(wheel, entry);
+	}
+}
+
+/**
+ * Schedule an entry, or move it if it was scheduled already. An entry that is
+ *  due at or before the current tick of the wheel is due right away.
+ *
+ * @param wheel The TimerWheel.
+ * @param entry The entry to schedule.
+ * @param when The tick the entry is due.
+ */
+void TimerWheel_Schedule(TimerWheel *wheel, uint16 entry, uint32 when)
+{
+	assert(entry < TIMERWHEEL_ENTRIES_MAX);
+
+	TimerWheel_Cancel(wheel, entry);
+
+	wheel->when[entry] = when;
+	TimerWheel_Insert(wheel, entry);
+}
+
+/**
+ * Unschedule an entry. Nothing happens if it was not scheduled.
+ *
+ * @param wheel The TimerWheel.
+ * @param entry The entry to unschedule.
+ */
+void TimerWheel_Cancel(TimerWheel *wheel, uint16 entry)
+{
+	uint8 list;
+
+	assert(entry < TIMERWHEEL_ENTRIES_MAX);
+
+	list = wheel->list[entry];
+	if (list == TIMERWHEEL_LIST_NONE) return;
+
+	wheel->list[entry] = TIMERWHEEL_LIST_NONE;
+
+	if (list == TIMERWHEEL_LIST_DUE) {
+		BitArray_Clear(wheel->due, entry);
+		return;
+	}
+
+	if (wheel->prev[entry] == 0) {
+		wheel->head[list] = wheel->next[entry];
+	} else {
+		wheel->next[wheel->prev[entry] - 1] = wheel->next[entry];
+	}
+	if (wheel->next[entry] != 0) wheel->prev[wheel->next[entry] - 1] = wheel->prev[entry];
+	wheel->count--;
+}
+
+/**
+ * Move the wheel forward to a tick. All entries due at or before that tick
+ *  become due; they can be taken out with TimerWheel_PopDue.
+ *
+ * @param wheel The TimerWheel.
+ * @param now The current tick.
+ */
+void TimerWheel_Advance(TimerWheel *wheel, uint32 now)
+{
+	if (now <= wheel->now) return;
+
+	/* Nothing waiting, so there is nothing to move either */
+	if (wheel->count == 0) {
+		wheel->now = now;
+		return;
+	}
+
+	/* After a long pause it is quicker to sort all entries again */
+	if (now - wheel->now >= TIMERWHEEL_SLOTS * TIMERWHEEL_SLOTS) {
+		uint8 list;
+
+		wheel->now = now;
+		for (list = TIMERWHEEL_LIST_LEVEL0; list <= TIMERWHEEL_LIST_OVERFLOW; list++) TimerWheel_Cascade(wheel, list);
+		return;
+	}
+
+	while (wheel->now < now && wheel->count != 0) {
+		uint32 tick = ++wheel->now;
+
+		if ((tick & (TIMERWHEEL_SLOTS * TIMERWHEEL_SLOTS - 1)) == 0) TimerWheel_Cascade(wheel, TIMERWHEEL_LIST_OVERFLOW);
+		if ((tick & (TIMERWHEEL_SLOTS - 1)) == 0) TimerWheel_Cascade(wheel, TIMERWHEEL_LIST_LEVEL1 + ((tick >> TIMERWHEEL_SLOT_BITS) & (TIMERWHEEL_SLOTS - 1)));
+		TimerWheel_Cascade(wheel, TIMERWHEEL_LIST_LEVEL0 + (tick & (TIMERWHEEL_SLOTS - 1)));
+	}
+
+	wheel->now = now;
+}
+
+/**
+ * Take the first due entry, starting at an entry, out of the wheel. Entries
+ *  that become due while walking over them this way are found too, as long as
+ *  they come after the last one taken.
+ *
+ * @param wheel The TimerWheel.
+ * @param start The first entry to look at.
+ * @return The entry, or TIMERWHEEL_INVALID if no entry from start on is due.
+ */
+uint16 TimerWheel_PopDue(TimerWheel *wheel, uint16 start)
+{
+	uint16 entry;
+
+	if (start >= TIMERWHEEL_ENTRIES_MAX) return TIMERWHEEL_INVALID;
+
+	entry = BitArray_FindFirst(wheel->due, start, TIMERWHEEL_ENTRIES_MAX - 1);
+	if (entry == 0xFFFF) return TIMERWHEEL_INVALID;
+
+	BitArray_Clear(wheel->due, entry);
+	wheel->list[entry] = TIMERWHEEL_LIST_NONE;
+
+	return entry;
+}
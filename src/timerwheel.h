@@ -0,0 +1,44 @@
+/** @file src/timerwheel.h Timer wheel definitions. */
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+enum {
+	TIMERWHEEL_ENTRIES_MAX = 128,                           /*!< The maximum amount of entries in a TimerWheel. */
+	TIMERWHEEL_SLOT_BITS   = 6,                             /*!< Bits of the tick per level; a level has 1 << TIMERWHEEL_SLOT_BITS slots. */
+	TIMERWHEEL_SLOTS       = 1 << TIMERWHEEL_SLOT_BITS,     /*!< The amount of slots per level. */
+
+	TIMERWHEEL_LIST_NONE     = 0,                           /*!< The entry is not scheduled. */
+	TIMERWHEEL_LIST_LEVEL0   = 1,                           /*!< First list of the slots for the ticks in the current block of TIMERWHEEL_SLOTS ticks. */
+	TIMERWHEEL_LIST_LEVEL1   = TIMERWHEEL_LIST_LEVEL0 + TIMERWHEEL_SLOTS, /*!< First list of the slots for the blocks in the current block of TIMERWHEEL_SLOTS * TIMERWHEEL_SLOTS ticks. */
+	TIMERWHEEL_LIST_OVERFLOW = TIMERWHEEL_LIST_LEVEL1 + TIMERWHEEL_SLOTS, /*!< The list of the entries further in the future. */
+	TIMERWHEEL_LIST_DUE      = TIMERWHEEL_LIST_OVERFLOW + 1, /*!< The entry is due; it is in the due bit array instead of in a list. */
+	TIMERWHEEL_LISTS         = TIMERWHEEL_LIST_DUE,         /*!< The amount of lists (including the unused TIMERWHEEL_LIST_NONE). */
+
+	TIMERWHEEL_INVALID = 0xFFFF
+};
+
+/**
+ * A hierarchical timer wheel, to find out which entries (numbered from 0)
+ *  are due at a tick without looking at the ones that are not. Everything is
+ *  stored as indexes, and all zeros is an empty wheel, so it can be part of
+ *  the GameState.
+ */
+typedef struct TimerWheel {
+	uint32 now;                                             /*!< The tick the wheel was last advanced to. */
+	uint16 count;                                           /*!< The amount of entries in the lists (not counting the due ones). */
+	uint8  head[TIMERWHEEL_LISTS];                          /*!< Per list, the first entry + 1, or 0 if the list is empty. */
+	uint8  next[TIMERWHEEL_ENTRIES_MAX];                    /*!< Per entry, the next entry in its list + 1, or 0 if none. */
+	uint8  prev[TIMERWHEEL_ENTRIES_MAX];                    /*!< Per entry, the previous entry in its list + 1, or 0 if none. */
+	uint8  list[TIMERWHEEL_ENTRIES_MAX];                    /*!< Per entry, the list it is in (TIMERWHEEL_LIST_*). */
+	uint32 when[TIMERWHEEL_ENTRIES_MAX];                    /*!< Per entry, the tick it is due. */
+	uint8  due[TIMERWHEEL_ENTRIES_MAX / 8];                 /*!< Per entry, a bit which is set if it is due. */
+} TimerWheel;
+
+extern void TimerWheel_Init(TimerWheel *wheel, uint32 now);
+extern void TimerWheel_Schedule(TimerWheel *wheel, uint16 entry, uint32 when);
+extern void TimerWheel_Cancel(TimerWheel *wheel, uint16 entry);
+extern void TimerWheel_Advance(TimerWheel *wheel, uint32 now);
+extern uint16 TimerWheel_PopDue(TimerWheel *wheel, uint16 start);
+
+#endif /* TIMERWHEEL_H */
@@ -9,13 +9,14 @@
 #include "config.h"
 #include "pool/structure.h"
 #include "pool/unit.h"
+#include "state.h"
 #include "structure.h"
 #include "tile.h"
 #include "unit.h"
 
 
-static uint8 s_randomSeed[4];
-static uint32 s_randomLCG;
+#define g_randomSeed (g_gameState->randomSeed)
+#define g_randomLCG  (g_gameState->randomLCG)
 
 uint16 Tools_AdjustToGameSpeed(uint16 normal, uint16 minimum, uint16 maximum, bool inverseSpeed)
 {
@@ -241,15 +242,15 @@ uint8 Tools_Random_256(void)
 	uint16 val16;
 	uint8 val8;
 
-	val16 = (s_randomSeed[1] << 8) | s_randomSeed[2];
+	val16 = (g_randomSeed[1] << 8) | g_randomSeed[2];
 	val8 = ((val16 ^ 0x8000) >> 15) & 1;
-	val16 = (val16 << 1) | ((s_randomSeed[0] >> 1) & 1);
-	val8 = (s_randomSeed[0] >> 2) - s_randomSeed[0] - val8;
-	s_randomSeed[0] = (val8 << 7) | (s_randomSeed[0] >> 1);
-	s_randomSeed[1] = val16 >> 8;
-	s_randomSeed[2] = val16 & 0xFF;
+	val16 = (val16 << 1) | ((g_randomSeed[0] >> 1) & 1);
+	val8 = (g_randomSeed[0] >> 2) - g_randomSeed[0] - val8;
+	g_randomSeed[0] = (val8 << 7) | (g_randomSeed[0] >> 1);
+	g_randomSeed[1] = val16 >> 8;
+	g_randomSeed[2] = val16 & 0xFF;
 
-	return s_randomSeed[0] ^ s_randomSeed[1];
+	return g_randomSeed[0] ^ g_randomSeed[1];
 }
 
 /**
@@ -258,10 +259,10 @@ uint8 Tools_Random_256(void)
  */
 void Tools_Random_Seed(uint32 seed)
 {
-	s_randomSeed[0] = (seed >>  0) & 0xFF;
-	s_randomSeed[1] = (seed >>  8) & 0xFF;
-	s_randomSeed[2] = (seed >> 16) & 0xFF;
-	s_randomSeed[3] = (seed >> 24) & 0xFF;
+	g_randomSeed[0] = (seed >>  0) & 0xFF;
+	g_randomSeed[1] = (seed >>  8) & 0xFF;
+	g_randomSeed[2] = (seed >> 16) & 0xFF;
+	g_randomSeed[3] = (seed >> 24) & 0xFF;
 }
 
 /**
@@ -269,7 +270,7 @@ void Tools_Random_Seed(uint32 seed)
  */
 void Tools_RandomLCG_Seed(uint16 seed)
 {
-	s_randomLCG = seed;
+	g_randomLCG = seed;
 }
 
 /**
@@ -278,8 +279,8 @@ void Tools_RandomLCG_Seed(uint16 seed)
 static int16 Tools_RandomLCG(void)
 {
 	/* Borland C/C++ 'a' and 'b' value, bits 30..16, as used by Dune2 */
-	s_randomLCG = 0x015A4E35 * s_randomLCG + 1;
-	return (s_randomLCG >> 16) & 0x7FFF;
+	g_randomLCG = 0x015A4E35 * g_randomLCG + 1;
+	return (g_randomLCG >> 16) & 0x7FFF;
 }
 
 /**
@@ -339,3 +340,34 @@ void BitArray_Clear(uint8 *array, uint16 index)
 	array[index >> 3] &= ~(1 << (index & 7));
 }
 #endif
+
+/**
+ * Find the first set bit in a range of a bit array.
+ * @param array Bit array.
+ * @param start The first index to look at.
+ * @param end The last index to look at.
+ * @return The index of the first set bit, or 0xFFFF if none is set.
+ */
+uint16 BitArray_FindFirst(const uint8 *array, uint16 start, uint16 end)
+{
+	uint16 index = start;
+
+	while (index <= end) {
+		uint8 bits = array[index >> 3] >> (index & 7);
+
+		/* Skip the rest of this byte at once if nothing is set */
+		if (bits == 0) {
+			index = (index | 7) + 1;
+			continue;
+		}
+
+		while ((bits & 1) == 0) {
+			bits >>= 1;
+			index++;
+		}
+
+		return (index <= end) ? index : 0xFFFF;
+	}
+
+	return 0xFFFF;
+}
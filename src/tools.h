@@ -44,5 +44,6 @@ extern bool BitArray_Test(uint8 *array, uint16 index);
 extern void BitArray_Set(uint8 *array, uint16 index);
 extern void BitArray_Clear(uint8 *array, uint16 index);
 #endif
+extern uint16 BitArray_FindFirst(const uint8 *array, uint16 start, uint16 end);
 
 #endif /* TOOLS_H */
@@ -0,0 +1,111 @@
+/** @file src/trace.c Trace zone routines. */
+
+#include <stdio.h>
+#include <string.h>
+#include "types.h"
+#include "os/error.h"
+
+#include "trace.h"
+
+#include "timer.h"
+
+static char s_traceFilename[256] = "trace.json";            /*!< The file Trace_Dump() writes to. */
+
+#if defined(WITH_TRACE)
+/** The amount of events kept; older events are overwritten. */
+#define TRACE_EVENT_MAX 65536
+
+/**
+ * The start or end of a zone.
+ */
+typedef struct TraceEvent {
+	const char *name;                                       /*!< The name of the zone. */
+	uint32 time;                                            /*!< The time of the event, in microseconds. */
+	uint8 thread;                                           /*!< The thread the event happened on, starting at 1. */
+	char phase;                                             /*!< 'B' for the start of the zone, 'E' for the end. */
+} TraceEvent;
+
+static TraceEvent s_traceEvents[TRACE_EVENT_MAX];           /*!< The ring buffer of events. */
+static uint32     s_traceNext  = 0;                         /*!< The amount of events recorded; modulo TRACE_EVENT_MAX it is the slot to write next. */
+static uint8      s_traceThreads = 0;                       /*!< The amount of threads that recorded events. */
+static THREAD_LOCAL uint8 s_traceThread = 0;                /*!< The thread number of the current thread, or 0 if it has not recorded events yet. */
+
+/**
+ * Record the start or end of a zone. Use TRACE_BEGIN() and TRACE_END()
+ *  instead, so the zones disappear when tracing is not compiled in.
+ *
+ * Events of threads running at the same time can overwrite each other now
+ *  and then; that is the price for not locking.
+ *
+ * @param name The name of the zone. It is not copied, so it has to be a literal.
+ * @param phase 'B' for the start of the zone, 'E' for the end.
+ */
+void Trace_Event(const char *name, char phase)
+{
+	TraceEvent *e = &s_traceEvents[s_traceNext++ % TRACE_EVENT_MAX];
+
+	if (s_traceThread == 0) s_traceThread = ++s_traceThreads;
+
+	e->name   = name;
+	e->time   = Timer_GetTimeMicro();
+	e->thread = s_traceThread;
+	e->phase  = phase;
+}
+#endif /* WITH_TRACE */
+
+/**
+ * Set the file Trace_Dump() writes to.
+ *
+ * @param filename The file to write to.
+ */
+void Trace_Init(const char *filename)
+{
+	strncpy(s_traceFilename, filename, sizeof(s_traceFilename) - 1);
+	s_traceFilename[sizeof(s_traceFilename) - 1] = '\0';
+}
+
+/**
+ * Write the recorded zones as Chrome trace JSON, which can be opened in
+ *  chrome://tracing or Perfetto. Only the most recent TRACE_EVENT_MAX events
+ *  are written; zones started before them only show their end.
+ *
+ * @return True if and only if the file was written.
+ */
+bool Trace_Dump(void)
+{
+#if defined(WITH_TRACE)
+	FILE *fp;
+	uint32 count;
+	uint32 first;
+	uint32 base;
+	uint32 i;
+
+	fp = fopen(s_traceFilename, "w");
+	if (fp == NULL) {
+		Error("Failed to open trace file '%s' for writing\n", s_traceFilename);
+		return false;
+	}
+
+	count = (s_traceNext < TRACE_EVENT_MAX) ? s_traceNext : TRACE_EVENT_MAX;
+	first = s_traceNext - count;
+
+	/* Timestamps are relative to the first event, so a wrap of the clock does not show */
+	base = s_traceEvents[first % TRACE_EVENT_MAX].time;
+
+	fprintf(fp, "{\"traceEvents\":[");
+	for (i = 0; i < count; i++) {
+		const TraceEvent *e = &s_traceEvents[(first + i) % TRACE_EVENT_MAX];
+
+		fprintf(fp, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%u}", (i == 0) ? "" : ",", e->name, e->phase, (unsigned long)(e->time - base), e->thread);
+	}
+	fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+	fclose(fp);
+
+	Debug("Wrote %lu trace events to '%s'\n", (unsigned long)count, s_traceFilename);
+	return true;
+#else
+	Warning("Trace zones are not compiled in; configure with --enable-trace\n");
+	return false;
+#endif /* WITH_TRACE */
+}
@@ -0,0 +1,21 @@
+/** @file src/trace.h Trace zone definitions. */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#if defined(WITH_TRACE)
+/** Mark the start of a zone; every TRACE_BEGIN() needs a TRACE_END() with the same name. */
+#define TRACE_BEGIN(name) Trace_Event(name, 'B')
+/** Mark the end of a zone started with TRACE_BEGIN(). */
+#define TRACE_END(name) Trace_Event(name, 'E')
+
+extern void Trace_Event(const char *name, char phase);
+#else
+#define TRACE_BEGIN(name)
+#define TRACE_END(name)
+#endif /* WITH_TRACE */
+
+extern void Trace_Init(const char *filename);
+extern bool Trace_Dump(void);
+
+#endif /* TRACE_H */
@@ -26,6 +26,7 @@
 #include "pool/unit.h"
 #include "pool/team.h"
 #include "sprites.h"
+#include "state.h"
 #include "string.h"
 #include "structure.h"
 #include "table/strings.h"
@@ -35,26 +36,13 @@
 #include "tools.h"
 
 
-static uint32 s_tickUnitMovement  = 0; /*!< Indicates next time the Movement function is executed. */
-static uint32 s_tickUnitRotation  = 0; /*!< Indicates next time the Rotation function is executed. */
-static uint32 s_tickUnitBlinking  = 0; /*!< Indicates next time the Blinking function is executed. */
-static uint32 s_tickUnitUnknown4  = 0; /*!< Indicates next time the Unknown4 function is executed. */
-static uint32 s_tickUnitScript    = 0; /*!< Indicates next time the Script function is executed. */
-static uint32 s_tickUnitUnknown5  = 0; /*!< Indicates next time the Unknown5 function is executed. */
-static uint32 s_tickUnitDeviation = 0; /*!< Indicates next time the Deviation function is executed. */
-
-Unit *g_unitActive = NULL;
-Unit *g_unitHouseMissile = NULL;
-Unit *g_unitSelected = NULL;
-
-uint16 g_dirtyUnitCount = 0;
-uint16 g_dirtyAirUnitCount = 0;
-
-/**
- * Number of units of each type available at the starport.
- * \c 0 means not available, \c -1 means \c 0 units, \c >0 means that number of units available.
- */
-int16 g_starportAvailable[UNIT_MAX];
+#define g_tickUnitMovement  (g_gameState->tickUnitMovement)
+#define g_tickUnitRotation  (g_gameState->tickUnitRotation)
+#define g_tickUnitBlinking  (g_gameState->tickUnitBlinking)
+#define g_tickUnitUnknown4  (g_gameState->tickUnitUnknown4)
+#define g_tickUnitScript    (g_gameState->tickUnitScript)
+#define g_tickUnitUnknown5  (g_gameState->tickUnitUnknown5)
+#define g_tickUnitDeviation (g_gameState->tickUnitDeviation)
 
 /**
  * Rotate a unit (or his top).
@@ -117,6 +105,29 @@ static void Unit_MovementTick(Unit *unit)
 	unit->speedRemainder = speed & 0xFF;
 }
 
+/**
+ * Get the slots that are due for a task which is spread over the ticks of its
+ *  period. A Unit is in the slot of its index modulo the period; each tick
+ *  that passed makes one slot due, so every Unit still gets the task once per
+ *  period, just not all in the same tick.
+ *
+ * @param next The next tick that has to be handled; it is updated.
+ * @param period The period of the task, in ticks (at most 32).
+ * @return A bit for each slot that is due.
+ */
+static uint32 GameLoop_Unit_StaggeredSlots(uint32 *next, uint16 period)
+{
+	uint32 slots = 0;
+	uint16 i;
+
+	for (i = 0; i < period && *next <= g_timerGame; i++, (*next)++) slots |= 1UL << (*next % period);
+
+	/* After a long pause every slot is due once, not once for every tick missed */
+	if (*next <= g_timerGame) *next = g_timerGame + 1;
+
+	return slots;
+}
+
 /**
  * Loop over all units, performing various of tasks.
  */
@@ -126,46 +137,51 @@ void GameLoop_Unit(void)
 	bool tickMovement  = false;
 	bool tickRotation  = false;
 	bool tickBlinking  = false;
-	bool tickUnknown4  = false;
-	bool tickScript    = false;
+	uint32 slotsUnknown4 = 0;
+	uint32 slotsScript   = 0;
 	bool tickUnknown5  = false;
 	bool tickDeviation = false;
 
 	if (g_debugScenario) return;
 
-	if (s_tickUnitMovement <= g_timerGame) {
+	if (g_tickUnitMovement <= g_timerGame) {
 		tickMovement = true;
-		s_tickUnitMovement = g_timerGame + 3;
+		g_tickUnitMovement = g_timerGame + 3;
 	}
 
-	if (s_tickUnitRotation <= g_timerGame) {
+	if (g_tickUnitRotation <= g_timerGame) {
 		tickRotation = true;
-		s_tickUnitRotation = g_timerGame + Tools_AdjustToGameSpeed(4, 2, 8, true);
+		g_tickUnitRotation = g_timerGame + Tools_AdjustToGameSpeed(4, 2, 8, true);
 	}
 
-	if (s_tickUnitBlinking <= g_timerGame) {
+	if (g_tickUnitBlinking <= g_timerGame) {
 		tickBlinking = true;
-		s_tickUnitBlinking = g_timerGame + 3;
+		g_tickUnitBlinking = g_timerGame + 3;
 	}
 
-	if (s_tickUnitUnknown4 <= g_timerGame) {
-		tickUnknown4 = true;
-		s_tickUnitUnknown4 = g_timerGame + 20;
-	}
+	if (g_unitStaggered) {
+		slotsUnknown4 = GameLoop_Unit_StaggeredSlots(&g_tickUnitUnknown4, 20);
+		slotsScript   = GameLoop_Unit_StaggeredSlots(&g_tickUnitScript, 5);
+	} else {
+		if (g_tickUnitUnknown4 <= g_timerGame) {
+			slotsUnknown4 = 0xFFFFFFFF;
+			g_tickUnitUnknown4 = g_timerGame + 20;
+		}
 
-	if (s_tickUnitScript <= g_timerGame) {
-		tickScript = true;
-		s_tickUnitScript = g_timerGame + 5;
+		if (g_tickUnitScript <= g_timerGame) {
+			slotsScript = 0xFFFFFFFF;
+			g_tickUnitScript = g_timerGame + 5;
+		}
 	}
 
-	if (s_tickUnitUnknown5 <= g_timerGame) {
+	if (g_tickUnitUnknown5 <= g_timerGame) {
 		tickUnknown5 = true;
-		s_tickUnitUnknown5 = g_timerGame + 5;
+		g_tickUnitUnknown5 = g_timerGame + 5;
 	}
 
-	if (s_tickUnitDeviation <= g_timerGame) {
+	if (g_tickUnitDeviation <= g_timerGame) {
 		tickDeviation = true;
-		s_tickUnitDeviation = g_timerGame + 60;
+		g_tickUnitDeviation = g_timerGame + 60;
 	}
 
 	find.houseID = HOUSE_INVALID;
@@ -188,7 +204,7 @@ void GameLoop_Unit(void)
 
 		if (u->o.flags.s.isNotOnMap) continue;
 
-		if (tickUnknown4 && u->targetAttack != 0 && ui->o.flags.hasTurret) {
+		if ((slotsUnknown4 & (1UL << (u->o.index % 20))) != 0 && u->targetAttack != 0 && ui->o.flags.hasTurret) {
 			tile32 tile;
 
 			tile = Tools_Index_GetTile(u->targetAttack);
@@ -286,19 +302,17 @@ void GameLoop_Unit(void)
 			}
 		}
 
-		if (tickScript) {
+		if ((slotsScript & (1UL << (u->o.index % 5))) != 0) {
 			if (u->o.script.delay == 0) {
 				if (Script_IsLoaded(&u->o.script)) {
-					int opcodesLeft = SCRIPT_UNIT_OPCODES_PER_TICK + 2;
+					uint16 opcodesLeft = SCRIPT_UNIT_OPCODES_PER_TICK + 2;
 					if (!ui->o.flags.scriptNoSlowdown && !Map_IsPositionInViewport(u->o.position, NULL, NULL)) {
 						opcodesLeft = 3;
 					}
 
 					u->o.script.variables[3] = g_playerHouseID;
 
-					for (; opcodesLeft > 0 && u->o.script.delay == 0; opcodesLeft--) {
-						if (!Script_Run(&u->o.script)) break;
-					}
+					Script_RunOpcodes(&u->o.script, opcodesLeft, true);
 				}
 			} else {
 				u->o.script.delay--;
@@ -454,6 +468,7 @@ Unit *Unit_Create(uint16 index, uint8 typeID, uint8 houseID, tile32 position, in
 
 	if ((position.x == 0xFFFF) && (position.y == 0xFFFF)) {
 		u->o.flags.s.isNotOnMap = true;
+		Unit_Grid_Update(u);
 		return u;
 	}
 
@@ -473,19 +488,13 @@ Unit *Unit_Create(uint16 index, uint8 typeID, uint8 houseID, tile32 position, in
  */
 bool Unit_IsTypeOnMap(uint8 houseID, uint8 typeID)
 {
-	uint16 i;
-
-	for (i = 0; i < g_unitFindCount; i++) {
-		Unit *u;
+	PoolFindStruct find;
 
-		u = g_unitFindArray[i];
-		if (houseID != HOUSE_INVALID && Unit_GetHouseID(u) != houseID) continue;
-		if (typeID != UNIT_INVALID && u->o.type != typeID) continue;
-		if (g_validateStrictIfZero == 0 && u->o.flags.s.isNotOnMap) continue;
+	find.houseID = houseID;
+	find.type    = (typeID == UNIT_INVALID) ? UNIT_INDEX_INVALID : typeID;
+	find.index   = 0xFFFF;
 
-		return true;
-	}
-	return false;
+	return Unit_Find(&find) != NULL;
 }
 
 /**
@@ -593,30 +602,30 @@ void Unit_Sort(void)
 	h->unitCountEnemy = 0;
 	h->unitCountAllied = 0;
 
+	/* Only the hot fields are read, so the Units themselves stay out of the cache */
 	for (i = 0; i < g_unitFindCount - 1; i++) {
-		Unit *u1;
-		Unit *u2;
+		uint16 index1;
+		uint16 index2;
 		uint16 y1;
 		uint16 y2;
 
-		u1 = g_unitFindArray[i];
-		u2 = g_unitFindArray[i + 1];
-		y1 = Tile_GetY(u1->o.position);
-		y2 = Tile_GetY(u2->o.position);
-		if (g_table_unitInfo[u1->o.type].movementType == MOVEMENT_FOOT) y1 -= 0x100;
-		if (g_table_unitInfo[u2->o.type].movementType == MOVEMENT_FOOT) y2 -= 0x100;
+		index1 = Unit_Index(g_unitFindArray[i]);
+		index2 = Unit_Index(g_unitFindArray[i + 1]);
+		y1 = Tile_GetY(g_unitHotPosition[index1]);
+		y2 = Tile_GetY(g_unitHotPosition[index2]);
+		if (g_table_unitInfo[g_unitHotType[index1]].movementType == MOVEMENT_FOOT) y1 -= 0x100;
+		if (g_table_unitInfo[g_unitHotType[index2]].movementType == MOVEMENT_FOOT) y2 -= 0x100;
 
-		if ((int16)y1 > (int16)y2) {
-			g_unitFindArray[i] = u2;
-			g_unitFindArray[i + 1] = u1;
-		}
+		if ((int16)y1 > (int16)y2) Unit_SwapFindOrder(i);
 	}
 
 	for (i = 0; i < g_unitFindCount; i++) {
 		Unit *u;
 
 		u = g_unitFindArray[i];
-		if ((u->o.seenByHouses & (1 << g_playerHouseID)) != 0 && !u->o.flags.s.isNotOnMap) {
+		if (BitArray_Test(g_unitHotNotOnMap, Unit_Index(u))) continue;
+
+		if ((u->o.seenByHouses & (1 << g_playerHouseID)) != 0) {
 			if (House_AreAllied(u->o.houseID, g_playerHouseID)) {
 				h->unitCountAllied++;
 			} else {
@@ -860,9 +869,12 @@ bool Unit_SetPosition(Unit *u, tile32 position)
 
 	if (Unit_IsTileOccupied(u)) {
 		u->o.flags.s.isNotOnMap = true;
+		Unit_Grid_Update(u);
 		return false;
 	}
 
+	Unit_Grid_Update(u);
+
 	u->currentDestination.x = 0;
 	u->currentDestination.y = 0;
 	u->targetMove = 0;
@@ -940,6 +952,28 @@ Unit *Unit_FindBestTargetUnit(Unit *u, uint16 mode)
 	distance = g_table_unitInfo[u->o.type].fireDistance << 8;
 	if (mode == 2) distance <<= 1;
 
+	/* ENHANCEMENT -- Only look at the Units within range, instead of at all Units on the map. */
+	if (g_dune2_enhanced && (mode == 1 || mode == 2)) {
+		Unit *units[UNIT_INDEX_MAX];
+		uint16 count;
+		uint16 i;
+
+		count = Unit_FindInRange(mode == 1 ? u->o.position : position, distance, units);
+
+		for (i = 0; i < count; i++) {
+			uint16 priority = Unit_GetTargetUnitPriority(u, units[i]);
+
+			if ((int16)priority > (int16)bestPriority) {
+				best = units[i];
+				bestPriority = priority;
+			}
+		}
+
+		if (bestPriority == 0) return NULL;
+
+		return best;
+	}
+
 	find.houseID = HOUSE_INVALID;
 	find.type    = 0xFFFF;
 	find.index   = 0xFFFF;
@@ -954,10 +988,10 @@ Unit *Unit_FindBestTargetUnit(Unit *u, uint16 mode)
 
 		if (mode != 0 && mode != 4) {
 			if (mode == 1) {
-				if (Tile_GetDistance(u->o.position, target->o.position) > distance) continue;
+				if (Tile_GetDistance(u->o.position, g_unitHotPosition[Unit_Index(target)]) > distance) continue;
 			}
 			if (mode == 2) {
-				if (Tile_GetDistance(position, target->o.position) > distance) continue;
+				if (Tile_GetDistance(position, g_unitHotPosition[Unit_Index(target)]) > distance) continue;
 			}
 		}
 
@@ -1025,6 +1059,37 @@ Unit *Unit_Sandworm_FindBestTarget(Unit *unit)
 
 	if (unit == NULL) return NULL;
 
+	/* ENHANCEMENT -- Search in growing areas around the sandworm, and stop as soon
+	 *  as no Unit further away can get a higher priority than the best one so far. */
+	if (g_dune2_enhanced) {
+		Unit *units[UNIT_INDEX_MAX];
+		uint16 range;
+
+		for (range = 8; range <= 128; range *= 2) {
+			uint16 count;
+			uint16 i;
+
+			count = Unit_FindInRange(unit->o.position, range << 8, units);
+
+			for (i = 0; i < count; i++) {
+				uint16 priority = Unit_Sandworm_GetTargetPriority(unit, units[i]);
+
+				/* Ties go to the lowest index; a bigger area can find a lower index with the same priority */
+				if (priority > bestPriority || (priority == bestPriority && best != NULL && units[i]->o.index < best->o.index)) {
+					best = units[i];
+					bestPriority = priority;
+				}
+			}
+
+			/* Units further away have at most the highest priority (0x1388 * 4) divided by the range */
+			if (bestPriority > 0x1388 * 4 / range) break;
+		}
+
+		if (bestPriority == 0) return NULL;
+
+		return best;
+	}
+
 	find.houseID = HOUSE_INVALID;
 	find.type    = 0xFFFF;
 	find.index   = 0xFFFF;
@@ -1113,6 +1178,7 @@ bool Unit_StartMovement(Unit *unit)
 		Unit_UpdateMap(1, unit);
 
 		unit->o.position = positionOld;
+		Unit_Grid_Update(unit);
 	}
 
 	unit->currentDestination = position;
@@ -1191,6 +1257,7 @@ bool Unit_Deviation_Decrease(Unit *unit, uint16 amount)
 	}
 
 	unit->deviated = 0;
+	Unit_UpdateHouseList(unit);
 
 	unit->o.flags.s.bulletIsBig = true;
 	Unit_UpdateMap(2, unit);
@@ -1260,6 +1327,7 @@ bool Unit_Deviate(Unit *unit, uint16 probability, uint8 houseID)
 
 	unit->deviated = 120;
 	unit->deviatedHouse = houseID;
+	Unit_UpdateHouseList(unit);
 
 	Unit_UpdateMap(2, unit);
 
@@ -1408,6 +1476,7 @@ bool Unit_Move(Unit *unit, uint16 distance)
 
 			if (type == LST_WALL || type == LST_STRUCTURE || type == LST_ENTIRELY_MOUNTAIN) {
 				unit->o.position = newPosition;
+				Unit_Grid_Update(unit);
 
 				Map_MakeExplosion((ui->explosionType + unit->o.hitpoints / 10) & 3, unit->o.position, unit->o.hitpoints, unit->originEncoded);
 
@@ -2116,6 +2185,7 @@ void Unit_Hide(Unit *unit)
 	Unit_UntargetMe(unit);
 
 	unit->o.flags.s.isNotOnMap = true;
+	Unit_Grid_Update(unit);
 	Unit_HouseUnitCount_Remove(unit);
 }
 
@@ -2235,6 +2305,7 @@ void Unit_EnterStructure(Unit *unit, Structure *s)
 
 		h = House_Get_ByIndex(s->o.houseID);
 		s->o.houseID = Unit_GetHouseID(unit);
+		Structure_UpdateHouseList(s);
 		h->structuresBuilt = Structure_GetStructuresBuilt(h);
 
 		/* ENHANCEMENT -- recalculate the power and credits for the house losing the structure. */
@@ -2245,7 +2316,10 @@ void Unit_EnterStructure(Unit *unit, Structure *s)
 
 		if (s->o.linkedID != 0xFF) {
 			Unit *u = Unit_Get_ByIndex(s->o.linkedID);
-			if (u != NULL) u->o.houseID = Unit_GetHouseID(unit);
+			if (u != NULL) {
+				u->o.houseID = Unit_GetHouseID(unit);
+				Unit_UpdateHouseList(u);
+			}
 		}
 
 		House_CalculatePowerAndCredit(House_Get_ByIndex(s->o.houseID));
@@ -2363,27 +2437,55 @@ int16 Unit_GetTileEnterScore(Unit *unit, uint16 packed, uint16 orient8)
 
 	type = Map_GetLandscapeType(packed);
 
-	if (g_dune2_enhanced) {
-		res = g_table_landscapeInfo[type].movementSpeed[ui->movementType] * ui->movingSpeedFactor / 256;
-	} else {
-		res = g_table_landscapeInfo[type].movementSpeed[ui->movementType];
-	}
-
 	if (unit->o.type == UNIT_SABOTEUR && type == LST_WALL) {
-		if (!House_AreAllied(g_map[packed].houseID, Unit_GetHouseID(unit))) res = 255;
+		if (!House_AreAllied(g_map[packed].houseID, Unit_GetHouseID(unit))) return (int16)Unit_GetSpeedEnterScore(255, orient8);
 	}
 
-	if (res == 0) return 256;
+	return (int16)Unit_GetLandscapeEnterScore(unit->o.type, type, orient8);
+}
+
+/**
+ * Get the score of entering a tile with a given speed from a direction.
+ *
+ * @param speed The speed on the tile (0 to 255).
+ * @param orient8 The direction entering the tile from.
+ * @return 256 if tile is not accessable, or a score to enter the tile otherwise.
+ */
+uint16 Unit_GetSpeedEnterScore(uint16 speed, uint16 orient8)
+{
+	if (speed == 0) return 256;
 
 	/* Check if the unit is travelling diagonally. */
 	if ((orient8 & 1) != 0) {
-		res -= res / 4 + res / 8;
+		speed -= speed / 4 + speed / 8;
 	}
 
 	/* 'Invert' the speed to get a rough estimate of the time taken. */
-	res ^= 0xFF;
+	return speed ^ 0xFF;
+}
+
+/**
+ * Get the score for a type of Unit to enter a tile of a LandscapeType from a
+ *  direction, without looking at what is on the tile. The flow fields score
+ *  tiles with this too, so they find the same routes as the pathfinder.
+ *
+ * @param type The UnitType entering the tile.
+ * @param landscapeType The LandscapeType of the tile.
+ * @param orient8 The direction entering the tile from.
+ * @return 256 if tile is not accessable, or a score to enter the tile otherwise.
+ */
+uint16 Unit_GetLandscapeEnterScore(uint8 type, uint16 landscapeType, uint16 orient8)
+{
+	const UnitInfo *ui = &g_table_unitInfo[type];
+	uint16 speed;
+
+	if (g_dune2_enhanced) {
+		speed = g_table_landscapeInfo[landscapeType].movementSpeed[ui->movementType] * ui->movingSpeedFactor / 256;
+	} else {
+		speed = g_table_landscapeInfo[landscapeType].movementSpeed[ui->movementType];
+	}
 
-	return (int16)res;
+	return Unit_GetSpeedEnterScore(speed, orient8);
 }
 
 /**
@@ -2471,6 +2573,8 @@ void Unit_UpdateMap(uint16 type, Unit *unit)
 	Tile *t;
 	uint16 radius;
 
+	Unit_Grid_Update(unit);
+
 	if (unit == NULL || unit->o.flags.s.isNotOnMap || !unit->o.flags.s.used) return;
 
 	ui = &g_table_unitInfo[unit->o.type];
@@ -2542,6 +2646,8 @@ void Unit_RemoveFromTile(Unit *unit, uint16 packed)
 	Map_MarkTileDirty(packed);
 
 	Map_Update(packed, 0, false);
+
+	Unit_Grid_Update(unit);
 }
 
 void Unit_AddToTile(Unit *unit, uint16 packed)
@@ -2549,6 +2655,8 @@ void Unit_AddToTile(Unit *unit, uint16 packed)
 	Map_UnveilTile(packed, Unit_GetHouseID(unit));
 	Map_MarkTileDirty(packed);
 	Map_Update(packed, 1, false);
+
+	Unit_Grid_Update(unit);
 }
 
 /**
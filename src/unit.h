@@ -229,15 +229,6 @@ extern const uint16 g_table_actionsAI[4];
 extern const ActionInfo g_table_actionInfo[ACTION_MAX];
 extern UnitInfo g_table_unitInfo[UNIT_MAX];
 
-extern Unit *g_unitActive;
-extern Unit *g_unitHouseMissile;
-extern Unit *g_unitSelected;
-extern int16 g_starportAvailable[UNIT_MAX];
-
-extern uint16 g_dirtyUnitCount;
-extern uint16 g_dirtyAirUnitCount;
-
-
 extern void GameLoop_Unit(void);
 extern uint8 Unit_GetHouseID(Unit *u);
 extern uint8 Unit_StringToType(const char *name);
@@ -276,6 +267,8 @@ extern void Unit_Hide(Unit *unit);
 extern Unit *Unit_CallUnitByType(UnitType type, uint8 houseID, uint16 target, bool createCarryall);
 extern void Unit_EnterStructure(Unit *unit, struct Structure *s);
 extern int16 Unit_GetTileEnterScore(Unit *unit, uint16 packed, uint16 orient8);
+extern uint16 Unit_GetSpeedEnterScore(uint16 speed, uint16 orient8);
+extern uint16 Unit_GetLandscapeEnterScore(uint8 type, uint16 landscapeType, uint16 orient8);
 extern void Unit_RemovePlayer(Unit *unit);
 extern void Unit_UpdateMap(uint16 type, Unit *unit);
 extern void Unit_RemoveFromTile(Unit *unit, uint16 packed);
@@ -72,14 +72,16 @@
 #define PIXEL11_90    *(dp+dpL+1) = Interp9(w_rgb[5], w_rgb[6], w_rgb[8]);
 #define PIXEL11_100   *(dp+dpL+1) = Interp10(w_rgb[5], w_rgb[6], w_rgb[8]);
 
-HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, const uint32_t * rgb_palette )
+/* Scale only the source lines top up to (excluding) bottom. The lines next
+ * to them are still read as context, so sp and dp point to the whole image. */
+HQX_API void HQX_CALLCONV hq2x_8to32_rb_part( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, int top, int bottom, const uint32_t * rgb_palette )
 {
     int  i, j, k;
     int  prevline, nextline;
     uint32_t  w_rgb[10];
-    uint32_t  w_yuv[10];
+    uint8_t   w_idx[10];
     int dpL = (drb >> 2);
-    uint8_t *dRowP = (uint8_t *) dp;
+    uint8_t *dRowP = (uint8_t *) dp + drb * 2 * top;
 
     /*   +----+----+----+
          |    |    |    |
@@ -92,7 +94,10 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
          | w7 | w8 | w9 |
          +----+----+----+ */
 
-    for (j=0; j<Yres; j++)
+    sp += srb * top;
+    dp = (uint32_t *) dRowP;
+
+    for (j=top; j<bottom; j++)
     {
         if (j>0)      prevline = 0 - (int)srb; else prevline = 0;
         if (j<Yres-1) nextline = (int)srb;     else nextline = 0;
@@ -104,60 +109,60 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
 
             if (i==0)
             {
-                w_rgb[2] = rgb_palette[*(sp + prevline)];
-                w_rgb[5] = rgb_palette[*sp];
-                w_rgb[8] = rgb_palette[*(sp + nextline)];
+                w_idx[2] = *(sp + prevline);
+                w_rgb[2] = rgb_palette[w_idx[2]];
+                w_idx[5] = *sp;
+                w_rgb[5] = rgb_palette[w_idx[5]];
+                w_idx[8] = *(sp + nextline);
+                w_rgb[8] = rgb_palette[w_idx[8]];
                 w_rgb[1] = w_rgb[2];
+                w_idx[1] = w_idx[2];
                 w_rgb[4] = w_rgb[5];
+                w_idx[4] = w_idx[5];
                 w_rgb[7] = w_rgb[8];
-                w_rgb[3] = rgb_palette[*(sp + prevline + 1)];
-                w_rgb[6] = rgb_palette[*(sp + 1)];
-                w_rgb[9] = rgb_palette[*(sp + nextline + 1)];
-                w_yuv[2] = rgb_to_yuv(w_rgb[2]);
-                w_yuv[5] = rgb_to_yuv(w_rgb[5]);
-                w_yuv[8] = rgb_to_yuv(w_rgb[8]);
-                w_yuv[1] = w_yuv[2];
-                w_yuv[4] = w_yuv[5];
-                w_yuv[7] = w_yuv[8];
-                w_yuv[3] = rgb_to_yuv(w_rgb[3]);
-                w_yuv[6] = rgb_to_yuv(w_rgb[6]);
-                w_yuv[9] = rgb_to_yuv(w_rgb[9]);
+                w_idx[7] = w_idx[8];
+                w_idx[3] = *(sp + prevline + 1);
+                w_rgb[3] = rgb_palette[w_idx[3]];
+                w_idx[6] = *(sp + 1);
+                w_rgb[6] = rgb_palette[w_idx[6]];
+                w_idx[9] = *(sp + nextline + 1);
+                w_rgb[9] = rgb_palette[w_idx[9]];
             }
             else if(i<Xres-1)
             {
                 w_rgb[1] = w_rgb[2];
+                w_idx[1] = w_idx[2];
                 w_rgb[4] = w_rgb[5];
+                w_idx[4] = w_idx[5];
                 w_rgb[7] = w_rgb[8];
+                w_idx[7] = w_idx[8];
                 w_rgb[2] = w_rgb[3];
+                w_idx[2] = w_idx[3];
                 w_rgb[5] = w_rgb[6];
+                w_idx[5] = w_idx[6];
                 w_rgb[8] = w_rgb[9];
-                w_rgb[3] = rgb_palette[*(sp + prevline + 1)];
-                w_rgb[6] = rgb_palette[*(sp + 1)];
-                w_rgb[9] = rgb_palette[*(sp + nextline + 1)];
-                w_yuv[1] = w_yuv[2];
-                w_yuv[4] = w_yuv[5];
-                w_yuv[7] = w_yuv[8];
-                w_yuv[2] = w_yuv[3];
-                w_yuv[5] = w_yuv[6];
-                w_yuv[8] = w_yuv[9];
-                w_yuv[3] = rgb_to_yuv(w_rgb[3]);
-                w_yuv[6] = rgb_to_yuv(w_rgb[6]);
-                w_yuv[9] = rgb_to_yuv(w_rgb[9]);
+                w_idx[8] = w_idx[9];
+                w_idx[3] = *(sp + prevline + 1);
+                w_rgb[3] = rgb_palette[w_idx[3]];
+                w_idx[6] = *(sp + 1);
+                w_rgb[6] = rgb_palette[w_idx[6]];
+                w_idx[9] = *(sp + nextline + 1);
+                w_rgb[9] = rgb_palette[w_idx[9]];
             }
             else
             {
                 w_rgb[1] = w_rgb[2];
+                w_idx[1] = w_idx[2];
                 w_rgb[4] = w_rgb[5];
+                w_idx[4] = w_idx[5];
                 w_rgb[7] = w_rgb[8];
+                w_idx[7] = w_idx[8];
                 w_rgb[2] = w_rgb[3];
+                w_idx[2] = w_idx[3];
                 w_rgb[5] = w_rgb[6];
+                w_idx[5] = w_idx[6];
                 w_rgb[8] = w_rgb[9];
-                w_yuv[1] = w_yuv[2];
-                w_yuv[4] = w_yuv[5];
-                w_yuv[7] = w_yuv[8];
-                w_yuv[2] = w_yuv[3];
-                w_yuv[5] = w_yuv[6];
-                w_yuv[8] = w_yuv[9];
+                w_idx[8] = w_idx[9];
             }
 
             for (k=1; k<=9; k++)
@@ -166,7 +171,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
 
                 if ( w_rgb[k] != w_rgb[5] )
                 {
-                    if (yuv_diff(w_yuv[5], w_yuv[k]))
+                    if (hqx_palette_diff(w_idx[5], w_idx[k]))
                         pattern |= flag;
                 }
                 flag <<= 1;
@@ -333,7 +338,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 50:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -351,7 +356,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_20
                         PIXEL01_22
                         PIXEL10_21
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -366,7 +371,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -380,7 +385,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 10:
                 case 138:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -453,7 +458,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 54:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -471,7 +476,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_20
                         PIXEL01_22
                         PIXEL10_21
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -486,7 +491,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -500,7 +505,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 11:
                 case 139:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -516,7 +521,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 19:
                 case 51:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL00_11
                             PIXEL01_10
@@ -534,7 +539,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 178:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                             PIXEL11_12
@@ -551,7 +556,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 85:
                     {
                         PIXEL00_20
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL01_11
                             PIXEL11_10
@@ -569,7 +574,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_20
                         PIXEL01_22
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL10_12
                             PIXEL11_10
@@ -586,7 +591,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                             PIXEL11_11
@@ -601,7 +606,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 73:
                 case 77:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL00_12
                             PIXEL10_10
@@ -618,7 +623,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 42:
                 case 170:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                             PIXEL10_11
@@ -635,7 +640,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 14:
                 case 142:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                             PIXEL01_12
@@ -716,7 +721,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 26:
                 case 31:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -724,7 +729,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_20
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -740,7 +745,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 214:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -749,7 +754,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_20
                         }
                         PIXEL10_21
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -764,7 +769,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_22
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -772,7 +777,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_20
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -785,7 +790,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 74:
                 case 107:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -794,7 +799,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_20
                         }
                         PIXEL01_21
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -807,7 +812,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 27:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -823,7 +828,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 86:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -840,7 +845,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_21
                         PIXEL01_22
                         PIXEL10_10
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -854,7 +859,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_10
                         PIXEL01_21
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -868,7 +873,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 30:
                     {
                         PIXEL00_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -885,7 +890,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_22
                         PIXEL01_10
                         PIXEL10_21
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -899,7 +904,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_22
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -912,7 +917,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 75:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -1023,7 +1028,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 58:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1031,7 +1036,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_70
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1046,7 +1051,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 83:
                     {
                         PIXEL00_11
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1055,7 +1060,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_70
                         }
                         PIXEL10_21
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1069,7 +1074,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1077,7 +1082,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_70
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1089,7 +1094,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 202:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1098,7 +1103,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_70
                         }
                         PIXEL01_21
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1111,7 +1116,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 78:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1120,7 +1125,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_70
                         }
                         PIXEL01_12
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1133,7 +1138,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 154:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1141,7 +1146,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_70
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1156,7 +1161,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 114:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1165,7 +1170,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_70
                         }
                         PIXEL10_12
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1179,7 +1184,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_12
                         PIXEL01_22
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1187,7 +1192,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_70
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1199,7 +1204,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 90:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1207,7 +1212,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_70
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1215,7 +1220,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL01_70
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1223,7 +1228,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_70
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1236,7 +1241,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 55:
                 case 23:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL00_11
                             PIXEL01_0
@@ -1254,7 +1259,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 150:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                             PIXEL11_12
@@ -1271,7 +1276,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 212:
                     {
                         PIXEL00_20
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL01_11
                             PIXEL11_0
@@ -1289,7 +1294,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_20
                         PIXEL01_22
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL10_12
                             PIXEL11_0
@@ -1306,7 +1311,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                             PIXEL11_11
@@ -1321,7 +1326,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 109:
                 case 105:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL00_12
                             PIXEL10_0
@@ -1338,7 +1343,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 171:
                 case 43:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL10_11
@@ -1355,7 +1360,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 143:
                 case 15:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_12
@@ -1373,7 +1378,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -1386,7 +1391,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 203:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -1402,7 +1407,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 62:
                     {
                         PIXEL00_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -1419,7 +1424,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_11
                         PIXEL01_10
                         PIXEL10_21
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -1432,7 +1437,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 118:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -1449,7 +1454,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_12
                         PIXEL01_22
                         PIXEL10_10
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -1463,7 +1468,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_10
                         PIXEL01_12
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -1476,7 +1481,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 155:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -1557,7 +1562,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1565,7 +1570,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_70
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -1577,7 +1582,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 158:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1585,7 +1590,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_70
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -1599,7 +1604,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 234:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1608,7 +1613,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_70
                         }
                         PIXEL01_21
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -1622,7 +1627,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 242:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1631,7 +1636,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_70
                         }
                         PIXEL10_12
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -1643,7 +1648,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 59:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -1651,7 +1656,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_20
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1667,7 +1672,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_12
                         PIXEL01_22
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -1675,7 +1680,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_20
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1688,7 +1693,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 87:
                     {
                         PIXEL00_11
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -1697,7 +1702,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_20
                         }
                         PIXEL10_21
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1709,7 +1714,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 79:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -1718,7 +1723,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_20
                         }
                         PIXEL01_12
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1731,7 +1736,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 122:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1739,7 +1744,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_70
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1747,7 +1752,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL01_70
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -1755,7 +1760,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_20
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1767,7 +1772,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 94:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1775,7 +1780,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_70
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -1783,7 +1788,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL01_20
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1791,7 +1796,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_70
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1803,7 +1808,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 218:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1811,7 +1816,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_70
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1819,7 +1824,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL01_70
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1827,7 +1832,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_70
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -1839,7 +1844,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 91:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -1847,7 +1852,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_20
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1855,7 +1860,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL01_70
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1863,7 +1868,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_70
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1907,7 +1912,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 186:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1915,7 +1920,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_70
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1930,7 +1935,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 115:
                     {
                         PIXEL00_11
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -1939,7 +1944,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_70
                         }
                         PIXEL10_12
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1953,7 +1958,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_12
                         PIXEL01_11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1961,7 +1966,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_70
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -1973,7 +1978,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 206:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -1982,7 +1987,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_70
                         }
                         PIXEL01_12
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -1998,7 +2003,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_12
                         PIXEL01_20
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_10
                         }
@@ -2012,7 +2017,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 174:
                 case 46:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_10
                         }
@@ -2029,7 +2034,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 147:
                     {
                         PIXEL00_11
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_10
                         }
@@ -2047,7 +2052,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_20
                         PIXEL01_11
                         PIXEL10_12
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_10
                         }
@@ -2076,7 +2081,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 126:
                     {
                         PIXEL00_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2084,7 +2089,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL01_20
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2097,7 +2102,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 219:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2107,7 +2112,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL01_10
                         PIXEL10_10
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2119,7 +2124,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 125:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL00_12
                             PIXEL10_0
@@ -2136,7 +2141,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 221:
                     {
                         PIXEL00_12
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL01_11
                             PIXEL11_0
@@ -2151,7 +2156,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 207:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_12
@@ -2169,7 +2174,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_10
                         PIXEL01_12
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                             PIXEL11_11
@@ -2184,7 +2189,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 190:
                     {
                         PIXEL00_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                             PIXEL11_12
@@ -2199,7 +2204,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 187:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL10_11
@@ -2217,7 +2222,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_11
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL10_12
                             PIXEL11_0
@@ -2231,7 +2236,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 119:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL00_11
                             PIXEL01_0
@@ -2250,7 +2255,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_12
                         PIXEL01_20
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2264,7 +2269,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 175:
                 case 47:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2281,7 +2286,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 151:
                     {
                         PIXEL00_11
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2299,7 +2304,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_20
                         PIXEL01_11
                         PIXEL10_12
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2313,7 +2318,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_10
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2321,7 +2326,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_20
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2333,7 +2338,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 123:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2342,7 +2347,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_20
                         }
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2355,7 +2360,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 95:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2363,7 +2368,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_20
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2378,7 +2383,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 222:
                     {
                         PIXEL00_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2387,7 +2392,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_20
                         }
                         PIXEL10_10
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2401,7 +2406,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2409,7 +2414,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_20
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2423,7 +2428,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_12
                         PIXEL01_22
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2431,7 +2436,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_100
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2443,7 +2448,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 235:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2452,7 +2457,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_20
                         }
                         PIXEL01_21
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2465,7 +2470,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 111:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2474,7 +2479,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_100
                         }
                         PIXEL01_12
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2487,7 +2492,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 63:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2495,7 +2500,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_100
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2509,7 +2514,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 159:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2517,7 +2522,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_20
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2532,7 +2537,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 215:
                     {
                         PIXEL00_11
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2541,7 +2546,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_100
                         }
                         PIXEL10_21
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2554,7 +2559,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 246:
                     {
                         PIXEL00_22
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2563,7 +2568,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_20
                         }
                         PIXEL10_12
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2576,7 +2581,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 254:
                     {
                         PIXEL00_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2584,7 +2589,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL01_20
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2592,7 +2597,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_20
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2606,7 +2611,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_12
                         PIXEL01_11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2614,7 +2619,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_100
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2626,7 +2631,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 251:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2635,7 +2640,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_20
                         }
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2643,7 +2648,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_100
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2655,7 +2660,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 239:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2664,7 +2669,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_100
                         }
                         PIXEL01_12
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2677,7 +2682,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 127:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2685,7 +2690,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_100
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2693,7 +2698,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL01_20
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2706,7 +2711,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 191:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2714,7 +2719,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_100
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2728,7 +2733,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 223:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2736,7 +2741,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_20
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2745,7 +2750,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_100
                         }
                         PIXEL10_10
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2758,7 +2763,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 247:
                     {
                         PIXEL00_11
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2767,7 +2772,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_100
                         }
                         PIXEL10_12
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2779,7 +2784,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 255:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -2787,7 +2792,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_100
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_0
                         }
@@ -2795,7 +2800,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL01_100
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_0
                         }
@@ -2803,7 +2808,7 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL10_100
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL11_0
                         }
@@ -2825,6 +2830,11 @@ HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
     }
 }
 
+HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, const uint32_t * rgb_palette )
+{
+    hq2x_8to32_rb_part(sp, srb, dp, drb, Xres, Yres, 0, Yres, rgb_palette);
+}
+
 HQX_API void HQX_CALLCONV hq2x_8to32( const uint8_t * sp, uint32_t * dp, int Xres, int Yres, const uint32_t * rgb_palette )
 {
     uint32_t rowBytesL = Xres * 4;
@@ -77,14 +77,16 @@
 #define PIXEL22_5   *(dp+dpL+dpL+2) = Interp5(w_rgb[6], w_rgb[8]);
 #define PIXEL22_C   *(dp+dpL+dpL+2) = w_rgb[5];
 
-HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, const uint32_t * rgb_palette )
+/* Scale only the source lines top up to (excluding) bottom. The lines next
+ * to them are still read as context, so sp and dp point to the whole image. */
+HQX_API void HQX_CALLCONV hq3x_8to32_rb_part( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, int top, int bottom, const uint32_t * rgb_palette )
 {
     int  i, j, k;
     int  prevline, nextline;
     uint32_t  w_rgb[10];
-    uint32_t  w_yuv[10];
+    uint8_t   w_idx[10];
     int dpL = (drb >> 2);
-    uint8_t *dRowP = (uint8_t *) dp;
+    uint8_t *dRowP = (uint8_t *) dp + drb * 3 * top;
 
     /*   +----+----+----+
          |    |    |    |
@@ -97,7 +99,10 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
          | w7 | w8 | w9 |
          +----+----+----+ */
 
-    for (j=0; j<Yres; j++)
+    sp += srb * top;
+    dp = (uint32_t *) dRowP;
+
+    for (j=top; j<bottom; j++)
     {
         if (j>0)      prevline = 0- (int)srb; else prevline = 0;
         if (j<Yres-1) nextline = (int)srb;    else nextline = 0;
@@ -109,60 +114,60 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
 
             if (i==0)
             {
-                w_rgb[2] = rgb_palette[*(sp + prevline)];
-                w_rgb[5] = rgb_palette[*sp];
-                w_rgb[8] = rgb_palette[*(sp + nextline)];
+                w_idx[2] = *(sp + prevline);
+                w_rgb[2] = rgb_palette[w_idx[2]];
+                w_idx[5] = *sp;
+                w_rgb[5] = rgb_palette[w_idx[5]];
+                w_idx[8] = *(sp + nextline);
+                w_rgb[8] = rgb_palette[w_idx[8]];
                 w_rgb[1] = w_rgb[2];
+                w_idx[1] = w_idx[2];
                 w_rgb[4] = w_rgb[5];
+                w_idx[4] = w_idx[5];
                 w_rgb[7] = w_rgb[8];
-                w_rgb[3] = rgb_palette[*(sp + prevline + 1)];
-                w_rgb[6] = rgb_palette[*(sp + 1)];
-                w_rgb[9] = rgb_palette[*(sp + nextline + 1)];
-                w_yuv[2] = rgb_to_yuv(w_rgb[2]);
-                w_yuv[5] = rgb_to_yuv(w_rgb[5]);
-                w_yuv[8] = rgb_to_yuv(w_rgb[8]);
-                w_yuv[1] = w_yuv[2];
-                w_yuv[4] = w_yuv[5];
-                w_yuv[7] = w_yuv[8];
-                w_yuv[3] = rgb_to_yuv(w_rgb[3]);
-                w_yuv[6] = rgb_to_yuv(w_rgb[6]);
-                w_yuv[9] = rgb_to_yuv(w_rgb[9]);
+                w_idx[7] = w_idx[8];
+                w_idx[3] = *(sp + prevline + 1);
+                w_rgb[3] = rgb_palette[w_idx[3]];
+                w_idx[6] = *(sp + 1);
+                w_rgb[6] = rgb_palette[w_idx[6]];
+                w_idx[9] = *(sp + nextline + 1);
+                w_rgb[9] = rgb_palette[w_idx[9]];
             }
             else if(i<Xres-1)
             {
                 w_rgb[1] = w_rgb[2];
+                w_idx[1] = w_idx[2];
                 w_rgb[4] = w_rgb[5];
+                w_idx[4] = w_idx[5];
                 w_rgb[7] = w_rgb[8];
+                w_idx[7] = w_idx[8];
                 w_rgb[2] = w_rgb[3];
+                w_idx[2] = w_idx[3];
                 w_rgb[5] = w_rgb[6];
+                w_idx[5] = w_idx[6];
                 w_rgb[8] = w_rgb[9];
-                w_rgb[3] = rgb_palette[*(sp + prevline + 1)];
-                w_rgb[6] = rgb_palette[*(sp + 1)];
-                w_rgb[9] = rgb_palette[*(sp + nextline + 1)];
-                w_yuv[1] = w_yuv[2];
-                w_yuv[4] = w_yuv[5];
-                w_yuv[7] = w_yuv[8];
-                w_yuv[2] = w_yuv[3];
-                w_yuv[5] = w_yuv[6];
-                w_yuv[8] = w_yuv[9];
-                w_yuv[3] = rgb_to_yuv(w_rgb[3]);
-                w_yuv[6] = rgb_to_yuv(w_rgb[6]);
-                w_yuv[9] = rgb_to_yuv(w_rgb[9]);
+                w_idx[8] = w_idx[9];
+                w_idx[3] = *(sp + prevline + 1);
+                w_rgb[3] = rgb_palette[w_idx[3]];
+                w_idx[6] = *(sp + 1);
+                w_rgb[6] = rgb_palette[w_idx[6]];
+                w_idx[9] = *(sp + nextline + 1);
+                w_rgb[9] = rgb_palette[w_idx[9]];
             }
             else
             {
                 w_rgb[1] = w_rgb[2];
+                w_idx[1] = w_idx[2];
                 w_rgb[4] = w_rgb[5];
+                w_idx[4] = w_idx[5];
                 w_rgb[7] = w_rgb[8];
+                w_idx[7] = w_idx[8];
                 w_rgb[2] = w_rgb[3];
+                w_idx[2] = w_idx[3];
                 w_rgb[5] = w_rgb[6];
+                w_idx[5] = w_idx[6];
                 w_rgb[8] = w_rgb[9];
-                w_yuv[1] = w_yuv[2];
-                w_yuv[4] = w_yuv[5];
-                w_yuv[7] = w_yuv[8];
-                w_yuv[2] = w_yuv[3];
-                w_yuv[5] = w_yuv[6];
-                w_yuv[8] = w_yuv[9];
+                w_idx[8] = w_idx[9];
             }
 
             for (k=1; k<=9; k++)
@@ -171,7 +176,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
 
                 if ( w_rgb[k] != w_rgb[5] )
                 {
-                    if (yuv_diff(w_yuv[5], w_yuv[k]))
+                    if (hqx_palette_diff(w_idx[5], w_idx[k]))
                         pattern |= flag;
                 }
                 flag <<= 1;
@@ -403,7 +408,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 50:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_1M
@@ -431,7 +436,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -453,7 +458,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_2
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_1M
@@ -471,7 +476,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 10:
                 case 138:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                             PIXEL01_C
@@ -581,7 +586,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 54:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -609,7 +614,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -631,7 +636,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_2
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -649,7 +654,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 11:
                 case 139:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -672,7 +677,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 19:
                 case 51:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL00_1L
                             PIXEL01_C
@@ -696,7 +701,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 146:
                 case 178:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_1M
@@ -720,7 +725,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 84:
                 case 85:
                     {
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL02_1U
                             PIXEL12_C
@@ -744,7 +749,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 112:
                 case 113:
                     {
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL20_1L
@@ -768,7 +773,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 200:
                 case 204:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_1M
@@ -792,7 +797,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 73:
                 case 77:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL00_1U
                             PIXEL10_C
@@ -816,7 +821,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 42:
                 case 170:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                             PIXEL01_C
@@ -840,7 +845,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 14:
                 case 142:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                             PIXEL01_C
@@ -968,7 +973,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 26:
                 case 31:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -979,7 +984,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_3
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -999,7 +1004,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 214:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1013,7 +1018,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11
                         PIXEL12_C
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -1032,7 +1037,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL01_1
                         PIXEL02_1M
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1043,7 +1048,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_4
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -1058,7 +1063,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 74:
                 case 107:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1072,7 +1077,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -1087,7 +1092,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 27:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1110,7 +1115,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 86:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1137,7 +1142,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1158,7 +1163,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1176,7 +1181,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 30:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1203,7 +1208,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1224,7 +1229,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1241,7 +1246,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 75:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1419,7 +1424,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 58:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1428,7 +1433,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1448,7 +1453,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1461,7 +1466,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL12_C
                         PIXEL20_1M
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1479,7 +1484,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1488,7 +1493,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1500,7 +1505,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 202:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1513,7 +1518,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1527,7 +1532,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 78:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1540,7 +1545,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1554,7 +1559,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 154:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1563,7 +1568,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1583,7 +1588,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_1M
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1596,7 +1601,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1614,7 +1619,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1623,7 +1628,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1635,7 +1640,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 90:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1644,7 +1649,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1655,7 +1660,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1664,7 +1669,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1677,7 +1682,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 55:
                 case 23:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL00_1L
                             PIXEL01_C
@@ -1701,7 +1706,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 182:
                 case 150:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1725,7 +1730,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 213:
                 case 212:
                     {
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL02_1U
                             PIXEL12_C
@@ -1749,7 +1754,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 241:
                 case 240:
                     {
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL20_1L
@@ -1773,7 +1778,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 236:
                 case 232:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1797,7 +1802,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 109:
                 case 105:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL00_1U
                             PIXEL10_C
@@ -1821,7 +1826,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 171:
                 case 43:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1845,7 +1850,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 143:
                 case 15:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1873,7 +1878,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1U
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1890,7 +1895,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 203:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1913,7 +1918,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 62:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1940,7 +1945,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1957,7 +1962,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 118:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1984,7 +1989,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2005,7 +2010,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1R
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2022,7 +2027,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 155:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2153,7 +2158,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1U
                         PIXEL10_C
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2161,7 +2166,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL20_2
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2177,7 +2182,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 158:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2185,7 +2190,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_2
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2206,7 +2211,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 234:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2218,7 +2223,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2237,7 +2242,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_1M
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2248,7 +2253,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1L
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2264,7 +2269,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 59:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2276,7 +2281,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_3
                             PIXEL10_3
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2298,7 +2303,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2310,7 +2315,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_4
                             PIXEL21_3
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2323,7 +2328,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 87:
                     {
                         PIXEL00_1L
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2339,7 +2344,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11
                         PIXEL20_1M
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2351,7 +2356,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 79:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2366,7 +2371,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1R
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2380,7 +2385,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 122:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2389,7 +2394,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2399,7 +2404,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2411,7 +2416,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_4
                             PIXEL21_3
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2423,7 +2428,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 94:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2431,7 +2436,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL00_2
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2445,7 +2450,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL10_C
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2454,7 +2459,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2466,7 +2471,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 218:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2475,7 +2480,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2485,7 +2490,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL10_C
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2493,7 +2498,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         {
                             PIXEL20_2
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2509,7 +2514,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 91:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2521,7 +2526,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_3
                             PIXEL10_3
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2531,7 +2536,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2540,7 +2545,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2604,7 +2609,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 186:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2613,7 +2618,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2633,7 +2638,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2646,7 +2651,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2664,7 +2669,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2673,7 +2678,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2685,7 +2690,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 206:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2698,7 +2703,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2719,7 +2724,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2734,7 +2739,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 174:
                 case 46:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2757,7 +2762,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2784,7 +2789,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2823,7 +2828,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 126:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2836,7 +2841,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL12_3
                         }
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2853,7 +2858,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 219:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2868,7 +2873,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1M
                         PIXEL11
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2884,7 +2889,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 125:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL00_1U
                             PIXEL10_C
@@ -2907,7 +2912,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 221:
                     {
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL02_1U
                             PIXEL12_C
@@ -2930,7 +2935,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 207:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2953,7 +2958,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 238:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2976,7 +2981,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 190:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2999,7 +3004,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 187:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3022,7 +3027,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 243:
                     {
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL20_1L
@@ -3045,7 +3050,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 119:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL00_1L
                             PIXEL01_C
@@ -3075,7 +3080,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                         }
@@ -3090,7 +3095,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 175:
                 case 47:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                         }
@@ -3113,7 +3118,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                         }
@@ -3140,7 +3145,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_C
                         }
@@ -3156,7 +3161,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL01_C
                         PIXEL02_1M
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3167,7 +3172,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_4
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -3181,7 +3186,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 123:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3195,7 +3200,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -3210,7 +3215,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 95:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -3221,7 +3226,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_3
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -3240,7 +3245,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 222:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3254,7 +3259,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11
                         PIXEL12_C
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -3273,7 +3278,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1U
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3284,7 +3289,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_4
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_C
                         }
@@ -3301,7 +3306,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL02_1M
                         PIXEL10_C
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                         }
@@ -3310,7 +3315,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -3324,7 +3329,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 235:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3338,7 +3343,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                         }
@@ -3352,7 +3357,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 111:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                         }
@@ -3365,7 +3370,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -3380,7 +3385,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 63:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                         }
@@ -3389,7 +3394,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -3408,7 +3413,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 159:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -3419,7 +3424,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_3
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                         }
@@ -3438,7 +3443,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                         }
@@ -3450,7 +3455,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11
                         PIXEL12_C
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -3465,7 +3470,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 246:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3480,7 +3485,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_C
                         }
@@ -3493,7 +3498,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 254:
                     {
                         PIXEL00_1M
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3504,7 +3509,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL02_4
                         }
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3514,7 +3519,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_3
                             PIXEL20_4
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -3536,7 +3541,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                         }
@@ -3545,7 +3550,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_C
                         }
@@ -3557,7 +3562,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 251:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3569,7 +3574,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL02_1M
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3581,7 +3586,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                             PIXEL21_3
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -3595,7 +3600,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 239:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                         }
@@ -3608,7 +3613,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                         }
@@ -3622,7 +3627,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 127:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3634,7 +3639,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_3
                             PIXEL10_3
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -3645,7 +3650,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL12_3
                         }
                         PIXEL11
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -3660,7 +3665,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 191:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                         }
@@ -3669,7 +3674,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                         }
@@ -3687,7 +3692,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 223:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -3697,7 +3702,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_4
                             PIXEL10_3
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3711,7 +3716,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL11
                         PIXEL20_1M
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -3727,7 +3732,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                         }
@@ -3740,7 +3745,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_C
                         }
@@ -3752,7 +3757,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 255:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_C
                         }
@@ -3761,7 +3766,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_C
                         }
@@ -3772,7 +3777,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_C
                         }
@@ -3781,7 +3786,7 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_C
                         }
@@ -3803,6 +3808,11 @@ HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
     }
 }
 
+HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, const uint32_t * rgb_palette )
+{
+    hq3x_8to32_rb_part(sp, srb, dp, drb, Xres, Yres, 0, Yres, rgb_palette);
+}
+
 HQX_API void HQX_CALLCONV hq3x_8to32( const uint8_t * sp, uint32_t * dp, int Xres, int Yres, const uint32_t * rgb_palette )
 {
     uint32_t rowBytesL = Xres * 4;
@@ -164,14 +164,16 @@
 #define PIXEL33_81    *(dp+dpL+dpL+dpL+3) = Interp8(w_rgb[5], w_rgb[6]);
 #define PIXEL33_82    *(dp+dpL+dpL+dpL+3) = Interp8(w_rgb[5], w_rgb[8]);
 
-HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, const uint32_t * rgb_palette )
+/* Scale only the source lines top up to (excluding) bottom. The lines next
+ * to them are still read as context, so sp and dp point to the whole image. */
+HQX_API void HQX_CALLCONV hq4x_8to32_rb_part( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, int top, int bottom, const uint32_t * rgb_palette )
 {
     int  i, j, k;
     int  prevline, nextline;
     uint32_t w_rgb[10];
-    uint32_t w_yuv[10];
+    uint8_t  w_idx[10];
     int dpL = (drb >> 2);
-    uint8_t *dRowP = (uint8_t *) dp;
+    uint8_t *dRowP = (uint8_t *) dp + drb * 4 * top;
 
     /*   +----+----+----+
          |    |    |    |
@@ -184,7 +186,10 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
          | w7 | w8 | w9 |
          +----+----+----+ */
 
-    for (j=0; j<Yres; j++)
+    sp += srb * top;
+    dp = (uint32_t *) dRowP;
+
+    for (j=top; j<bottom; j++)
     {
         if (j>0)      prevline = 0 - (int)srb; else prevline = 0;
         if (j<Yres-1) nextline = (int)srb;     else nextline = 0;
@@ -200,60 +205,60 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
 
             if (i==0)
             {
-                w_rgb[2] = rgb_palette[*(sp + prevline)];
-                w_rgb[5] = rgb_palette[*sp];
-                w_rgb[8] = rgb_palette[*(sp + nextline)];
+                w_idx[2] = *(sp + prevline);
+                w_rgb[2] = rgb_palette[w_idx[2]];
+                w_idx[5] = *sp;
+                w_rgb[5] = rgb_palette[w_idx[5]];
+                w_idx[8] = *(sp + nextline);
+                w_rgb[8] = rgb_palette[w_idx[8]];
                 w_rgb[1] = w_rgb[2];
+                w_idx[1] = w_idx[2];
                 w_rgb[4] = w_rgb[5];
+                w_idx[4] = w_idx[5];
                 w_rgb[7] = w_rgb[8];
-                w_rgb[3] = rgb_palette[*(sp + prevline + 1)];
-                w_rgb[6] = rgb_palette[*(sp + 1)];
-                w_rgb[9] = rgb_palette[*(sp + nextline + 1)];
-                w_yuv[2] = rgb_to_yuv(w_rgb[2]);
-                w_yuv[5] = rgb_to_yuv(w_rgb[5]);
-                w_yuv[8] = rgb_to_yuv(w_rgb[8]);
-                w_yuv[1] = w_yuv[2];
-                w_yuv[4] = w_yuv[5];
-                w_yuv[7] = w_yuv[8];
-                w_yuv[3] = rgb_to_yuv(w_rgb[3]);
-                w_yuv[6] = rgb_to_yuv(w_rgb[6]);
-                w_yuv[9] = rgb_to_yuv(w_rgb[9]);
+                w_idx[7] = w_idx[8];
+                w_idx[3] = *(sp + prevline + 1);
+                w_rgb[3] = rgb_palette[w_idx[3]];
+                w_idx[6] = *(sp + 1);
+                w_rgb[6] = rgb_palette[w_idx[6]];
+                w_idx[9] = *(sp + nextline + 1);
+                w_rgb[9] = rgb_palette[w_idx[9]];
             }
             else if(i<Xres-1)
             {
                 w_rgb[1] = w_rgb[2];
+                w_idx[1] = w_idx[2];
                 w_rgb[4] = w_rgb[5];
+                w_idx[4] = w_idx[5];
                 w_rgb[7] = w_rgb[8];
+                w_idx[7] = w_idx[8];
                 w_rgb[2] = w_rgb[3];
+                w_idx[2] = w_idx[3];
                 w_rgb[5] = w_rgb[6];
+                w_idx[5] = w_idx[6];
                 w_rgb[8] = w_rgb[9];
-                w_rgb[3] = rgb_palette[*(sp + prevline + 1)];
-                w_rgb[6] = rgb_palette[*(sp + 1)];
-                w_rgb[9] = rgb_palette[*(sp + nextline + 1)];
-                w_yuv[1] = w_yuv[2];
-                w_yuv[4] = w_yuv[5];
-                w_yuv[7] = w_yuv[8];
-                w_yuv[2] = w_yuv[3];
-                w_yuv[5] = w_yuv[6];
-                w_yuv[8] = w_yuv[9];
-                w_yuv[3] = rgb_to_yuv(w_rgb[3]);
-                w_yuv[6] = rgb_to_yuv(w_rgb[6]);
-                w_yuv[9] = rgb_to_yuv(w_rgb[9]);
+                w_idx[8] = w_idx[9];
+                w_idx[3] = *(sp + prevline + 1);
+                w_rgb[3] = rgb_palette[w_idx[3]];
+                w_idx[6] = *(sp + 1);
+                w_rgb[6] = rgb_palette[w_idx[6]];
+                w_idx[9] = *(sp + nextline + 1);
+                w_rgb[9] = rgb_palette[w_idx[9]];
             }
             else
             {
                 w_rgb[1] = w_rgb[2];
+                w_idx[1] = w_idx[2];
                 w_rgb[4] = w_rgb[5];
+                w_idx[4] = w_idx[5];
                 w_rgb[7] = w_rgb[8];
+                w_idx[7] = w_idx[8];
                 w_rgb[2] = w_rgb[3];
+                w_idx[2] = w_idx[3];
                 w_rgb[5] = w_rgb[6];
+                w_idx[5] = w_idx[6];
                 w_rgb[8] = w_rgb[9];
-                w_yuv[1] = w_yuv[2];
-                w_yuv[4] = w_yuv[5];
-                w_yuv[7] = w_yuv[8];
-                w_yuv[2] = w_yuv[3];
-                w_yuv[5] = w_yuv[6];
-                w_yuv[8] = w_yuv[9];
+                w_idx[8] = w_idx[9];
             }
 
             for (k=1; k<=9; k++)
@@ -262,7 +267,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
 
                 if ( w_rgb[k] != w_rgb[5] )
                 {
-                    if (yuv_diff(w_yuv[5], w_yuv[k]))
+                    if (hqx_palette_diff(w_idx[5], w_idx[k]))
                         pattern |= flag;
                 }
                 flag <<= 1;
@@ -586,7 +591,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -625,7 +630,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL13_10
                         PIXEL20_61
                         PIXEL21_30
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -654,7 +659,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_70
                         PIXEL13_60
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -677,7 +682,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 10:
                 case 138:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -838,7 +843,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -877,7 +882,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -904,7 +909,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_70
                         PIXEL13_60
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -926,7 +931,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 11:
                 case 139:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -956,7 +961,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 19:
                 case 51:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL00_81
                             PIXEL01_31
@@ -991,7 +996,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -1025,7 +1030,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_20
                         PIXEL01_60
                         PIXEL02_81
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL03_81
                             PIXEL13_31
@@ -1065,7 +1070,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL13_10
                         PIXEL20_82
                         PIXEL21_32
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -1096,7 +1101,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_70
                         PIXEL13_60
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -1121,7 +1126,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 73:
                 case 77:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL00_82
                             PIXEL10_32
@@ -1154,7 +1159,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 42:
                 case 170:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -1187,7 +1192,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 14:
                 case 142:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -1380,7 +1385,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 26:
                 case 31:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -1392,7 +1397,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_50
                             PIXEL10_50
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -1421,7 +1426,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -1439,7 +1444,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -1466,7 +1471,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_30
                         PIXEL13_10
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -1480,7 +1485,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL21_0
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -1497,7 +1502,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 74:
                 case 107:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -1514,7 +1519,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_0
                         PIXEL12_30
                         PIXEL13_61
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -1535,7 +1540,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 27:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -1566,7 +1571,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -1604,7 +1609,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -1630,7 +1635,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_30
                         PIXEL13_61
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -1653,7 +1658,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -1691,7 +1696,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -1717,7 +1722,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_30
                         PIXEL13_10
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -1738,7 +1743,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 75:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -2007,7 +2012,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 58:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -2021,7 +2026,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2049,7 +2054,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_81
                         PIXEL01_31
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2067,7 +2072,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_31
                         PIXEL20_61
                         PIXEL21_30
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2095,7 +2100,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_31
                         PIXEL13_31
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2109,7 +2114,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2127,7 +2132,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 202:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -2145,7 +2150,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL03_80
                         PIXEL12_30
                         PIXEL13_61
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2167,7 +2172,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 78:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -2185,7 +2190,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL03_82
                         PIXEL12_32
                         PIXEL13_82
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2207,7 +2212,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 154:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -2221,7 +2226,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2249,7 +2254,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2267,7 +2272,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL20_82
                         PIXEL21_32
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2295,7 +2300,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_32
                         PIXEL12_30
                         PIXEL13_10
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2309,7 +2314,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2327,7 +2332,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 90:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -2341,7 +2346,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2355,7 +2360,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL12_0
                             PIXEL13_12
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2369,7 +2374,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2388,7 +2393,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 55:
                 case 23:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL00_81
                             PIXEL01_31
@@ -2423,7 +2428,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -2457,7 +2462,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_20
                         PIXEL01_60
                         PIXEL02_81
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL03_81
                             PIXEL13_31
@@ -2497,7 +2502,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL13_10
                         PIXEL20_82
                         PIXEL21_32
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_0
                             PIXEL23_0
@@ -2528,7 +2533,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_70
                         PIXEL13_60
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL21_0
@@ -2553,7 +2558,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 109:
                 case 105:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL00_82
                             PIXEL10_32
@@ -2586,7 +2591,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 171:
                 case 43:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -2619,7 +2624,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 143:
                 case 15:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -2659,7 +2664,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_31
                         PIXEL13_31
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -2680,7 +2685,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 203:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -2711,7 +2716,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -2749,7 +2754,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -2769,7 +2774,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -2807,7 +2812,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -2833,7 +2838,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_32
                         PIXEL13_82
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -2854,7 +2859,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 155:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -3051,7 +3056,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_31
                         PIXEL13_31
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3066,7 +3071,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL31_11
                         }
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -3082,7 +3087,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 158:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3096,7 +3101,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -3121,7 +3126,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 234:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3139,7 +3144,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL03_80
                         PIXEL12_30
                         PIXEL13_61
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -3162,7 +3167,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3181,7 +3186,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_82
                         PIXEL21_32
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -3199,7 +3204,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 59:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -3211,7 +3216,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_50
                             PIXEL10_50
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3246,7 +3251,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_32
                         PIXEL12_30
                         PIXEL13_10
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -3259,7 +3264,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL31_50
                         }
                         PIXEL21_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3279,7 +3284,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_81
                         PIXEL01_31
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -3296,7 +3301,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL12_0
                         PIXEL20_61
                         PIXEL21_30
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3316,7 +3321,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 79:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -3333,7 +3338,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_0
                         PIXEL12_32
                         PIXEL13_82
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3355,7 +3360,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 122:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3369,7 +3374,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3383,7 +3388,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL12_0
                             PIXEL13_12
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -3396,7 +3401,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL31_50
                         }
                         PIXEL21_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3414,7 +3419,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 94:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3428,7 +3433,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -3441,7 +3446,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL13_50
                         }
                         PIXEL12_0
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3455,7 +3460,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3473,7 +3478,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 218:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3487,7 +3492,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3501,7 +3506,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL12_0
                             PIXEL13_12
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3516,7 +3521,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL31_11
                         }
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -3532,7 +3537,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 91:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -3544,7 +3549,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_50
                             PIXEL10_50
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3559,7 +3564,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL13_12
                         }
                         PIXEL11_0
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3573,7 +3578,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3671,7 +3676,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 186:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3685,7 +3690,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3713,7 +3718,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_81
                         PIXEL01_31
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3731,7 +3736,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_31
                         PIXEL20_82
                         PIXEL21_32
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3759,7 +3764,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_32
                         PIXEL12_31
                         PIXEL13_31
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3773,7 +3778,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3791,7 +3796,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 206:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3809,7 +3814,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL03_82
                         PIXEL12_32
                         PIXEL13_82
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3840,7 +3845,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_32
                         PIXEL12_70
                         PIXEL13_60
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3863,7 +3868,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 174:
                 case 46:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3896,7 +3901,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_81
                         PIXEL01_31
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3935,7 +3940,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL13_31
                         PIXEL20_82
                         PIXEL21_32
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3997,7 +4002,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4012,7 +4017,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_10
                         PIXEL11_30
                         PIXEL12_0
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4033,7 +4038,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 219:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4053,7 +4058,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4071,7 +4076,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 125:
                     {
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL00_82
                             PIXEL10_32
@@ -4106,7 +4111,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_82
                         PIXEL01_82
                         PIXEL02_81
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL03_81
                             PIXEL13_31
@@ -4135,7 +4140,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 207:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4175,7 +4180,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_32
                         PIXEL13_82
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL21_0
@@ -4201,7 +4206,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4231,7 +4236,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 187:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4273,7 +4278,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL13_10
                         PIXEL20_82
                         PIXEL21_32
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL22_0
                             PIXEL23_0
@@ -4295,7 +4300,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 119:
                     {
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL00_81
                             PIXEL01_31
@@ -4340,7 +4345,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL21_0
                         PIXEL22_31
                         PIXEL23_81
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL30_0
                         }
@@ -4356,7 +4361,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                 case 175:
                 case 47:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -4387,7 +4392,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_81
                         PIXEL01_31
                         PIXEL02_0
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL03_0
                         }
@@ -4427,7 +4432,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL30_82
                         PIXEL31_32
                         PIXEL32_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL33_0
                         }
@@ -4447,7 +4452,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_30
                         PIXEL13_10
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4461,7 +4466,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL21_0
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4477,7 +4482,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 123:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4494,7 +4499,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_0
                         PIXEL12_30
                         PIXEL13_10
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4515,7 +4520,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 95:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4527,7 +4532,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL01_50
                             PIXEL10_50
                         }
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4555,7 +4560,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4573,7 +4578,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4599,7 +4604,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_30
                         PIXEL12_31
                         PIXEL13_31
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4615,7 +4620,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL22_0
                         PIXEL23_0
                         PIXEL32_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL33_0
                         }
@@ -4638,7 +4643,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_0
                         PIXEL21_0
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4650,7 +4655,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL32_50
                             PIXEL33_50
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL30_0
                         }
@@ -4663,7 +4668,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 235:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4684,7 +4689,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL21_0
                         PIXEL22_31
                         PIXEL23_81
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL30_0
                         }
@@ -4699,7 +4704,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 111:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -4714,7 +4719,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL11_0
                         PIXEL12_32
                         PIXEL13_82
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4735,7 +4740,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 63:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -4744,7 +4749,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_20
                         }
                         PIXEL01_0
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4771,7 +4776,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 159:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4784,7 +4789,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_50
                         }
                         PIXEL02_0
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL03_0
                         }
@@ -4810,7 +4815,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_81
                         PIXEL01_31
                         PIXEL02_0
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL03_0
                         }
@@ -4825,7 +4830,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4845,7 +4850,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4867,7 +4872,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL30_82
                         PIXEL31_32
                         PIXEL32_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL33_0
                         }
@@ -4881,7 +4886,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4896,7 +4901,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_10
                         PIXEL11_30
                         PIXEL12_0
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4912,7 +4917,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL22_0
                         PIXEL23_0
                         PIXEL32_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL33_0
                         }
@@ -4936,7 +4941,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL21_0
                         PIXEL22_0
                         PIXEL23_0
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL30_0
                         }
@@ -4946,7 +4951,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL31_0
                         PIXEL32_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL33_0
                         }
@@ -4958,7 +4963,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 251:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4978,7 +4983,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_0
                         PIXEL21_0
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4990,7 +4995,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL32_50
                             PIXEL33_50
                         }
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL30_0
                         }
@@ -5003,7 +5008,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 239:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -5022,7 +5027,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL21_0
                         PIXEL22_31
                         PIXEL23_81
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL30_0
                         }
@@ -5037,7 +5042,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 127:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -5046,7 +5051,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL00_20
                         }
                         PIXEL01_0
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -5061,7 +5066,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL10_0
                         PIXEL11_0
                         PIXEL12_0
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -5082,7 +5087,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 191:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -5092,7 +5097,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL01_0
                         PIXEL02_0
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL03_0
                         }
@@ -5116,7 +5121,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 223:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -5129,7 +5134,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                             PIXEL10_50
                         }
                         PIXEL02_0
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL03_0
                         }
@@ -5143,7 +5148,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -5164,7 +5169,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL00_81
                         PIXEL01_31
                         PIXEL02_0
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL03_0
                         }
@@ -5183,7 +5188,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL30_82
                         PIXEL31_32
                         PIXEL32_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL33_0
                         }
@@ -5195,7 +5200,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                     }
                 case 255:
                     {
-                        if (yuv_diff(w_yuv[4], w_yuv[2]))
+                        if (hqx_palette_diff(w_idx[4], w_idx[2]))
                         {
                             PIXEL00_0
                         }
@@ -5205,7 +5210,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL01_0
                         PIXEL02_0
-                        if (yuv_diff(w_yuv[2], w_yuv[6]))
+                        if (hqx_palette_diff(w_idx[2], w_idx[6]))
                         {
                             PIXEL03_0
                         }
@@ -5221,7 +5226,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         PIXEL21_0
                         PIXEL22_0
                         PIXEL23_0
-                        if (yuv_diff(w_yuv[8], w_yuv[4]))
+                        if (hqx_palette_diff(w_idx[8], w_idx[4]))
                         {
                             PIXEL30_0
                         }
@@ -5231,7 +5236,7 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
                         }
                         PIXEL31_0
                         PIXEL32_0
-                        if (yuv_diff(w_yuv[6], w_yuv[8]))
+                        if (hqx_palette_diff(w_idx[6], w_idx[8]))
                         {
                             PIXEL33_0
                         }
@@ -5253,6 +5258,11 @@ HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint3
     }
 }
 
+HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, const uint32_t * rgb_palette )
+{
+    hq4x_8to32_rb_part(sp, srb, dp, drb, Xres, Yres, 0, Yres, rgb_palette);
+}
+
 HQX_API void HQX_CALLCONV hq4x_8to32( const uint8_t * sp, uint32_t * dp, int Xres, int Yres, const uint32_t * rgb_palette )
 {
     uint32_t rowBytesL = Xres * 4;
@@ -25,6 +25,10 @@
  * (VGA colors) */
 #define HQX_VGACOLORS
 
+/* only the 8bpp kernels are used; they need no RGB to YUV lookup table, only
+ * the colour difference bitmap built by hqxSetPalette8() */
+#define HQX_PALETTED
+
 #if defined( __GNUC__ )
     #ifdef __MINGW32__
         #define HQX_CALLCONV __stdcall
@@ -58,6 +62,7 @@ typedef uint8 uint8_t;
 
 HQX_API void HQX_CALLCONV hqxInit(void);
 HQX_API void HQX_CALLCONV hqxUnInit(void);
+HQX_API void HQX_CALLCONV hqxSetPalette8(const uint32_t * rgb_palette, int from, int length);
 HQX_API void HQX_CALLCONV hq2x_32( uint32_t * src, uint32_t * dest, int width, int height );
 HQX_API void HQX_CALLCONV hq3x_32( uint32_t * src, uint32_t * dest, int width, int height );
 HQX_API void HQX_CALLCONV hq4x_32( uint32_t * src, uint32_t * dest, int width, int height );
@@ -67,11 +72,14 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * src, uint32_t src_rowBytes, uin
 HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height );
 
 HQX_API void HQX_CALLCONV hq2x_8to32_rb( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, const uint32_t * rgb_palette );
+HQX_API void HQX_CALLCONV hq2x_8to32_rb_part( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, int top, int bottom, const uint32_t * rgb_palette );
 HQX_API void HQX_CALLCONV hq2x_8to32( const uint8_t * sp, uint32_t * dp, int Xres, int Yres, const uint32_t * rgb_palette );
 
 HQX_API void HQX_CALLCONV hq3x_8to32_rb( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, const uint32_t * rgb_palette );
+HQX_API void HQX_CALLCONV hq3x_8to32_rb_part( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, int top, int bottom, const uint32_t * rgb_palette );
 HQX_API void HQX_CALLCONV hq3x_8to32( const uint8_t * sp, uint32_t * dp, int Xres, int Yres, const uint32_t * rgb_palette );
 
 HQX_API void HQX_CALLCONV hq4x_8to32_rb( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, const uint32_t * rgb_palette );
+HQX_API void HQX_CALLCONV hq4x_8to32_rb_part( const uint8_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres, int top, int bottom, const uint32_t * rgb_palette );
 HQX_API void HQX_CALLCONV hq4x_8to32( const uint8_t * sp, uint32_t * dp, int Xres, int Yres, const uint32_t * rgb_palette );
 #endif
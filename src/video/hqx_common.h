@@ -56,16 +56,24 @@ typedef uint32 uint32_t;
 /* RGB to YUV lookup table */
 extern uint32_t * RGBtoYUV;
 
-static inline uint32_t rgb_to_yuv(uint32_t c)
+/* Colours differ bitmap of the 8bpp palette (256 * 256 bits) */
+extern uint8_t hqxPaletteDiff[256 * 256 / 8];
+
+static inline uint32_t rgb_to_yuv_index(uint32_t c)
 {
     /* Mask against MASK_RGB to discard the alpha channel */
 #ifndef HQX_VGACOLORS
-    return RGBtoYUV[MASK_RGB & c];
+    return MASK_RGB & c;
 #else
-    return RGBtoYUV[((c & 0x0000FF) >> 2) | ((c & 0x00FF00) >> 4) | ((c & 0xFF0000) >> 6)];
+    return ((c & 0x0000FF) >> 2) | ((c & 0x00FF00) >> 4) | ((c & 0xFF0000) >> 6);
 #endif
 }
 
+static inline uint32_t rgb_to_yuv(uint32_t c)
+{
+    return RGBtoYUV[rgb_to_yuv_index(c)];
+}
+
 /* Test if there is difference in color */
 static inline int yuv_diff(uint32_t yuv1, uint32_t yuv2) {
     return (( abs((int32_t)((yuv1 & Ymask) - (yuv2 & Ymask))) > trY ) ||
@@ -73,6 +81,11 @@ static inline int yuv_diff(uint32_t yuv1, uint32_t yuv2) {
             ( abs((int32_t)((yuv1 & Vmask) - (yuv2 & Vmask))) > trV ) );
 }
 
+/* Test if there is difference in color, for two palette indexes */
+static inline int hqx_palette_diff(uint8_t i1, uint8_t i2) {
+    return hqxPaletteDiff[(i1 << 5) | (i2 >> 3)] & (1 << (i2 & 7));
+}
+
 static inline int Diff(uint32_t c1, uint32_t c2)
 {
     return yuv_diff(rgb_to_yuv(c1), rgb_to_yuv(c2));
@@ -18,41 +18,51 @@
 
 #include <stdlib.h>
 #include <assert.h>
+#include "hqx_common.h"
 #include "hqx.h"
 
 uint32_t * RGBtoYUV = NULL;
+uint8_t hqxPaletteDiff[256 * 256 / 8];
+
+/* YUV of the palette entries, to rebuild hqxPaletteDiff from */
+static uint32_t hqxPaletteYUV[256];
+
+/* YUV of an entry of the RGB to YUV lookup table */
+static uint32_t hqxIndexToYUV(uint32_t c)
+{
+    uint32_t r, g, b, y, u, v;
+#ifndef HQX_VGACOLORS
+    r = (c & 0xFF0000) >> 16;
+    g = (c & 0x00FF00) >> 8;
+    b = c & 0x0000FF;
+#else
+    /* DUNE 2 is using 6bit per component colors (VGA) */
+    r = (((c & 0x0FF000) >> 12) * 0x41) >> 4;
+    g = (((c & 0x000FC0) >> 6) * 0x41) >> 4;
+    b = ((c & 0x00003F) * 0x41) >> 4;
+#endif
+    y = (uint32_t)(0.299*r + 0.587*g + 0.114*b);
+    u = (uint32_t)(-0.169*r - 0.331*g + 0.5*b) + 128;
+    v = (uint32_t)(0.5*r - 0.419*g - 0.081*b) + 128;
+    return (y << 16) + (u << 8) + v;
+}
 
 HQX_API void HQX_CALLCONV hqxInit(void)
 {
+#ifndef HQX_PALETTED
     /* Initalize RGB to YUV lookup table */
-    uint32_t c, r, g, b, y, u, v;
+    uint32_t c;
 #ifndef HQX_VGACOLORS
     RGBtoYUV = malloc(sizeof(uint32_t) * 16777216);
 	assert (RGBtoYUV != NULL);
 
-    for (c = 0; c < 16777216; c++) {
-        r = (c & 0xFF0000) >> 16;
-        g = (c & 0x00FF00) >> 8;
-        b = c & 0x0000FF;
-        y = (uint32_t)(0.299*r + 0.587*g + 0.114*b);
-        u = (uint32_t)(-0.169*r - 0.331*g + 0.5*b) + 128;
-        v = (uint32_t)(0.5*r - 0.419*g - 0.081*b) + 128;
-        RGBtoYUV[c] = (y << 16) + (u << 8) + v;
-    }
+    for (c = 0; c < 16777216; c++) RGBtoYUV[c] = hqxIndexToYUV(c);
 #else
-    /* DUNE 2 is using 6bit per component colors (VGA) */
     RGBtoYUV = malloc(sizeof(uint32_t) * 64*64*64);
 	assert (RGBtoYUV != NULL);
 
-    for (c = 0; c < 64*64*64; c++) {
-        r = (((c & 0x0FF000) >> 12) * 0x41) >> 4;
-        g = (((c & 0x000FC0) >> 6) * 0x41) >> 4;
-        b = ((c & 0x00003F) * 0x41) >> 4;
-        y = (uint32_t)(0.299*r + 0.587*g + 0.114*b);
-        u = (uint32_t)(-0.169*r - 0.331*g + 0.5*b) + 128;
-        v = (uint32_t)(0.5*r - 0.419*g - 0.081*b) + 128;
-        RGBtoYUV[c] = (y << 16) + (u << 8) + v;
-    }
+    for (c = 0; c < 64*64*64; c++) RGBtoYUV[c] = hqxIndexToYUV(c);
+#endif
 #endif
 }
 
@@ -61,3 +71,29 @@ HQX_API void HQX_CALLCONV hqxUnInit(void)
     free(RGBtoYUV);
     RGBtoYUV = NULL;
 }
+
+/* Update the colour difference bitmap for changed palette entries. Only the
+ * rows and columns of the changed entries are recalculated. */
+HQX_API void HQX_CALLCONV hqxSetPalette8(const uint32_t * rgb_palette, int from, int length)
+{
+    int i, j;
+
+    for (i = from; i < from + length; i++) {
+        hqxPaletteYUV[i] = hqxIndexToYUV(rgb_to_yuv_index(rgb_palette[i]));
+    }
+
+    for (i = from; i < from + length; i++) {
+        for (j = 0; j < 256; j++) {
+            int ij = (i << 8) | j;
+            int ji = (j << 8) | i;
+
+            if (yuv_diff(hqxPaletteYUV[i], hqxPaletteYUV[j])) {
+                hqxPaletteDiff[ij >> 3] |= (uint8_t)(1 << (ij & 7));
+                hqxPaletteDiff[ji >> 3] |= (uint8_t)(1 << (ji & 7));
+            } else {
+                hqxPaletteDiff[ij >> 3] &= (uint8_t)~(1 << (ij & 7));
+                hqxPaletteDiff[ji >> 3] &= (uint8_t)~(1 << (ji & 7));
+            }
+        }
+    }
+}
@@ -297,6 +297,10 @@ static void scale4x_buf(const struct stage_scale_funcs * funcs, void* void_dst,
 	mid[4] = mid[3] + mid_slice;
 	mid[5] = mid[4] + mid_slice;
 
+	/* the last two rows are always done together */
+	if (top > height - 2)
+		top = height - 2;
+
 	if (top <= 1) {
 		stage_scale2x_impl(SCMID(-2 + 6), SCMID(-1 + 6), SCSRC(0), SCSRC(0), SCSRC(1), width);
 		stage_scale2x_impl(SCMID(0), SCMID(1), SCSRC(0), SCSRC(1), SCSRC(2), width);
@@ -0,0 +1,147 @@
+/** @file src/video/video_bands.c Scaling of horizontal bands of the screen on worker threads. */
+
+#include <stdlib.h>
+#include "types.h"
+#include "../os/thread.h"
+
+#include "video_bands.h"
+
+#if defined(WITH_THREADS)
+/**
+ * A worker thread, scaling one band per frame.
+ */
+typedef struct VideoBandWorker {
+	Thread thread;                                          /*!< The thread. */
+	Semaphore start;                                        /*!< Unlocked when there is a band to scale. */
+	Semaphore done;                                         /*!< Unlocked when the band is scaled. */
+	int top;                                                /*!< The first source line of the band. */
+	int bottom;                                             /*!< The source line after the band. */
+} VideoBandWorker;
+
+static VideoBandWorker s_workers[VIDEO_BANDS_THREADS_MAX - 1]; /*!< The worker threads. */
+static uint16 s_workerCount = 0;                            /*!< The amount of worker threads running. */
+static VideoBandProc s_proc = NULL;                         /*!< The routine to scale the bands with. */
+static void *s_data = NULL;                                 /*!< The data to pass to s_proc. */
+static bool s_quit = false;                                 /*!< True when the workers should stop. */
+
+/**
+ * The worker thread. It waits for a band, scales it, and tells it is done.
+ *
+ * @param data The VideoBandWorker.
+ * @return Always zero.
+ */
+static ThreadStatus WINAPI Video_Bands_Thread(void *data)
+{
+	VideoBandWorker *worker = (VideoBandWorker *)data;
+
+	while (true) {
+		Semaphore_Lock(worker->start);
+		if (s_quit) break;
+
+		s_proc(s_data, worker->top, worker->bottom);
+
+		Semaphore_Unlock(worker->done);
+	}
+
+	return 0;
+}
+#endif /* WITH_THREADS */
+
+/**
+ * Start the worker threads. With one thread (or without thread support), all
+ *  bands are scaled on the video thread.
+ *
+ * @param threads The amount of threads to scale a frame with, including the video thread.
+ */
+void Video_Bands_Init(uint16 threads)
+{
+#if defined(WITH_THREADS)
+	Video_Bands_Uninit();
+
+	if (threads > VIDEO_BANDS_THREADS_MAX) threads = VIDEO_BANDS_THREADS_MAX;
+
+	s_quit = false;
+	while (s_workerCount + 1 < threads) {
+		VideoBandWorker *worker = &s_workers[s_workerCount];
+
+		worker->start = Semaphore_Create(0);
+		worker->done  = Semaphore_Create(0);
+		worker->thread = NULL;
+		if (worker->start != NULL && worker->done != NULL) worker->thread = Thread_Create(&Video_Bands_Thread, worker);
+
+		if (worker->thread == NULL) {
+			if (worker->start != NULL) Semaphore_Destroy(worker->start);
+			if (worker->done != NULL) Semaphore_Destroy(worker->done);
+			break;
+		}
+
+		s_workerCount++;
+	}
+#else
+	VARIABLE_NOT_USED(threads);
+#endif /* WITH_THREADS */
+}
+
+/**
+ * Stop the worker threads.
+ */
+void Video_Bands_Uninit(void)
+{
+#if defined(WITH_THREADS)
+	uint16 i;
+
+	s_quit = true;
+	for (i = 0; i < s_workerCount; i++) Semaphore_Unlock(s_workers[i].start);
+
+	for (i = 0; i < s_workerCount; i++) {
+		Thread_Wait(s_workers[i].thread, NULL);
+		Semaphore_Destroy(s_workers[i].start);
+		Semaphore_Destroy(s_workers[i].done);
+	}
+
+	s_workerCount = 0;
+#endif /* WITH_THREADS */
+}
+
+/**
+ * Scale source lines, split in bands over the worker threads and the video
+ *  thread. Returns when all bands are scaled.
+ *
+ * @param proc The routine to scale a band with.
+ * @param data The data to pass to proc.
+ * @param top The first source line to scale.
+ * @param bottom The source line after the last one to scale.
+ */
+void Video_Bands_Run(VideoBandProc proc, void *data, int top, int bottom)
+{
+#if defined(WITH_THREADS)
+	int bands;
+	int i;
+
+	bands = (bottom - top) / VIDEO_BANDS_LINES_MIN;
+	if (bands > s_workerCount + 1) bands = s_workerCount + 1;
+
+	if (bands <= 1) {
+		proc(data, top, bottom);
+		return;
+	}
+
+	s_proc = proc;
+	s_data = data;
+
+	/* The video thread scales the first band itself */
+	for (i = 1; i < bands; i++) {
+		VideoBandWorker *worker = &s_workers[i - 1];
+
+		worker->top    = top + (bottom - top) * i / bands;
+		worker->bottom = top + (bottom - top) * (i + 1) / bands;
+		Semaphore_Unlock(worker->start);
+	}
+
+	proc(data, top, top + (bottom - top) / bands);
+
+	for (i = 1; i < bands; i++) Semaphore_Lock(s_workers[i - 1].done);
+#else
+	proc(data, top, bottom);
+#endif /* WITH_THREADS */
+}
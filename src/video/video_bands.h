@@ -0,0 +1,21 @@
+/** @file src/video/video_bands.h Scaling of horizontal bands of the screen on worker threads. */
+
+#ifndef VIDEO_VIDEO_BANDS_H
+#define VIDEO_VIDEO_BANDS_H
+
+enum {
+	VIDEO_BANDS_THREADS_MAX = 16,                           /*!< The maximum amount of threads scaling a frame, including the video thread. */
+	VIDEO_BANDS_LINES_MIN   = 8                             /*!< The minimum amount of source lines in a band. */
+};
+
+/**
+ * Scale the source lines top up to (excluding) bottom. The lines around the
+ *  band can be read, but only the output of the band may be written.
+ */
+typedef void (*VideoBandProc)(void *data, int top, int bottom);
+
+extern void Video_Bands_Init(uint16 threads);
+extern void Video_Bands_Uninit(void);
+extern void Video_Bands_Run(VideoBandProc proc, void *data, int top, int bottom);
+
+#endif /* VIDEO_VIDEO_BANDS_H */
@@ -0,0 +1,60 @@
+/** @file src/video/video_none.c Null video driver, for headless builds. */
+
+#include <stdlib.h>
+#include "types.h"
+#include "video.h"
+#include "../gfx.h"
+
+static uint8 *s_framebuffer = NULL;
+
+bool Video_Init(int screen_magnification, VideoScaleFilter filter)
+{
+	VARIABLE_NOT_USED(screen_magnification);
+	VARIABLE_NOT_USED(filter);
+
+	s_framebuffer = calloc(1, SCREEN_WIDTH * (SCREEN_HEIGHT + 4));
+
+	return s_framebuffer != NULL;
+}
+
+void Video_Uninit(void)
+{
+	free(s_framebuffer);
+	s_framebuffer = NULL;
+}
+
+void Video_Tick(void)
+{
+}
+
+void Video_SetPalette(void *palette, int from, int length)
+{
+	VARIABLE_NOT_USED(palette);
+	VARIABLE_NOT_USED(from);
+	VARIABLE_NOT_USED(length);
+}
+
+void Video_Mouse_SetPosition(uint16 x, uint16 y)
+{
+	VARIABLE_NOT_USED(x);
+	VARIABLE_NOT_USED(y);
+}
+
+void Video_Mouse_SetRegion(uint16 minX, uint16 maxX, uint16 minY, uint16 maxY)
+{
+	VARIABLE_NOT_USED(minX);
+	VARIABLE_NOT_USED(maxX);
+	VARIABLE_NOT_USED(minY);
+	VARIABLE_NOT_USED(maxY);
+}
+
+void Video_SetOffset(uint16 offset)
+{
+	VARIABLE_NOT_USED(offset);
+}
+
+void * Video_GetFrameBuffer(uint16 size)
+{
+	VARIABLE_NOT_USED(size);
+	return s_framebuffer;
+}
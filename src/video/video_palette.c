@@ -0,0 +1,101 @@
+/** @file src/video/video_palette.c Conversion of 8bpp pixels to 32bpp via a palette. */
+
+#include "types.h"
+
+/* The AVX2 kernel needs __builtin_cpu_supports and target("avx2"): GCC 4.9, clang 6
+ *  or Apple clang 10. Clang claims to be GCC 4.2, so it is checked on its own. */
+#if defined(__clang__)
+#  if defined(__apple_build_version__)
+#    define VIDEO_PALETTE_COMPILER_AVX2 (__clang_major__ >= 10)
+#  else
+#    define VIDEO_PALETTE_COMPILER_AVX2 (__clang_major__ >= 6)
+#  endif
+#elif defined(__GNUC__)
+#  define VIDEO_PALETTE_COMPILER_AVX2 (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#else
+#  define VIDEO_PALETTE_COMPILER_AVX2 0
+#endif
+
+#if VIDEO_PALETTE_COMPILER_AVX2 && (defined(__i386__) || defined(__x86_64__))
+/* The AVX2 kernel is compiled for AVX2 on its own, and only used if the CPU has it */
+#define VIDEO_PALETTE_AVX2
+#include <immintrin.h>
+#endif
+
+#include "video_palette.h"
+
+typedef void (*Video_Palette_ExpandProc)(uint32 *dst, const uint8 *src, const uint32 *palette, unsigned int count);
+
+static void Video_Palette_Expand_C(uint32 *dst, const uint8 *src, const uint32 *palette, unsigned int count);
+
+static Video_Palette_ExpandProc s_expand = Video_Palette_Expand_C; /*!< The kernel to use; Video_Palette_Init() picks the best one. */
+
+/**
+ * Convert pixels with a plain loop, four at a time.
+ */
+static void Video_Palette_Expand_C(uint32 *dst, const uint8 *src, const uint32 *palette, unsigned int count)
+{
+	for (; count >= 4; count -= 4) {
+		dst[0] = palette[src[0]];
+		dst[1] = palette[src[1]];
+		dst[2] = palette[src[2]];
+		dst[3] = palette[src[3]];
+		dst += 4;
+		src += 4;
+	}
+
+	while (count-- != 0) *dst++ = palette[*src++];
+}
+
+#if defined(VIDEO_PALETTE_AVX2)
+/**
+ * Convert pixels with AVX2, sixteen at a time: the indexes are widened to
+ *  32 bits and the colours are fetched with a gather.
+ */
+__attribute__((target("avx2")))
+static void Video_Palette_Expand_AVX2(uint32 *dst, const uint8 *src, const uint32 *palette, unsigned int count)
+{
+	for (; count >= 16; count -= 16) {
+		__m128i indexes = _mm_loadu_si128((const __m128i *)src);
+		__m256i low     = _mm256_cvtepu8_epi32(indexes);
+		__m256i high    = _mm256_cvtepu8_epi32(_mm_srli_si128(indexes, 8));
+
+		_mm256_storeu_si256((__m256i *)dst,     _mm256_i32gather_epi32((const int *)palette, low, 4));
+		_mm256_storeu_si256((__m256i *)dst + 1, _mm256_i32gather_epi32((const int *)palette, high, 4));
+		dst += 16;
+		src += 16;
+	}
+
+	while (count-- != 0) *dst++ = palette[*src++];
+}
+#endif /* VIDEO_PALETTE_AVX2 */
+
+/**
+ * Pick the best kernel for this CPU. The video driver calls this from
+ *  Video_Init(), before it starts the threads that scale the screen.
+ */
+void Video_Palette_Init(void)
+{
+	s_expand = Video_Palette_Expand_C;
+
+#if defined(VIDEO_PALETTE_AVX2)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		s_expand = Video_Palette_Expand_AVX2;
+	}
+#endif /* VIDEO_PALETTE_AVX2 */
+}
+
+/**
+ * Convert a row of 8bpp pixels to 32bpp pixels.
+ *
+ * @param dst Where to write the 32bpp pixels.
+ * @param src The 8bpp pixels.
+ * @param palette The 32bpp colour of each of the 256 palette entries.
+ * @param count The amount of pixels.
+ */
+void Video_Palette_Expand(uint32 *dst, const uint8 *src, const uint32 *palette, unsigned int count)
+{
+	s_expand(dst, src, palette, count);
+}
+
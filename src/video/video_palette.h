@@ -0,0 +1,9 @@
+/** @file src/video/video_palette.h Conversion of 8bpp pixels to 32bpp via a palette. */
+
+#ifndef VIDEO_VIDEO_PALETTE_H
+#define VIDEO_VIDEO_PALETTE_H
+
+extern void Video_Palette_Init(void);
+extern void Video_Palette_Expand(uint32 *dst, const uint8 *src, const uint32 *palette, unsigned int count);
+
+#endif /* VIDEO_VIDEO_PALETTE_H */
@@ -29,8 +29,11 @@
 #include "../input/mouse.h"
 #include "../opendune.h"
 #include "../inifile.h"
+#include "../trace.h"
 
+#include "video_bands.h"
 #include "video_fps.h"
+#include "video_palette.h"
 #include "scalebit.h"
 #include "hqx.h"
 
@@ -262,6 +265,10 @@ bool Video_Init(int screen_magnification, VideoScaleFilter filter)
 	if (filter == FILTER_HQX) {
 		hqxInit();
 	}
+	Video_Palette_Init();
+	if (screen_magnification != 1 && filter != FILTER_NEAREST_NEIGHBOR) {
+		Video_Bands_Init((uint16)IniFile_GetInteger("scale_threads", 1));
+	}
 
 	/* Note from https://www.libsdl.org/release/SDL-1.2.15/docs/html/video.html :
 	 * If you use both sound and video in your application, you need to call
@@ -352,6 +359,7 @@ void Video_Uninit(void)
 {
 	if (s_video_initialized) {
 		s_video_initialized = false;
+		Video_Bands_Uninit();
 		if (s_scale_filter == FILTER_HQX) {
 			hqxUnInit();
 		}
@@ -362,9 +370,21 @@ void Video_Uninit(void)
 	}
 }
 
+/**
+ * Scale a band of SCREEN_0 with scale2x.
+ *
+ * @param data The first pixel of SCREEN_0.
+ * @param top The first line of the band.
+ * @param bottom The line after the band.
+ */
+static void Video_DrawScreen_Scale2x_Band(void *data, int top, int bottom)
+{
+	scale_part(s_screen_magnification, s_gfx_surface->pixels, s_screen_magnification * SCREEN_WIDTH, data, SCREEN_WIDTH, 1, SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom);
+}
+
 static void Video_DrawScreen_Scale2x(const struct dirty_area * area)
 {
-	unsigned top, bottom;
+	int top, bottom;
 	uint8 *data = GFX_Screen_Get_ByIndex(SCREEN_0);
 	data += (s_screenOffset << 2);
 	if (area != NULL) {
@@ -374,32 +394,51 @@ static void Video_DrawScreen_Scale2x(const struct dirty_area * area)
 		top = 0;
 		bottom = SCREEN_HEIGHT;
 	}
-	scale_part(s_screen_magnification, s_gfx_surface->pixels, s_screen_magnification * SCREEN_WIDTH, data, SCREEN_WIDTH, 1, SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom);
+	Video_Bands_Run(&Video_DrawScreen_Scale2x_Band, data, top, bottom);
 }
 
-static void Video_DrawScreen_Hqx(void)
+/**
+ * Scale a band of SCREEN_0 with hqx.
+ *
+ * @param data The first pixel of SCREEN_0.
+ * @param top The first line of the band.
+ * @param bottom The line after the band.
+ */
+static void Video_DrawScreen_Hqx_Band(void *data, int top, int bottom)
 {
-	uint8 *p;
-
-	p = GFX_Screen_Get_ByIndex(SCREEN_0);
-	p += (s_screenOffset << 2);
+	const uint8 *p = (const uint8 *)data;
 
 	switch(s_screen_magnification) {
 	case 2:
-		hq2x_8to32_rb(p, SCREEN_WIDTH, s_gfx_surface->pixels, s_gfx_surface->pitch,
-		           SCREEN_WIDTH, SCREEN_HEIGHT, rgb_palette);
+		hq2x_8to32_rb_part(p, SCREEN_WIDTH, s_gfx_surface->pixels, s_gfx_surface->pitch,
+		           SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom, rgb_palette);
 		break;
 	case 3:
-		hq3x_8to32_rb(p, SCREEN_WIDTH, s_gfx_surface->pixels, s_gfx_surface->pitch,
-		           SCREEN_WIDTH, SCREEN_HEIGHT, rgb_palette);
+		hq3x_8to32_rb_part(p, SCREEN_WIDTH, s_gfx_surface->pixels, s_gfx_surface->pitch,
+		           SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom, rgb_palette);
 		break;
 	case 4:
-		hq4x_8to32_rb(p, SCREEN_WIDTH, s_gfx_surface->pixels, s_gfx_surface->pitch,
-		           SCREEN_WIDTH, SCREEN_HEIGHT, rgb_palette);
+		hq4x_8to32_rb_part(p, SCREEN_WIDTH, s_gfx_surface->pixels, s_gfx_surface->pitch,
+		           SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom, rgb_palette);
 		break;
 	}
 }
 
+static void Video_DrawScreen_Hqx(const struct dirty_area * area)
+{
+	uint8 *p;
+	int top, bottom;
+
+	p = GFX_Screen_Get_ByIndex(SCREEN_0);
+	p += (s_screenOffset << 2);
+
+	/* hqx looks at the lines next to a pixel, so those change too */
+	top = (area->top > 0) ? area->top - 1 : 0;
+	bottom = (area->bottom < SCREEN_HEIGHT) ? area->bottom + 1 : SCREEN_HEIGHT;
+
+	Video_Bands_Run(&Video_DrawScreen_Hqx_Band, p, top, bottom);
+}
+
 static void Video_DrawScreen_Nearest_Neighbor(const struct dirty_area * area)
 {
 	uint8 *data = GFX_Screen_Get_ByIndex(SCREEN_0);
@@ -522,45 +561,47 @@ static void Video_DrawScreen_Nearest_Neighbor(const struct dirty_area * area)
 /**
  * Because we rarely want to draw in 320x200, this function copies from the
  *  320x200 buffer to the real screen, scaling where needed.
+ *
+ * @param rects The parts of the screen to copy.
+ * @param count The amount of rectangles in rects.
  */
-static void Video_DrawScreen(const struct dirty_area * area)
+static void Video_DrawScreen(const struct dirty_area *rects, uint16 count)
 {
+	uint16 i;
+
 	SDL_LockSurface(s_gfx_surface);
 	if (s_screen_magnification == 1) {
-		uint8 *data = GFX_Screen_Get_ByIndex(SCREEN_0);
-		if (s_gfx_surface->format->BitsPerPixel == 8) {
-			uint8 *gfx = s_gfx_surface->pixels;
-			if (s_gfx_surface->pitch == SCREEN_WIDTH) {
-				memcpy(gfx, data, SCREEN_WIDTH * SCREEN_HEIGHT);
-			} else {
-				int y;
-				for (y = 0; y < SCREEN_HEIGHT; y++) {
-					memcpy(gfx, data, SCREEN_WIDTH);
+		for (i = 0; i < count; i++) {
+			const struct dirty_area *area = &rects[i];
+			uint8 *data = (uint8 *)GFX_Screen_Get_ByIndex(SCREEN_0) + area->top * SCREEN_WIDTH + area->left;
+			uint8 *gfx = (uint8 *)s_gfx_surface->pixels + area->top * s_gfx_surface->pitch;
+			int y;
+
+			if (s_gfx_surface->format->BitsPerPixel == 8) {
+				gfx += area->left;
+				for (y = area->top; y < area->bottom; y++) {
+					memcpy(gfx, data, area->right - area->left);
 					data += SCREEN_WIDTH;
 					gfx += s_gfx_surface->pitch;
 				}
-			}
-		} else {
-			uint32 *gfx = s_gfx_surface->pixels;
-			int x, y;
-			for (y = 0; y < SCREEN_HEIGHT; y++) {
-				for (x = 0; x < SCREEN_WIDTH; x++) {
-					*gfx = rgb_palette[*data];
-					data++;
-					gfx++;
+			} else {
+				gfx += area->left * 4;
+				for (y = area->top; y < area->bottom; y++) {
+					Video_Palette_Expand((uint32 *)gfx, data, rgb_palette, area->right - area->left);
+					data += SCREEN_WIDTH;
+					gfx += s_gfx_surface->pitch;
 				}
-				gfx += (s_gfx_surface->pitch / 4 - SCREEN_WIDTH);
 			}
 		}
 	} else switch (s_scale_filter) {
 	case FILTER_NEAREST_NEIGHBOR:
-		Video_DrawScreen_Nearest_Neighbor(area);
+		for (i = 0; i < count; i++) Video_DrawScreen_Nearest_Neighbor(&rects[i]);
 		break;
 	case FILTER_SCALE2X:
-		Video_DrawScreen_Scale2x(area);
+		for (i = 0; i < count; i++) Video_DrawScreen_Scale2x(&rects[i]);
 		break;
 	case FILTER_HQX:
-		Video_DrawScreen_Hqx();
+		for (i = 0; i < count; i++) Video_DrawScreen_Hqx(&rects[i]);
 		break;
 	default:
 		Error("Unsupported scale filter\n");
@@ -581,6 +622,8 @@ void Video_Tick(void)
 	if (s_video_lock) return;
 	s_video_lock = true;
 
+	TRACE_BEGIN("Video_Tick");
+
 	if (s_showFPS) {
 		Video_ShowFPS(GFX_Screen_Get_ByIndex(SCREEN_0));
 	}
@@ -627,6 +670,10 @@ void Video_Tick(void)
 					s_showFPS = !s_showFPS;
 					continue;
 				}
+				if (sym == SDLK_F12) {
+					if (!keyup) Trace_Dump();
+					continue;
+				}
 				/* Mac keyboard scancodes are very different from what
 				 * they are on a PC : we need a translation table. */
 #if defined(__APPLE__)
@@ -678,21 +725,49 @@ void Video_Tick(void)
 #endif /* _DEBUG */
 
 	if (GFX_Screen_IsDirty(SCREEN_0) || s_screen_needrepaint) {
-		struct dirty_area * area = GFX_Screen_GetDirtyArea(SCREEN_0);
+		static const struct dirty_area full = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+		const struct dirty_area *rects;
+		SDL_Rect updates[GFX_DIRTY_RECTS_MAX];
+		uint16 count;
+		uint16 i;
+
+		count = GFX_Screen_GetDirtyRects(SCREEN_0, &rects);
+		if (s_screen_needrepaint || count == 0) {
+			rects = &full;
+			count = 1;
+		}
 
 		/* Do not call Video_DrawScreen() if the game is allowed to draw directly into the SDL Surface */
-		if (s_framebuffer != NULL) Video_DrawScreen(area);
+		if (s_framebuffer != NULL) {
+			TRACE_BEGIN("Video_DrawScreen");
+			Video_DrawScreen(rects, count);
+			TRACE_END("Video_DrawScreen");
+		}
+
+		for (i = 0; i < count; i++) {
+			struct dirty_area area = rects[i];
 
-		if (!s_screen_needrepaint && area && (area->left > 0 || area->top > 0 || area->right < SCREEN_WIDTH || area->bottom < SCREEN_HEIGHT)) {
-			SDL_UpdateRect(s_gfx_surface, area->left * s_screen_magnification, area->top * s_screen_magnification,
-			                              (area->right - area->left) * s_screen_magnification, (area->bottom - area->top) * s_screen_magnification);
-		} else {
-			SDL_UpdateRect(s_gfx_surface, 0, 0, 0, 0);
+			/* hqx also changes the pixels around the dirty ones */
+			if (s_screen_magnification != 1 && s_scale_filter == FILTER_HQX) {
+				if (area.left > 0) area.left--;
+				if (area.top > 0) area.top--;
+				if (area.right < SCREEN_WIDTH) area.right++;
+				if (area.bottom < SCREEN_HEIGHT) area.bottom++;
+			}
+
+			updates[i].x = area.left * s_screen_magnification;
+			updates[i].y = area.top * s_screen_magnification;
+			updates[i].w = (area.right - area.left) * s_screen_magnification;
+			updates[i].h = (area.bottom - area.top) * s_screen_magnification;
 		}
+		SDL_UpdateRects(s_gfx_surface, count, updates);
 
 		GFX_Screen_SetClean(SCREEN_0);
 		s_screen_needrepaint = false;
 	}
+
+	TRACE_END("Video_Tick");
+
 	s_video_lock = false;
 }
 
@@ -716,6 +791,7 @@ void Video_SetPalette(void *palette, int from, int length)
 			value |= (((*p++) & 0x3F) * 0x410) & 0x00ff00;
 			rgb_palette[i] = value | ((((*p++) & 0x3F) * 0x41)>> 4);
 		}
+		if (s_scale_filter == FILTER_HQX) hqxSetPalette8(rgb_palette, from, length);
 		s_screen_needrepaint = true;
 	} else {
 		SDL_Color paletteRGB[256];
@@ -6,6 +6,7 @@
 #endif /* WITHOUT_SDLIMAGE */
 #include "types.h"
 #include "../os/error.h"
+#include "../os/math.h"
 
 #include "video.h"
 
@@ -15,8 +16,11 @@
 #include "../input/mouse.h"
 #include "../opendune.h"
 #include "../inifile.h"
+#include "../trace.h"
 
+#include "video_bands.h"
 #include "video_fps.h"
+#include "video_palette.h"
 #include "scalebit.h"
 #include "hqx.h"
 
@@ -278,6 +282,10 @@ bool Video_Init(int screen_magnification, VideoScaleFilter filter)
 	if (filter == FILTER_HQX) {
 		hqxInit();
 	}
+	Video_Palette_Init();
+	if (screen_magnification != 1 && filter != FILTER_NEAREST_NEIGHBOR) {
+		Video_Bands_Init((uint16)IniFile_GetInteger("scale_threads", 1));
+	}
 
 	err = SDL_Init(SDL_INIT_VIDEO);
 
@@ -366,6 +374,7 @@ void Video_Uninit(void)
 {
 	s_video_initialized = false;
 
+	Video_Bands_Uninit();
 	if (s_scale_filter == FILTER_HQX) {
 		hqxUnInit();
 	}
@@ -391,156 +400,218 @@ void Video_Uninit(void)
 	SDL_Quit();
 }
 
+static uint32 s_truecolorbuffer[SCREEN_WIDTH * SCREEN_HEIGHT] __attribute__((aligned(16))); /*!< The 32bpp version of SCREEN_0, as last converted. */
+
+/**
+ * Get the parts of SCREEN_0 that have to be drawn. This is the whole screen
+ *  when a repaint is needed.
+ *
+ * @param rects Where to store a pointer to the rectangles.
+ * @return The amount of rectangles.
+ */
+static uint16 Video_GetDrawRects(const struct dirty_area **rects)
+{
+	static const struct dirty_area full = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+	uint16 count;
+
+	count = GFX_Screen_GetDirtyRects(SCREEN_0, rects);
+	if (s_screen_needrepaint || count == 0) {
+		*rects = &full;
+		return 1;
+	}
+
+	return count;
+}
+
+/**
+ * Convert a part of SCREEN_0 to 32bpp in s_truecolorbuffer.
+ *
+ * @param area The part to convert.
+ */
+static void Video_ConvertRect(const struct dirty_area *area)
+{
+	const uint8 *data = (const uint8 *)GFX_Screen_Get_ByIndex(SCREEN_0) + (s_screenOffset << 2);
+	int y;
+
+	for (y = area->top; y < area->bottom; y++) {
+		Video_Palette_Expand(s_truecolorbuffer + SCREEN_WIDTH * y + area->left, data + SCREEN_WIDTH * y + area->left, s_palette, area->right - area->left);
+	}
+}
+
 /**
  * This function copies the 320x200 buffer to the real screen.
  * Scaling is done automatically.
+ * Only the dirty rectangles are converted and uploaded to the texture.
  */
 static void Video_DrawScreen_Nearest_Neighbor(void)
 {
-	const uint8 *gfx_screen8 = GFX_Screen_Get_ByIndex(SCREEN_0);
-	struct dirty_area * area = GFX_Screen_GetDirtyArea(SCREEN_0);
-	uint8 * pixels;
-	int pitch;
-	int x, y;
-	uint32 * p;
-	SDL_Rect rect;
-	SDL_Rect * prect = NULL;
+	const struct dirty_area *rects;
+	uint16 count;
+	uint16 i;
+
+	count = Video_GetDrawRects(&rects);
+
+	for (i = 0; i < count; i++) {
+		const struct dirty_area *area = &rects[i];
+		SDL_Rect rect;
 
-	gfx_screen8 += (s_screenOffset << 2);
-	if (SDL_LockTexture(s_texture, NULL, (void **)&pixels, &pitch) != 0) {
-		Error("Could not set lock texture: %s\n", SDL_GetError());
-		return;
-	}
-	if (!s_screen_needrepaint && area && (area->left > 0 || area->top > 0 || area->right < SCREEN_WIDTH || area->bottom < SCREEN_HEIGHT)) {
 		rect.x = area->left;
 		rect.y = area->top;
 		rect.w = area->right - area->left;
 		rect.h = area->bottom - area->top;
-		prect = &rect;
-		pixels += pitch * area->top;
-		gfx_screen8 += SCREEN_WIDTH * area->top + area->left;
-		for (y = area->top; y < area->bottom; y++) {
-			p = (uint32 *)pixels;
-			p += area->left;
-			for (x = area->left; x < area->right; x++) {
-				*p++ = s_palette[*gfx_screen8++];
-			}
-			gfx_screen8 += (SCREEN_WIDTH - rect.w);
-			pixels += pitch;
+
+		Video_ConvertRect(area);
+		if (SDL_UpdateTexture(s_texture, &rect, s_truecolorbuffer + SCREEN_WIDTH * area->top + area->left, SCREEN_WIDTH * 4) != 0) {
+			Error("Could not update texture: %s\n", SDL_GetError());
+			return;
 		}
 		Debug("Dirty area : (%d,%d)-(%d,%d)\n", area->left, area->top, area->right, area->bottom);
-	} else {
-		for (y = 0; y < SCREEN_HEIGHT; y++) {
-			p = (uint32 *)pixels;
-			for (x = 0; x < SCREEN_WIDTH; x++) {
-				*p++ = s_palette[*gfx_screen8++];
-			}
-			pixels += pitch;
-		}
 	}
-	SDL_UnlockTexture(s_texture);
-	if (SDL_RenderCopy(s_renderer, s_texture, prect, prect)) {
+
+	/* The back buffer is undefined after presenting, so copy the whole texture */
+	if (SDL_RenderCopy(s_renderer, s_texture, NULL, NULL)) {
 		Error("SDL_RenderCopy failed : %s\n", SDL_GetError());
 	}
 }
 
+/**
+ * Where a band of the scaled screen is written to.
+ */
+typedef struct VideoScaleJob {
+	uint8 *pixels;                                          /*!< The first pixel of the (locked) texture. */
+	int pitch;                                              /*!< The bytes per line of the texture. */
+} VideoScaleJob;
+
+/**
+ * Scale a band of s_truecolorbuffer with scale2x.
+ *
+ * @param data The VideoScaleJob.
+ * @param top The first line of the band.
+ * @param bottom The line after the band.
+ */
+static void Video_DrawScreen_Scale2x_Band(void *data, int top, int bottom)
+{
+	const VideoScaleJob *job = (const VideoScaleJob *)data;
+
+	scale_part(s_screen_magnification, job->pixels, job->pitch,
+	           s_truecolorbuffer, SCREEN_WIDTH * 4, 4,
+	           SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom);
+}
+
 static void Video_DrawScreen_Scale2x(void)
 {
-	uint8 *data = GFX_Screen_Get_ByIndex(SCREEN_0);
-	struct dirty_area * area = GFX_Screen_GetDirtyArea(SCREEN_0);
-	unsigned top, bottom;
-	uint8 * pixels;
-	int pitch;
-	uint32 * p;
-	static uint32 truecolorbuffer[SCREEN_WIDTH * SCREEN_HEIGHT] __attribute__((aligned(16)));
-	SDL_Rect rect, rectlock;
-	SDL_Rect * prect = NULL;
-	SDL_Rect * prectlock = NULL;
-
-	data += (s_screenOffset << 2);
-
-	/* first do 8bit => 32bit pixel conversion */
-	if (!s_screen_needrepaint && area && (area->left > 0 || area->top > 0 || area->right < SCREEN_WIDTH || area->bottom < SCREEN_HEIGHT)) {
-		int x, y;
-		rect.x = area->left * s_screen_magnification;
-		rect.y = area->top * s_screen_magnification;
-		rect.w = (area->right - area->left) * s_screen_magnification;
-		rect.h = (area->bottom - area->top) * s_screen_magnification;
-		prect = &rect;
+	VideoScaleJob job;
+	const struct dirty_area *rects;
+	uint16 count;
+	uint16 i;
+
+	count = Video_GetDrawRects(&rects);
+
+	/* first do 8bit => 32bit pixel conversion, so scale2x sees all neighbours */
+	for (i = 0; i < count; i++) Video_ConvertRect(&rects[i]);
+
+	/* then call scale2x, for the lines of each rectangle */
+	for (i = 0; i < count; i++) {
+		const struct dirty_area *area = &rects[i];
+		SDL_Rect rectlock;
+		uint8 * pixels;
+		int pitch;
+		int top, bottom;
+
+		/* scale4x always does the first two and the last two lines
+		 *  together; the whole locked part has to be written */
+		top = (area->top <= 1) ? 0 : min(area->top, SCREEN_HEIGHT - 2);
+		bottom = (area->bottom >= SCREEN_HEIGHT - 1) ? SCREEN_HEIGHT : area->bottom;
+
 		rectlock.x = 0;
-		rectlock.y = rect.y;
+		rectlock.y = top * s_screen_magnification;
 		rectlock.w = SCREEN_WIDTH * s_screen_magnification;
-		rectlock.h = rect.h;
-		prectlock = &rectlock;
-		top = area->top;
-		bottom = area->bottom;
-		p = truecolorbuffer + SCREEN_WIDTH * area->top + area->left;
-		data += SCREEN_WIDTH * area->top + area->left;
-		for (y = area->top; y < area->bottom; y++) {
-			for (x = area->left; x < area->right; x++) {
-				*p++ = s_palette[*data++];
-			}
-			data += (SCREEN_WIDTH - area->right + area->left);
-			p += (SCREEN_WIDTH - area->right + area->left);
+		rectlock.h = (bottom - top) * s_screen_magnification;
+
+		if (SDL_LockTexture(s_texture, &rectlock, (void **)&pixels, &pitch) != 0) {
+			Error("Could not set lock texture: %s\n", SDL_GetError());
+			return;
 		}
+		job.pixels = pixels - rectlock.y * pitch;
+		job.pitch = pitch;
+		Video_Bands_Run(&Video_DrawScreen_Scale2x_Band, &job, top, bottom);
+		SDL_UnlockTexture(s_texture);
 		Debug("Dirty area : (%d,%d)-(%d,%d)\n", area->left, area->top, area->right, area->bottom);
-	} else {
-		int i;
-		p = truecolorbuffer;
-		for (i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
-			*p++ = s_palette[*data++];
-		}
-		top = 0;
-		bottom = SCREEN_HEIGHT;
-	}
-	/* then call scale2x */
-	if (SDL_LockTexture(s_texture, prectlock, (void **)&pixels, &pitch) != 0) {
-		Error("Could not set lock texture: %s\n", SDL_GetError());
-		return;
 	}
-	if (prectlock != NULL) {
-		pixels -= rectlock.y * pitch;
-	}
-	scale_part(s_screen_magnification, pixels, pitch,
-	           truecolorbuffer, SCREEN_WIDTH * 4, 4,
-	           SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom);
-	SDL_UnlockTexture(s_texture);
-	if (SDL_RenderCopy(s_renderer, s_texture, prect, prect)) {
+
+	if (SDL_RenderCopy(s_renderer, s_texture, NULL, NULL)) {
 		Error("SDL_RenderCopy failed : %s\n", SDL_GetError());
 	}
 }
 
-static void Video_DrawScreen_Hqx(void)
+/**
+ * Scale a band of SCREEN_0 with hqx.
+ *
+ * @param data The VideoScaleJob.
+ * @param top The first line of the band.
+ * @param bottom The line after the band.
+ */
+static void Video_DrawScreen_Hqx_Band(void *data, int top, int bottom)
 {
-	uint8 *src;
-	uint32 *pixels;
-	int pitch;
+	const VideoScaleJob *job = (const VideoScaleJob *)data;
+	const uint8 *src;
 
 	src = GFX_Screen_Get_ByIndex(SCREEN_0);
 	src += (s_screenOffset << 2);
 
-	if (SDL_LockTexture(s_texture, NULL, (void **)&pixels, &pitch) != 0) {
-		Error("Could not set lock texture: %s\n", SDL_GetError());
-		return;
-	}
 	switch(s_screen_magnification) {
 	case 2:
-		hq2x_8to32_rb(src, SCREEN_WIDTH,
-		              pixels, pitch,
-		              SCREEN_WIDTH, SCREEN_HEIGHT, s_palette);
+		hq2x_8to32_rb_part(src, SCREEN_WIDTH,
+		                   (uint32 *)job->pixels, job->pitch,
+		                   SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom, s_palette);
 		break;
 	case 3:
-		hq3x_8to32_rb(src, SCREEN_WIDTH,
-		              pixels, pitch,
-		              SCREEN_WIDTH, SCREEN_HEIGHT, s_palette);
+		hq3x_8to32_rb_part(src, SCREEN_WIDTH,
+		                   (uint32 *)job->pixels, job->pitch,
+		                   SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom, s_palette);
 		break;
 	case 4:
-		hq4x_8to32_rb(src, SCREEN_WIDTH,
-		              pixels, pitch,
-		              SCREEN_WIDTH, SCREEN_HEIGHT, s_palette);
+		hq4x_8to32_rb_part(src, SCREEN_WIDTH,
+		                   (uint32 *)job->pixels, job->pitch,
+		                   SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom, s_palette);
 		break;
 	}
-	SDL_UnlockTexture(s_texture);
+}
+
+static void Video_DrawScreen_Hqx(void)
+{
+	const struct dirty_area *rects;
+	VideoScaleJob job;
+	uint16 count;
+	uint16 i;
+
+	count = Video_GetDrawRects(&rects);
+
+	for (i = 0; i < count; i++) {
+		SDL_Rect rectlock;
+		uint8 *pixels;
+		int pitch;
+		int top, bottom;
+
+		/* hqx looks at the lines next to a pixel, so those change too */
+		top = (rects[i].top > 0) ? rects[i].top - 1 : 0;
+		bottom = (rects[i].bottom < SCREEN_HEIGHT) ? rects[i].bottom + 1 : SCREEN_HEIGHT;
+
+		rectlock.x = 0;
+		rectlock.y = top * s_screen_magnification;
+		rectlock.w = SCREEN_WIDTH * s_screen_magnification;
+		rectlock.h = (bottom - top) * s_screen_magnification;
+
+		if (SDL_LockTexture(s_texture, &rectlock, (void **)&pixels, &pitch) != 0) {
+			Error("Could not set lock texture: %s\n", SDL_GetError());
+			return;
+		}
+		job.pixels = pixels - rectlock.y * pitch;
+		job.pitch = pitch;
+		Video_Bands_Run(&Video_DrawScreen_Hqx_Band, &job, top, bottom);
+		SDL_UnlockTexture(s_texture);
+	}
+
 	if (SDL_RenderCopy(s_renderer, s_texture, NULL, NULL)) {
 		Error("SDL_RenderCopy failed : %s\n", SDL_GetError());
 	}
@@ -584,6 +655,8 @@ void Video_Tick(void)
 
 	s_video_lock = true;
 
+	TRACE_BEGIN("Video_Tick");
+
 	if (s_showFPS) {
 		Video_ShowFPS(GFX_Screen_Get_ByIndex(SCREEN_0));
 	}
@@ -631,6 +704,10 @@ void Video_Tick(void)
 					if (keyup) s_showFPS = !s_showFPS;
 					continue;
 				}
+				if (sym == SDLK_F12) {
+					if (!keyup) Trace_Dump();
+					continue;
+				}
 				if (sym == SDLK_RSHIFT) {
 					code = 0x36;
 				} else if (sym == SDLK_LSHIFT) {
@@ -677,9 +754,13 @@ void Video_Tick(void)
 	}
 
 	if (draw) {
+		TRACE_BEGIN("Video_DrawScreen");
 		Video_DrawScreen();
+		TRACE_END("Video_DrawScreen");
 	}
 
+	TRACE_END("Video_Tick");
+
 	s_video_lock = false;
 }
 
@@ -703,6 +784,7 @@ void Video_SetPalette(void *palette, int from, int length)
 		             |  (((p[2] & 0x3F) * 0x41) >> 4); /* b */
 		p += 3;
 	}
+	if (s_scale_filter == FILTER_HQX) hqxSetPalette8(s_palette, from, length);
 
 	s_screen_needrepaint = true;
 	s_video_lock = false;
@@ -11,6 +11,7 @@
 
 #include "video.h"
 #include "video_fps.h"
+#include "video_palette.h"
 
 #include "../gfx.h"
 #include "../opendune.h"
@@ -330,26 +331,38 @@ static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM l
 				switch(s_screen_magnification) {
 				case 1:
 					{
-						int x, y;
-						PUCHAR src;
-						PULONG dst;
+						int y;
 						for (y = rect.top; y < rect.bottom; y++) {
-							src = (PUCHAR)s_screen + (y * SCREEN_WIDTH);
-							dst = (PULONG)s_screen2 + (y * SCREEN_WIDTH);
-							for (x = rect.left; x < rect.right; x++) {
-								*dst++ = rgb_palette[*src++];
-							}
+							Video_Palette_Expand((uint32 *)s_screen2 + y * SCREEN_WIDTH + rect.left,
+							                     (const uint8 *)s_screen + y * SCREEN_WIDTH + rect.left,
+							                     rgb_palette, rect.right - rect.left);
 						}
 					}
 					break;
-				case 2:
-					hq2x_8to32(s_screen, s_screen2, SCREEN_WIDTH, SCREEN_HEIGHT, rgb_palette);
-					break;
-				case 3:
-					hq3x_8to32(s_screen, s_screen2, SCREEN_WIDTH, SCREEN_HEIGHT, rgb_palette);
-					break;
-				case 4:
-					hq4x_8to32(s_screen, s_screen2, SCREEN_WIDTH, SCREEN_HEIGHT, rgb_palette);
+				default:
+					{
+						/* hqx looks at the lines next to a pixel, so those change too */
+						int top = rect.top / s_screen_magnification;
+						int bottom = (rect.bottom + s_screen_magnification - 1) / s_screen_magnification;
+						if (top > 0) top--;
+						if (bottom < SCREEN_HEIGHT) bottom++;
+						if (bottom > SCREEN_HEIGHT) bottom = SCREEN_HEIGHT;
+
+						switch(s_screen_magnification) {
+						case 2:
+							hq2x_8to32_rb_part(s_screen, SCREEN_WIDTH, s_screen2, SCREEN_WIDTH * 4 * 2,
+							                   SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom, rgb_palette);
+							break;
+						case 3:
+							hq3x_8to32_rb_part(s_screen, SCREEN_WIDTH, s_screen2, SCREEN_WIDTH * 4 * 3,
+							                   SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom, rgb_palette);
+							break;
+						case 4:
+							hq4x_8to32_rb_part(s_screen, SCREEN_WIDTH, s_screen2, SCREEN_WIDTH * 4 * 4,
+							                   SCREEN_WIDTH, SCREEN_HEIGHT, top, bottom, rgb_palette);
+							break;
+						}
+					}
 					break;
 				}
 			}
@@ -617,6 +630,7 @@ bool Video_Init(int screen_magnification, VideoScaleFilter filter)
 	if (filter == FILTER_HQX) {
 		hqxInit();
 	}
+	Video_Palette_Init();
 
 	hInstance = GetModuleHandle(NULL);
 
@@ -857,6 +871,7 @@ void Video_SetPalette(void *palette, int from, int length)
 			value |= (((*p++) & 0x3F) * 0x410) & 0x00ff00;
 			rgb_palette[i] = value | ((((*p++) & 0x3F) * 0x41)>> 4);
 		}
+		hqxSetPalette8(rgb_palette, from, length);
 	} else {
 		RGBQUAD rgb[256];
 		HDC dc;